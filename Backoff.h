@@ -0,0 +1,51 @@
+#ifndef BACKOFF_H
+#define BACKOFF_H
+
+#include <thread>
+
+/* Backoff:
+ *      Waiting strategy for the blocking operations of the lock-free queues
+ *      spins with an exponentially growing amount of pause instructions,
+ *      then gives the core away with std::this_thread::yield() on every further call
+ */
+class Backoff {
+public:
+    Backoff() :
+        m_step(0)
+    { }
+
+    /**
+     * @brief Waits a little, longer on every call
+     *
+     */
+    void pause()
+    {
+        if(m_step < SPIN_STEPS){
+            for(unsigned i = 0; i < (1u << m_step); i++){
+                relax();
+            }
+            m_step++;
+        }
+        else{ //waited long enough for a spin to be likely to pay off
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    //amount of spinning rounds before falling back to yield, the last round spins 2^(SPIN_STEPS - 1) times
+    static constexpr unsigned SPIN_STEPS = 7;
+
+    //hints the core that this is a spin loop
+    static void relax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    unsigned m_step; //amount of spinning rounds done so far
+};
+
+#endif
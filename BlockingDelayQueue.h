@@ -0,0 +1,255 @@
+#ifndef BLOCKING_DELAY_QUEUE_H
+#define BLOCKING_DELAY_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include "DelayQueue.h"
+
+/* BlockingDelayQueue:
+ *      DelayQueue shared between threads whose consumers sleep until an element is due
+ *      every operation takes m_mutex, a consumer with nothing due waits on m_changed until
+ *      DelayQueue::nextWakeup, or without a timeout while the queue is empty
+ *      a push that moves the earliest wakeup forward wakes every waiting consumer, each of them sleeps until
+ *      a wakeup that is now too late and any of them may be about to leave on its own timeout,
+ *      a push that doesn't only adds an element due after every consumer wakes up anyway, so it wakes nobody
+ *      close() wakes everybody: consumers take what is already due and then get an empty optional,
+ *      elements that aren't due yet stay in the queue
+ *
+ *  copying and moving are disabled, the queue is meant to be shared by address
+ */
+template <class T, class Clock = std::chrono::steady_clock, class Alloc = std::allocator<T>>
+class BlockingDelayQueue {
+public:
+    typedef typename DelayQueue<T, Clock, Alloc>::TimePoint TimePoint;
+    typedef typename DelayQueue<T, Clock, Alloc>::Duration Duration;
+
+private:
+    mutable std::mutex m_mutex; //protects every member below
+    std::condition_variable m_changed; //consumers wait on it for a push or for close()
+    DelayQueue<T, Clock, Alloc> m_queue; //stored elements
+    std::size_t m_waiting; //consumers waiting on m_changed
+    bool m_closed; //true once close() was called
+
+    //pops a due element or waits for one until deadline, m_mutex is held through lock
+    std::optional<T> popUntil(std::unique_lock<std::mutex>& lock, const std::optional<TimePoint>& deadline);
+
+    //links an element under m_mutex and wakes the consumers if it is due before their wakeup
+    template<typename... Args>
+    void push(const TimePoint& readyAt, Args&&... args);
+
+public:
+
+    /**
+     * @brief Construct a new empty BlockingDelayQueue
+     *
+     * @param resolution - length of a tick of the timing wheel, ready times are rounded up to it
+     * @param alloc - allocator of the nodes
+     */
+    explicit BlockingDelayQueue(Duration resolution = std::chrono::milliseconds(1), const Alloc& alloc = Alloc());
+
+    BlockingDelayQueue(const BlockingDelayQueue&) = delete;
+    BlockingDelayQueue& operator=(const BlockingDelayQueue&) = delete;
+
+    /**
+     * @brief Inserts an element that becomes due at readyAt, wakes the waiting consumers if it is due first
+     *
+     * @param val - value to be inserted
+     * @param readyAt - time from which the element may be popped
+     */
+    void pushBack(const T& val, const TimePoint& readyAt);
+
+    /**
+     * @brief Moves an element into the queue that becomes due at readyAt, wakes the waiting consumers if it is due first
+     *
+     * @param val - value to be moved into the queue
+     * @param readyAt - time from which the element may be popped
+     */
+    void pushBack(T&& val, const TimePoint& readyAt);
+
+    /**
+     * @brief Inserts an element that becomes due after delay, wakes the waiting consumers if it is due first
+     *
+     * @param val - value to be inserted
+     * @param delay - time from now on after which the element may be popped
+     */
+    template<typename Rep, typename Period>
+    void pushAfter(const T& val, const std::chrono::duration<Rep, Period>& delay);
+
+    /**
+     * @brief Pops the first due element, waits until one is due
+     *
+     * @return - the element, or an empty optional once the queue is closed and nothing is due
+     */
+    std::optional<T> waitPop();
+
+    /**
+     * @brief Pops the first due element, waits until one is due but no longer than timeout
+     *
+     * @param timeout - maximal time to wait
+     * @return - the element, or an empty optional on timeout or once the queue is closed and nothing is due
+     */
+    template<typename Rep, typename Period>
+    std::optional<T> waitPopFor(const std::chrono::duration<Rep, Period>& timeout);
+
+    /**
+     * @brief Pops the first due element without waiting
+     *
+     * @return - the element, or an empty optional if nothing is due
+     */
+    std::optional<T> tryPop();
+
+    /**
+     * @brief Closes the queue: pushes throw ClosedQueue and waiting consumers wake up
+     *      elements already due can still be popped
+     *
+     */
+    void close();
+
+    /**
+     * @brief Checks if close() was called
+     *
+     * @return true if the queue is closed
+     */
+    bool closed() const;
+
+    /**
+     * @brief Returns the size of the queue, the result may be stale by the time it is used
+     *
+     * @return - amount of elements, due or not
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Exception Class to deal with pushing into a closed BlockingDelayQueue
+     *
+     *  Invalid operators on a closed BlockingDelayQueue:
+     *      pushBack, pushAfter
+     */
+    class ClosedQueue {};
+};
+
+template<typename T, typename Clock, typename Alloc>
+BlockingDelayQueue<T, Clock, Alloc>::BlockingDelayQueue(Duration resolution, const Alloc& alloc) :
+    m_queue(resolution, Clock::now(), alloc),
+    m_waiting(0),
+    m_closed(false)
+{ }
+
+template<typename T, typename Clock, typename Alloc>
+template<typename... Args>
+void BlockingDelayQueue<T, Clock, Alloc>::push(const TimePoint& readyAt, Args&&... args)
+{
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_closed){ //operation is invalid on a closed queue
+            throw ClosedQueue();
+        }
+        std::optional<TimePoint> before = m_queue.nextWakeup();
+        m_queue.emplaceBack(readyAt, std::forward<Args>(args)...);
+        wake = m_waiting > 0 && (!before || *m_queue.nextWakeup() < *before);
+    }
+    if(wake){ //notify_one could pick a consumer whose timeout is expiring and leave the rest asleep
+        m_changed.notify_all();
+    }
+}
+
+template<typename T, typename Clock, typename Alloc>
+void BlockingDelayQueue<T, Clock, Alloc>::pushBack(const T& val, const TimePoint& readyAt)
+{
+    this->push(readyAt, val);
+}
+
+template<typename T, typename Clock, typename Alloc>
+void BlockingDelayQueue<T, Clock, Alloc>::pushBack(T&& val, const TimePoint& readyAt)
+{
+    this->push(readyAt, std::move(val));
+}
+
+template<typename T, typename Clock, typename Alloc>
+template<typename Rep, typename Period>
+void BlockingDelayQueue<T, Clock, Alloc>::pushAfter(const T& val, const std::chrono::duration<Rep, Period>& delay)
+{
+    this->push(Clock::now() + std::chrono::duration_cast<Duration>(delay), val);
+}
+
+template<typename T, typename Clock, typename Alloc>
+std::optional<T> BlockingDelayQueue<T, Clock, Alloc>::popUntil(std::unique_lock<std::mutex>& lock,
+                                                            const std::optional<TimePoint>& deadline)
+{
+    while(true){
+        TimePoint now = Clock::now();
+        std::optional<T> result = m_queue.tryPop(now);
+        if(result || m_closed || (deadline && now >= *deadline)){
+            return result;
+        }
+
+        //sleeping until the next element may be due or the deadline, whichever is first
+        std::optional<TimePoint> wakeup = m_queue.nextWakeup();
+        if(deadline && (!wakeup || *deadline < *wakeup)){
+            wakeup = deadline;
+        }
+        m_waiting++;
+        if(wakeup){
+            m_changed.wait_until(lock, *wakeup);
+        }
+        else{
+            m_changed.wait(lock);
+        }
+        m_waiting--;
+    }
+}
+
+template<typename T, typename Clock, typename Alloc>
+std::optional<T> BlockingDelayQueue<T, Clock, Alloc>::waitPop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return this->popUntil(lock, std::nullopt);
+}
+
+template<typename T, typename Clock, typename Alloc>
+template<typename Rep, typename Period>
+std::optional<T> BlockingDelayQueue<T, Clock, Alloc>::waitPopFor(const std::chrono::duration<Rep, Period>& timeout)
+{
+    TimePoint deadline = Clock::now() + std::chrono::duration_cast<Duration>(timeout);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return this->popUntil(lock, deadline);
+}
+
+template<typename T, typename Clock, typename Alloc>
+std::optional<T> BlockingDelayQueue<T, Clock, Alloc>::tryPop()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.tryPop(Clock::now());
+}
+
+template<typename T, typename Clock, typename Alloc>
+void BlockingDelayQueue<T, Clock, Alloc>::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+    }
+    m_changed.notify_all();
+}
+
+template<typename T, typename Clock, typename Alloc>
+bool BlockingDelayQueue<T, Clock, Alloc>::closed() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_closed;
+}
+
+template<typename T, typename Clock, typename Alloc>
+std::size_t BlockingDelayQueue<T, Clock, Alloc>::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+}
+
+#endif
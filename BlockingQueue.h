@@ -0,0 +1,314 @@
+#ifndef BLOCKING_QUEUE_H
+#define BLOCKING_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include "Queue.h"
+
+/* BlockingQueue:
+ *      Queue shared between threads whose consumers sleep while it is empty instead of spinning
+ *      every operation takes m_mutex, consumers wait on m_notEmpty
+ *      wakeups are batched: m_sleeping counts the consumers that wait and have no wakeup on its way yet,
+ *      a push only notifies while that count is positive, so a burst of pushes wakes
+ *      a sleeping consumer once instead of calling into the kernel on every push
+ *      a bulk pushBack links the whole range with a single append (O(1) unless the allocator gives copies
+ *      a pool of their own, like PoolAllocator) and wakes at most one consumer per element
+ *      close() wakes everybody: consumers drain what is left and then get an empty optional
+ *
+ *  built on a mutex and condition variable since std::atomic::wait (C++20) has no timed wait for waitPopFor
+ *  copying and moving are disabled, the queue is meant to be shared by address
+ */
+template <class T, class Alloc = std::allocator<T>>
+class BlockingQueue {
+private:
+    mutable std::mutex m_mutex; //protects every member below
+    std::condition_variable m_notEmpty; //consumers wait on it for an element or for close()
+    Queue<T, Alloc> m_queue; //stored elements
+    std::size_t m_sleeping; //waiting consumers that no notify was sent to yet
+    bool m_closed; //true once close() was called
+
+    //wakes up to count sleeping consumers, m_mutex is held, returns the amount of notifies to send
+    std::size_t claimWakeups(std::size_t count);
+
+    //sends the notifies claimed by claimWakeups, m_mutex is released
+    void wake(std::size_t count);
+
+    //blocks until an element or close(), m_mutex is held through lock
+    void waitNotEmpty(std::unique_lock<std::mutex>& lock);
+
+public:
+
+    /**
+     * @brief Construct a new empty BlockingQueue
+     *
+     */
+    BlockingQueue();
+
+    /**
+     * @brief Construct a new empty BlockingQueue that allocates through the given allocator
+     *
+     * @param alloc - allocator of the nodes
+     */
+    explicit BlockingQueue(const Alloc& alloc);
+
+    BlockingQueue(const BlockingQueue&) = delete;
+    BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+    /**
+     * @brief Inserts in the back of the queue and wakes a waiting consumer
+     *
+     * @param val - value to be inserted
+     */
+    void pushBack(const T& val);
+
+    /**
+     * @brief Moves a value into the back of the queue and wakes a waiting consumer
+     *
+     * @param val - value to be moved into the queue
+     */
+    void pushBack(T&& val);
+
+    /**
+     * @brief Constructs a new element in place in the back of the queue and wakes a waiting consumer
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     */
+    template<typename... Args>
+    void emplaceBack(Args&&... args);
+
+    /**
+     * @brief Inserts every element of a range in the back of the queue, in order
+     *      the elements are built before the lock is taken, into a batch with an allocator of its own
+     *      (select_on_container_copy_construction, so a PoolAllocator's pool isn't touched outside the lock)
+     *      and linked at once, consumers see either none or all of them
+     *      when the batch's allocator equals the queue's the link is O(1), otherwise the elements are moved in
+     *
+     * @param first - beginning of the range
+     * @param last - end of the range
+     */
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void pushBack(InputIt first, InputIt last);
+
+    /**
+     * @brief Pops the front element, waits while the queue is empty
+     *
+     * @return - the front element, or an empty optional once the queue is closed and empty
+     */
+    std::optional<T> waitPop();
+
+    /**
+     * @brief Pops the front element, waits while the queue is empty but no longer than timeout
+     *
+     * @param timeout - maximal time to wait
+     * @return - the front element, or an empty optional on timeout or once the queue is closed and empty
+     */
+    template<typename Rep, typename Period>
+    std::optional<T> waitPopFor(const std::chrono::duration<Rep, Period>& timeout);
+
+    /**
+     * @brief Pops the front element without waiting
+     *
+     * @return - the front element, or an empty optional if the queue is empty
+     */
+    std::optional<T> tryPop();
+
+    /**
+     * @brief Closes the queue: pushes throw ClosedQueue and waiting consumers wake up
+     *      elements already in the queue can still be popped
+     *
+     */
+    void close();
+
+    /**
+     * @brief Checks if close() was called
+     *
+     * @return true if the queue is closed
+     */
+    bool closed() const;
+
+    /**
+     * @brief Checks if the queue is empty, the result may be stale by the time it is used
+     *
+     * @return true if the queue holds no elements
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns the size of the queue, the result may be stale by the time it is used
+     *
+     * @return - size of the queue
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Exception Class to deal with pushing into a closed BlockingQueue
+     *
+     *  Invalid operators on a closed BlockingQueue:
+     *      pushBack, emplaceBack
+     */
+    class ClosedQueue {};
+};
+
+template<typename T, typename Alloc>
+BlockingQueue<T, Alloc>::BlockingQueue() :
+    BlockingQueue(Alloc())
+{ }
+
+template<typename T, typename Alloc>
+BlockingQueue<T, Alloc>::BlockingQueue(const Alloc& alloc) :
+    m_queue(alloc),
+    m_sleeping(0),
+    m_closed(false)
+{ }
+
+template<typename T, typename Alloc>
+std::size_t BlockingQueue<T, Alloc>::claimWakeups(std::size_t count)
+{
+    if(count > m_sleeping){
+        count = m_sleeping;
+    }
+    m_sleeping -= count;
+    return count;
+}
+
+template<typename T, typename Alloc>
+void BlockingQueue<T, Alloc>::wake(std::size_t count)
+{
+    for(std::size_t i = 0; i < count; i++){ //notifying outside the lock, the woken consumer doesn't block on it
+        m_notEmpty.notify_one();
+    }
+}
+
+template<typename T, typename Alloc>
+void BlockingQueue<T, Alloc>::waitNotEmpty(std::unique_lock<std::mutex>& lock)
+{
+    while(m_queue.empty() && !m_closed){
+        m_sleeping++;
+        m_notEmpty.wait(lock);
+    }
+}
+
+template<typename T, typename Alloc>
+void BlockingQueue<T, Alloc>::pushBack(const T& val)
+{
+    this->emplaceBack(val);
+}
+
+template<typename T, typename Alloc>
+void BlockingQueue<T, Alloc>::pushBack(T&& val)
+{
+    this->emplaceBack(std::move(val));
+}
+
+template<typename T, typename Alloc>
+template<typename... Args>
+void BlockingQueue<T, Alloc>::emplaceBack(Args&&... args)
+{
+    std::size_t wakeups;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_closed){ //operation is invalid on a closed queue
+            throw ClosedQueue();
+        }
+        m_queue.emplaceBack(std::forward<Args>(args)...);
+        wakeups = this->claimWakeups(1);
+    }
+    this->wake(wakeups);
+}
+
+template<typename T, typename Alloc>
+template<typename InputIt, typename>
+void BlockingQueue<T, Alloc>::pushBack(InputIt first, InputIt last)
+{
+    //built without holding the lock, so it must not share state with m_queue's allocator
+    Queue<T, Alloc> batch(std::allocator_traits<Alloc>::select_on_container_copy_construction(m_queue.getAllocator()));
+    batch.pushBack(first, last);
+    if(batch.empty()){
+        return;
+    }
+
+    std::size_t wakeups;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_closed){
+            throw ClosedQueue();
+        }
+        std::size_t count = batch.size();
+        m_queue.append(batch);
+        wakeups = this->claimWakeups(count);
+    }
+    this->wake(wakeups); //at most one consumer per element
+}
+
+template<typename T, typename Alloc>
+std::optional<T> BlockingQueue<T, Alloc>::waitPop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    this->waitNotEmpty(lock);
+    return m_queue.tryPop();
+}
+
+template<typename T, typename Alloc>
+template<typename Rep, typename Period>
+std::optional<T> BlockingQueue<T, Alloc>::waitPopFor(const std::chrono::duration<Rep, Period>& timeout)
+{
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while(m_queue.empty() && !m_closed){
+        m_sleeping++;
+        if(m_notEmpty.wait_until(lock, deadline) == std::cv_status::timeout){
+            //a wakeup claimed for this consumer may still be counted out of m_sleeping,
+            //leaving a stale count only costs a spare notify later, taking it back could lose a wakeup
+            break;
+        }
+    }
+    return m_queue.tryPop();
+}
+
+template<typename T, typename Alloc>
+std::optional<T> BlockingQueue<T, Alloc>::tryPop()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.tryPop();
+}
+
+template<typename T, typename Alloc>
+void BlockingQueue<T, Alloc>::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_sleeping = 0;
+    }
+    m_notEmpty.notify_all();
+}
+
+template<typename T, typename Alloc>
+bool BlockingQueue<T, Alloc>::closed() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_closed;
+}
+
+template<typename T, typename Alloc>
+bool BlockingQueue<T, Alloc>::empty() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.empty();
+}
+
+template<typename T, typename Alloc>
+std::size_t BlockingQueue<T, Alloc>::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+}
+
+#endif
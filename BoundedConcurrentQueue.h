@@ -0,0 +1,326 @@
+#ifndef BOUNDED_CONCURRENT_QUEUE_H
+#define BOUNDED_CONCURRENT_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Backoff.h"
+#include "CacheLine.h"
+
+/* BoundedConcurrentQueue:
+ *      Lock-free bounded queue for any amount of producer and consumer threads (Vyukov)
+ *      elements live in a power of 2 ring of cells allocated once by the c'tor, no operation ever allocates
+ *      every cell carries a sequence number that tells which lap of the ring may use it next:
+ *          sequence == position        the cell is free for the push that reserved position
+ *          sequence == position + 1    the cell holds the element pushed at position
+ *      a push reserves a position with a CAS on m_enqueue and publishes the cell by bumping its sequence,
+ *      a pop does the same with m_dequeue and hands the cell to the push one lap later
+ *      producers and consumers only meet on the cell they both want, never on a shared counter
+ *
+ *  tryPush / tryPop fail fast on a full / empty queue, push / pop back off (see Backoff.h) until they succeed
+ *  T must be nothrow move constructible: a reserved cell has to be filled, so the element is
+ *  built before reserving a cell and only moved into it afterwards
+ *  copying and moving are disabled, the queue is meant to be shared by address
+ */
+template <class T>
+class BoundedConcurrentQueue {
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+                  "BoundedConcurrentQueue requires a nothrow move constructible T");
+
+private:
+
+    //private cell struct of the ring
+    struct Cell {
+        std::atomic<std::size_t> sequence; //lap state of the cell, see above
+        alignas(T) unsigned char storage[sizeof(T)]; //raw storage of the element
+
+        //returns the element stored in the cell
+        T* value() noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    //read-only after construction
+    Cell* m_cells; //ring of m_mask + 1 cells
+    std::size_t m_mask; //capacity - 1
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_enqueue; //next position to push, written by producers
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_dequeue; //next position to pop, written by consumers
+
+    //reserves the cell of the next push and stores its position, nullptr if the queue is full
+    Cell* reservePush(std::size_t& position);
+
+    //rounds capacity up to a power of 2, at least 1
+    static std::size_t roundCapacity(std::size_t capacity);
+
+public:
+
+    /**
+     * @brief Construct a new BoundedConcurrentQueue, allocates all the storage the queue will ever use
+     *
+     * @param capacity - minimal amount of elements the queue can hold, rounded up to a power of 2
+     */
+    explicit BoundedConcurrentQueue(std::size_t capacity);
+
+    /**
+     * @brief Destroys the BoundedConcurrentQueue and every element left in it
+     *      must not run concurrently with any other function
+     *
+     */
+    ~BoundedConcurrentQueue();
+
+    BoundedConcurrentQueue(const BoundedConcurrentQueue&) = delete;
+    BoundedConcurrentQueue& operator=(const BoundedConcurrentQueue&) = delete;
+
+    /**
+     * @brief Inserts in the back of the queue if there is room
+     *
+     * @param val - value to be inserted
+     * @return true if the value was inserted
+     * @return false if the queue is full
+     */
+    bool tryPush(const T& val);
+
+    /**
+     * @brief Moves a value into the back of the queue if there is room
+     *
+     * @param val - value to be moved into the queue, untouched if the queue is full
+     * @return true if the value was inserted
+     * @return false if the queue is full
+     */
+    bool tryPush(T&& val);
+
+    /**
+     * @brief Constructs a new element in the back of the queue if there is room
+     *      the element is built even when the queue turns out to be full, unless its c'tor can't throw
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     * @return true if the element was inserted
+     * @return false if the queue is full
+     */
+    template<typename... Args>
+    bool tryEmplace(Args&&... args);
+
+    /**
+     * @brief Moves the front element into out and pops it
+     *
+     * @param out - receives the front element, untouched if the queue is empty
+     * @return true if an element was popped
+     * @return false if the queue is empty
+     */
+    bool tryPop(T& out);
+
+    /**
+     * @brief Inserts in the back of the queue, waits for room while the queue is full
+     *
+     * @param val - value to be inserted
+     */
+    void push(const T& val);
+
+    /**
+     * @brief Moves a value into the back of the queue, waits for room while the queue is full
+     *
+     * @param val - value to be moved into the queue
+     */
+    void push(T&& val);
+
+    /**
+     * @brief Moves the front element into out and pops it, waits while the queue is empty
+     *
+     * @param out - receives the front element
+     */
+    void pop(T& out);
+
+    /**
+     * @brief Returns the amount of elements in the queue
+     *      reserved positions are counted before their cell is filled or emptied,
+     *      so under concurrent use the result is only an approximation
+     *
+     * @return - approximate amount of elements in the queue
+     */
+    std::size_t approximateSize() const;
+
+    /**
+     * @brief Returns the maximal amount of elements the queue can hold
+     *
+     * @return - capacity of the queue
+     */
+    std::size_t capacity() const;
+};
+
+template<typename T>
+BoundedConcurrentQueue<T>::BoundedConcurrentQueue(std::size_t capacity) :
+    m_cells(new Cell[roundCapacity(capacity)]),
+    m_mask(roundCapacity(capacity) - 1),
+    m_enqueue(0),
+    m_dequeue(0)
+{
+    for(std::size_t i = 0; i <= m_mask; i++){ //every cell starts free for the first lap
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+BoundedConcurrentQueue<T>::~BoundedConcurrentQueue()
+{
+    std::size_t last = m_enqueue.load(std::memory_order_relaxed);
+    for(std::size_t i = m_dequeue.load(std::memory_order_relaxed); i != last; i++){
+        m_cells[i & m_mask].value()->~T();
+    }
+    delete[] m_cells;
+}
+
+template<typename T>
+typename BoundedConcurrentQueue<T>::Cell* BoundedConcurrentQueue<T>::reservePush(std::size_t& position)
+{
+    position = m_enqueue.load(std::memory_order_relaxed);
+    while(true){
+        Cell* cell = m_cells + (position & m_mask);
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t lap = static_cast<std::ptrdiff_t>(sequence - position);
+        if(lap == 0){ //free for this position, racing other producers for it
+            if(m_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)){
+                return cell;
+            }
+        }
+        else if(lap < 0){ //still holds the element of the previous lap
+            return nullptr;
+        }
+        else{ //another producer took position, trying the next one
+            position = m_enqueue.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename T>
+bool BoundedConcurrentQueue<T>::tryPush(const T& val)
+{
+    return this->tryEmplace(val);
+}
+
+template<typename T>
+bool BoundedConcurrentQueue<T>::tryPush(T&& val)
+{
+    return this->tryEmplace(std::move(val));
+}
+
+template<typename T>
+template<typename... Args>
+bool BoundedConcurrentQueue<T>::tryEmplace(Args&&... args)
+{
+    std::size_t position;
+    if constexpr(std::is_nothrow_constructible<T, Args&&...>::value){ //can build straight into the cell
+        Cell* cell = this->reservePush(position);
+        if(cell == nullptr){
+            return false;
+        }
+        ::new (static_cast<void*>(cell->storage)) T(std::forward<Args>(args)...);
+        cell->sequence.store(position + 1, std::memory_order_release); //publishes the constructed element
+        return true;
+    }
+    else{ //a throwing c'tor would leave a reserved cell empty forever, building the element first
+        T temp(std::forward<Args>(args)...);
+        Cell* cell = this->reservePush(position);
+        if(cell == nullptr){
+            return false;
+        }
+        ::new (static_cast<void*>(cell->storage)) T(std::move(temp));
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+}
+
+template<typename T>
+bool BoundedConcurrentQueue<T>::tryPop(T& out)
+{
+    std::size_t position = m_dequeue.load(std::memory_order_relaxed);
+    Cell* cell;
+    while(true){
+        cell = m_cells + (position & m_mask);
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t lap = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+        if(lap == 0){ //filled for this position, racing other consumers for it
+            if(m_dequeue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)){
+                break;
+            }
+        }
+        else if(lap < 0){ //not filled yet
+            return false;
+        }
+        else{ //another consumer took position, trying the next one
+            position = m_dequeue.load(std::memory_order_relaxed);
+        }
+    }
+
+    T* value = cell->value();
+    try{
+        out = std::move(*value);
+    } catch(...){ //the cell is already reserved, the element is destroyed either way
+        value->~T();
+        cell->sequence.store(position + m_mask + 1, std::memory_order_release);
+        throw;
+    }
+    value->~T();
+    cell->sequence.store(position + m_mask + 1, std::memory_order_release); //free for the push one lap later
+    return true;
+}
+
+template<typename T>
+void BoundedConcurrentQueue<T>::push(const T& val)
+{
+    Backoff backoff;
+    while(!this->tryEmplace(val)){
+        backoff.pause();
+    }
+}
+
+template<typename T>
+void BoundedConcurrentQueue<T>::push(T&& val)
+{
+    Backoff backoff;
+    while(!this->tryEmplace(std::move(val))){ //val is only moved from by the attempt that succeeds
+        backoff.pause();
+    }
+}
+
+template<typename T>
+void BoundedConcurrentQueue<T>::pop(T& out)
+{
+    Backoff backoff;
+    while(!this->tryPop(out)){
+        backoff.pause();
+    }
+}
+
+template<typename T>
+std::size_t BoundedConcurrentQueue<T>::approximateSize() const
+{
+    std::size_t dequeue = m_dequeue.load(std::memory_order_relaxed);
+    std::size_t enqueue = m_enqueue.load(std::memory_order_relaxed);
+    std::size_t used = enqueue - dequeue;
+    if(used > static_cast<std::size_t>(-1) / 2){ //consumers moved on between the two loads
+        return 0;
+    }
+    return used > m_mask + 1 ? m_mask + 1 : used;
+}
+
+template<typename T>
+std::size_t BoundedConcurrentQueue<T>::capacity() const
+{
+    return m_mask + 1;
+}
+
+template<typename T>
+std::size_t BoundedConcurrentQueue<T>::roundCapacity(std::size_t capacity)
+{
+    std::size_t rounded = 1;
+    while(rounded < capacity){
+        rounded *= 2;
+    }
+    return rounded;
+}
+
+#endif
@@ -0,0 +1,414 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+#include "RingQueue.h"
+
+/* BoundedQueue:
+ *      Queue with a fixed capacity, set at construction
+ *      the whole buffer is allocated by the c'tor, so no push ever allocates
+ *      and the memory used by the queue has a fixed ceiling
+ *      tryPush reports a full queue through its return value (fail fast),
+ *      pushBack throws FullQueue
+ *
+ *  for a bounded queue shared between threads see SpscQueue and BoundedConcurrentQueue
+ */
+template <class T, class Alloc = std::allocator<T>>
+class BoundedQueue {
+private:
+    typedef std::allocator_traits<Alloc> AllocTraits;
+
+    RingQueue<T, Alloc> m_queue; //storage, reserved up front to m_capacity elements
+    std::size_t m_capacity; //maximal amount of elements
+
+public:
+
+    /**
+     * @brief Construct a new BoundedQueue, allocates all the storage the queue will ever use
+     *
+     * @param capacity - maximal amount of elements the queue can hold
+     * @param alloc - allocator of the buffer
+     */
+    explicit BoundedQueue(std::size_t capacity, const Alloc& alloc = Alloc());
+
+    /**
+     * @brief Copy Constructor for a BoundedQueue, the copy has the same capacity
+     *
+     * @param other - BoundedQueue to copy
+     */
+    BoundedQueue(const BoundedQueue& other);
+
+    /**
+     * @brief Move Constructor for a BoundedQueue, steals the buffer of other in O(1)
+     *
+     * @param other - BoundedQueue to move from, left empty with capacity 0
+     */
+    BoundedQueue(BoundedQueue&& other) noexcept;
+
+    /**
+     * @brief Assignment operator of a BoundedQueue, this takes the capacity of other
+     *
+     * @param other - BoundedQueue to copy & assign
+     * @return - reference to the copied queue
+     */
+    BoundedQueue& operator=(const BoundedQueue& other);
+
+    /**
+     * @brief Move assignment operator of a BoundedQueue, this takes the buffer and capacity of other
+     *
+     * @param other - BoundedQueue to move from, left empty with capacity 0
+     * @return - reference to the assigned queue
+     */
+    BoundedQueue& operator=(BoundedQueue&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value ||
+                                                           AllocTraits::is_always_equal::value);
+
+    /**
+     * @brief Inserts in the back of the BoundedQueue if there is room
+     *
+     * @param val - value to be inserted
+     * @return true if the value was inserted
+     * @return false if the queue is full
+     */
+    bool tryPush(const T& val);
+
+    /**
+     * @brief Moves a value into the back of the BoundedQueue if there is room
+     *
+     * @param val - value to be moved into the queue, untouched if the queue is full
+     * @return true if the value was inserted
+     * @return false if the queue is full
+     */
+    bool tryPush(T&& val);
+
+    /**
+     * @brief Constructs a new element in place in the back of the BoundedQueue if there is room
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     * @return true if the element was constructed
+     * @return false if the queue is full
+     */
+    template<typename... Args>
+    bool tryEmplace(Args&&... args);
+
+    /**
+     * @brief Inserts in the back of the BoundedQueue
+     *
+     * @param val - value to be inserted
+     */
+    void pushBack(const T& val);
+
+    /**
+     * @brief Inserts in the back of the BoundedQueue by moving the given value
+     *
+     * @param val - value to be moved into the queue
+     */
+    void pushBack(T&& val);
+
+    /**
+     * @brief Constructs a new element in place in the back of the BoundedQueue
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     * @return - reference to the newly constructed element
+     */
+    template<typename... Args>
+    T& emplaceBack(Args&&... args);
+
+    /**
+     * @brief Returns a reference to the front of the queue
+     *
+     * @return - reference to the data stored in the front
+     */
+    T& front();
+
+    /**
+     * @brief Returns a const reference to the front of the queue
+     *
+     * @return - const reference to the data stored in the front
+     */
+    const T& front() const;
+
+    /**
+     * @brief Pops the element in the front of the queue
+     *
+     */
+    void popFront();
+
+    /**
+     * @brief Returns a pointer to the front of the queue without throwing
+     *
+     * @return - pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    T* tryFront();
+
+    /**
+     * @brief Returns a const pointer to the front of the queue without throwing
+     *
+     * @return - const pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    const T* tryFront() const;
+
+    /**
+     * @brief Moves the front element out of the queue and pops it, without throwing on an empty queue
+     *
+     * @return - the front element, or an empty optional if the queue is empty
+     */
+    std::optional<T> tryPop();
+
+    /**
+     * @brief Checks if the queue is empty
+     *
+     * @return true if the queue holds no elements
+     */
+    bool empty() const;
+
+    /**
+     * @brief Checks if the queue is full
+     *
+     * @return true if the queue holds capacity() elements
+     */
+    bool full() const;
+
+    /**
+     * @brief Returns the size of the queue
+     *
+     * @return - size of the queue
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Returns the maximal amount of elements the queue can hold
+     *
+     * @return - capacity of the queue
+     */
+    std::size_t capacity() const;
+
+    /**
+     * @brief Destroys every element, the preallocated buffer is kept
+     *
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Iterator classes for BoundedQueue
+     *
+     */
+    typedef typename RingQueue<T, Alloc>::Iterator Iterator;
+    typedef typename RingQueue<T, Alloc>::ConstIterator ConstIterator;
+
+    Iterator begin()
+    {
+        return m_queue.begin();
+    }
+
+    Iterator end()
+    {
+        return m_queue.end();
+    }
+
+    ConstIterator begin() const
+    {
+        return m_queue.begin();
+    }
+
+    ConstIterator end() const
+    {
+        return m_queue.end();
+    }
+
+    /**
+     * @brief Exception Class to deal with invalid operations done on an empty BoundedQueue
+     *
+     *  Invalid operators on an empty BoundedQueue:
+     *      front, popFront
+     */
+    typedef typename RingQueue<T, Alloc>::EmptyQueue EmptyQueue;
+
+    /**
+     * @brief Exception Class to deal with pushing into a full BoundedQueue
+     *
+     *  Invalid operators on a full BoundedQueue:
+     *      pushBack, emplaceBack
+     */
+    class FullQueue {};
+};
+
+template<typename T, typename Alloc>
+BoundedQueue<T, Alloc>::BoundedQueue(std::size_t capacity, const Alloc& alloc) :
+    m_queue(alloc),
+    m_capacity(capacity)
+{
+    m_queue.reserve(m_capacity);
+}
+
+template<typename T, typename Alloc>
+BoundedQueue<T, Alloc>::BoundedQueue(const BoundedQueue& other) :
+    BoundedQueue(other.m_capacity,
+                 std::allocator_traits<Alloc>::select_on_container_copy_construction(other.m_queue.getAllocator()))
+{
+    m_queue.pushBack(other.m_queue.begin(), other.m_queue.end());
+}
+
+template<typename T, typename Alloc>
+BoundedQueue<T, Alloc>::BoundedQueue(BoundedQueue&& other) noexcept :
+    m_queue(std::move(other.m_queue)),
+    m_capacity(other.m_capacity)
+{
+    other.m_capacity = 0;
+}
+
+template<typename T, typename Alloc>
+BoundedQueue<T, Alloc>& BoundedQueue<T, Alloc>::operator=(const BoundedQueue& other)
+{
+    if(this == &other){
+        return *this;
+    }
+
+    BoundedQueue temp(other);
+    *this = std::move(temp);
+    return *this;
+}
+
+template<typename T, typename Alloc>
+BoundedQueue<T, Alloc>& BoundedQueue<T, Alloc>::operator=(BoundedQueue&& other)
+    noexcept(AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+{
+    if(this == &other){
+        return *this;
+    }
+
+    if(!AllocTraits::propagate_on_container_move_assignment::value &&
+       !(m_queue.getAllocator() == other.m_queue.getAllocator())){ //this's allocator can't free other's buffer
+        RingQueue<T, Alloc> temp(m_queue.getAllocator());
+        temp.reserve(other.m_capacity); //the whole buffer up front, so later pushes still never allocate
+        for(T& data : other.m_queue){
+            temp.pushBack(std::move(data));
+        }
+        m_queue = std::move(temp);
+        other.m_queue = RingQueue<T, Alloc>(other.m_queue.getAllocator());
+    }
+    else{
+        m_queue = std::move(other.m_queue);
+    }
+        /*  the RingQueue move assignments leave their source empty without a buffer,
+         *  so other holds nothing and rejects every push with its capacity of 0
+         */
+    m_capacity = other.m_capacity;
+    other.m_capacity = 0;
+    return *this;
+}
+
+template<typename T, typename Alloc>
+bool BoundedQueue<T, Alloc>::tryPush(const T& val)
+{
+    return this->tryEmplace(val);
+}
+
+template<typename T, typename Alloc>
+bool BoundedQueue<T, Alloc>::tryPush(T&& val)
+{
+    return this->tryEmplace(std::move(val));
+}
+
+template<typename T, typename Alloc>
+template<typename... Args>
+bool BoundedQueue<T, Alloc>::tryEmplace(Args&&... args)
+{
+    if(m_queue.size() == m_capacity){ //fail fast, never grows past the reserved buffer
+        return false;
+    }
+    m_queue.emplaceBack(std::forward<Args>(args)...);
+    return true;
+}
+
+template<typename T, typename Alloc>
+void BoundedQueue<T, Alloc>::pushBack(const T& val)
+{
+    this->emplaceBack(val);
+}
+
+template<typename T, typename Alloc>
+void BoundedQueue<T, Alloc>::pushBack(T&& val)
+{
+    this->emplaceBack(std::move(val));
+}
+
+template<typename T, typename Alloc>
+template<typename... Args>
+T& BoundedQueue<T, Alloc>::emplaceBack(Args&&... args)
+{
+    if(m_queue.size() == m_capacity){ //operation is invalid on a full queue
+        throw FullQueue();
+    }
+    return m_queue.emplaceBack(std::forward<Args>(args)...);
+}
+
+template<typename T, typename Alloc>
+T& BoundedQueue<T, Alloc>::front()
+{
+    return m_queue.front();
+}
+
+template<typename T, typename Alloc>
+const T& BoundedQueue<T, Alloc>::front() const
+{
+    return m_queue.front();
+}
+
+template<typename T, typename Alloc>
+void BoundedQueue<T, Alloc>::popFront()
+{
+    m_queue.popFront();
+}
+
+template<typename T, typename Alloc>
+T* BoundedQueue<T, Alloc>::tryFront()
+{
+    return m_queue.tryFront();
+}
+
+template<typename T, typename Alloc>
+const T* BoundedQueue<T, Alloc>::tryFront() const
+{
+    return m_queue.tryFront();
+}
+
+template<typename T, typename Alloc>
+std::optional<T> BoundedQueue<T, Alloc>::tryPop()
+{
+    return m_queue.tryPop();
+}
+
+template<typename T, typename Alloc>
+bool BoundedQueue<T, Alloc>::empty() const
+{
+    return m_queue.empty();
+}
+
+template<typename T, typename Alloc>
+bool BoundedQueue<T, Alloc>::full() const
+{
+    return m_queue.size() == m_capacity;
+}
+
+template<typename T, typename Alloc>
+std::size_t BoundedQueue<T, Alloc>::size() const
+{
+    return m_queue.size();
+}
+
+template<typename T, typename Alloc>
+std::size_t BoundedQueue<T, Alloc>::capacity() const
+{
+    return m_capacity;
+}
+
+template<typename T, typename Alloc>
+void BoundedQueue<T, Alloc>::clear() noexcept
+{
+    m_queue.clear();
+}
+
+#endif
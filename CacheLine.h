@@ -0,0 +1,14 @@
+#ifndef CACHE_LINE_H
+#define CACHE_LINE_H
+
+#include <cstddef>
+
+/**
+ * @brief Size of a cache line, used to keep data written by different threads on different lines
+ *
+ *  std::hardware_destructive_interference_size isn't reliably available (and its value may change between
+ *  compiler versions, which breaks ABI), so the common x86-64/AArch64 value is used
+ */
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+#endif
@@ -0,0 +1,999 @@
+#ifndef CHUNKED_QUEUE_H
+#define CHUNKED_QUEUE_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "QueueAlgorithms.h"
+#include "QueueConfig.h"
+
+/* ChunkedQueue:
+ *      Queue with the same interface as Queue<T>, stored in an unrolled linked list
+ *      every node (chunk) holds ChunkSize elements, so a push allocates once per ChunkSize elements
+ *      and iteration walks ChunkSize contiguous elements between pointer hops
+ *      elements are never moved, references stay valid until the element is popped
+ *      one emptied chunk is kept aside and reused, so a steady push/pop loop doesn't allocate at all
+ *      a trivially copyable T is copied and pushed from a pointer range by one memcpy per chunk,
+ *      and clearing or destroying a queue of a trivially destructible T only frees the chunks
+ *
+ * @tparam T - type of the elements
+ * @tparam ChunkSize - amount of elements stored in a single chunk
+ * @tparam Alloc - allocator, rebound to allocate whole chunks
+ */
+template <class T, std::size_t ChunkSize = 64, class Alloc = std::allocator<T>>
+class ChunkedQueue {
+    static_assert(ChunkSize > 0, "ChunkSize must be positive");
+private:
+
+    //private chunk struct to implement the queue, elements are constructed in place inside storage
+    struct Chunk {
+        alignas(T) unsigned char storage[sizeof(T) * ChunkSize]; //raw storage of ChunkSize elements
+        Chunk* next; //pointer to next chunk
+
+        //C'tor of a chunk, makes an empty chunk that points to nullptr
+        Chunk() :
+            next(nullptr)
+        { }
+
+        //returns the slot of the element at the given index
+        T* slot(std::size_t index) noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(storage) + index);
+        }
+    };
+
+    //allocator of chunks, rebound from Alloc
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Chunk> ChunkAllocator;
+    typedef std::allocator_traits<ChunkAllocator> ChunkTraits;
+
+    //true when elements are copied as raw memory, elements are placement new'ed so the allocator doesn't matter
+    static constexpr bool BITWISE_COPY = std::is_trivially_copyable<T>::value;
+
+    //true when destroying an element does nothing
+    static constexpr bool TRIVIAL_DESTROY = std::is_trivially_destructible<T>::value;
+
+    ChunkAllocator m_alloc; //allocates and frees every chunk of the queue
+    Chunk* m_frontChunk; //chunk holding the front of the queue
+    Chunk* m_rearChunk; //chunk holding the rear of the queue, always points to nullptr
+    std::size_t m_frontIndex; //index of the front element in m_frontChunk
+    std::size_t m_rearIndex; //index beyond the rear element in m_rearChunk
+    Chunk* m_spare; //emptied chunk kept for the next push that needs a chunk, or nullptr
+    std::size_t m_size; //size of the queue, dynamically increasing and decreasing as the queue changes
+
+    /* RawIterator:
+     *      Iterator class that supports both const iteration and normal iteration
+     *      requires a template that decides which type of iteration to do
+     *      for normal iteration: use Iterator
+     *      for const iteration: use ConstIterator
+     */
+    template<typename Modified_Type>
+    class RawIterator;
+
+    //returns the spare chunk if there is one, otherwise allocates a new chunk
+    Chunk* acquireChunk();
+
+    //keeps an emptied chunk as the spare, or frees it if there already is one
+    void releaseChunk(Chunk* chunk) noexcept;
+
+    //frees a chunk through m_alloc, its elements must already be destroyed
+    void freeChunk(Chunk* chunk) noexcept;
+
+    //destroys every element, frees every chunk and leaves the queue empty
+    void destroyChunks() noexcept;
+
+    //swaps the chunk chains and sizes of two queues, allocators are untouched
+    void swapChunks(ChunkedQueue& other) noexcept;
+
+    //pops the front element, the queue must not be empty
+    void removeFront() noexcept;
+
+    //destroys every element pushed after the rear was at (rear, rearIndex) with the given size
+    void truncate(Chunk* rear, std::size_t rearIndex, std::size_t size) noexcept;
+
+    //memcpys count elements behind the rear, linking chunks as needed, only used when BITWISE_COPY
+    //if a chunk can't be allocated, the elements copied so far stay in the queue
+    void copyBack(const T* data, std::size_t count);
+
+public:
+
+    /**
+     * @brief Construct a new ChunkedQueue, no memory is allocated until the first push
+     *
+     */
+    ChunkedQueue();
+
+    /**
+     * @brief Construct a new ChunkedQueue that allocates its chunks with the given allocator
+     *
+     * @param alloc - allocator to rebind for the chunks
+     */
+    explicit ChunkedQueue(const Alloc& alloc);
+
+    /**
+     * @brief Copy Constructor for a ChunkedQueue
+     *
+     * @param other - ChunkedQueue to copy
+     */
+    ChunkedQueue(const ChunkedQueue& other);
+
+    /**
+     * @brief Copy Constructor for a ChunkedQueue that uses the given allocator
+     *
+     * @param other - ChunkedQueue to copy
+     * @param alloc - allocator to rebind for the chunks
+     */
+    ChunkedQueue(const ChunkedQueue& other, const Alloc& alloc);
+
+    /**
+     * @brief Move Constructor for a ChunkedQueue, steals the chunks of other in O(1)
+     *
+     * @param other - ChunkedQueue to move from, left empty
+     */
+    ChunkedQueue(ChunkedQueue&& other) noexcept;
+
+    /**
+     * @brief Destroys the ChunkedQueue
+     *
+     */
+    ~ChunkedQueue();
+
+    /**
+     * @brief Assignment operator of a ChunkedQueue
+     *
+     * @param other - ChunkedQueue to copy & assign
+     * @return - reference to the copied queue
+     */
+    ChunkedQueue& operator=(const ChunkedQueue& other);
+
+    /**
+     * @brief Move assignment operator of a ChunkedQueue, steals the chunks of other in O(1)
+     *
+     * @param other - ChunkedQueue to move from, left empty
+     * @return - reference to the assigned queue
+     */
+    ChunkedQueue& operator=(ChunkedQueue&& other) noexcept(ChunkTraits::propagate_on_container_move_assignment::value ||
+                                                           ChunkTraits::is_always_equal::value);
+
+    /**
+     * @brief Inserts in the back of the ChunkedQueue
+     *
+     * @param val - value to be inserted
+     */
+    void pushBack(const T& val);
+
+    /**
+     * @brief Inserts in the back of the ChunkedQueue by moving the given value
+     *
+     * @param val - value to be moved into the queue
+     */
+    void pushBack(T&& val);
+
+    /**
+     * @brief Constructs a new element in place in the back of the ChunkedQueue
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     * @return - reference to the newly constructed element
+     */
+    template<typename... Args>
+    T& emplaceBack(Args&&... args);
+
+    /**
+     * @brief Inserts the elements of [first, last) in the back of the queue, in order
+     *
+     *      strong guarantee: if an element can't be inserted, the queue is left unchanged
+     *
+     * @param first - beginning of the range to insert
+     * @param last - end of the range to insert
+     */
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void pushBack(InputIt first, InputIt last);
+
+    /**
+     * @brief Returns a reference to the front of the queue
+     *
+     * @return - reference to the data stored in the front
+     */
+    T& front();
+
+    /**
+     * @brief Returns a const reference to the front of the queue
+     *
+     * @return - const reference to the data stored in the front
+     */
+    const T& front() const;
+
+    /**
+     * @brief Pops the element in the front of the queue
+     *
+     */
+    void popFront();
+
+    /**
+     * @brief Pops the n elements in the front of the queue
+     *
+     * @param n - amount of elements to pop, if the queue holds fewer EmptyQueue is thrown and nothing is popped
+     */
+    void popFront(std::size_t n);
+
+    /**
+     * @brief Moves up to n elements from the front of the queue into out and pops them
+     *
+     * @param out - output iterator receiving the elements in order
+     * @param n - maximal amount of elements to move
+     * @return - amount of elements moved, smaller than n if the queue ran out of elements
+     */
+    template<typename OutputIt>
+    std::size_t drainTo(OutputIt out, std::size_t n);
+
+    /**
+     * @brief Checks if the queue is empty
+     *
+     * @return true if the queue holds no elements
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns a pointer to the front of the queue without throwing
+     *
+     * @return - pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    T* tryFront();
+
+    /**
+     * @brief Returns a const pointer to the front of the queue without throwing
+     *
+     * @return - const pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    const T* tryFront() const;
+
+    /**
+     * @brief Moves the front element out of the queue and pops it, without throwing on an empty queue
+     *
+     * @return - the front element, or an empty optional if the queue is empty
+     */
+    std::optional<T> tryPop();
+
+    /**
+     * @brief Returns the size of the queue
+     *
+     * @return - size of the queue
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Destroys every element and frees every chunk in a single pass
+     *
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Frees the spare chunk kept for the next pushes
+     *
+     */
+    void shrinkToFit() noexcept;
+
+    /**
+     * @brief Calls visit(data, count) for every contiguous run of elements, front to back
+     *      a run is the used part of a chunk, at most ChunkSize elements
+     *
+     * @param visit - callable taking a const T* to the first element of a run and the length of the run
+     */
+    template<typename Visitor>
+    void forEachRun(Visitor visit) const;
+
+    /**
+     * @brief Returns a copy of the allocator the ChunkedQueue was constructed with
+     *
+     * @return - allocator of the queue
+     */
+    Alloc getAllocator() const;
+
+    /**
+     * @brief Iterator class for ChunkedQueue
+     *
+     */
+    typedef RawIterator<T> Iterator;
+
+    /**
+     * @brief Const Iterator class for ChunkedQueue
+     *
+     */
+    typedef RawIterator<const T> ConstIterator;
+
+    /**
+     * @brief Returns an Iterator pointing to the front of the ChunkedQueue
+     */
+    Iterator begin()
+    {
+        return Iterator(this, m_frontChunk, m_frontIndex);
+    }
+
+    /**
+     * @brief Returns an Iterator pointing to the end of the ChunkedQueue
+     */
+    Iterator end()
+    {
+        return Iterator(this, m_rearChunk, m_rearIndex); //the slot beyond the rear is the end
+    }
+
+    /**
+     * @brief Returns a Const Iterator pointing to the front of the ChunkedQueue
+     */
+    ConstIterator begin() const
+    {
+        return ConstIterator(this, m_frontChunk, m_frontIndex);
+    }
+
+    /**
+     * @brief Returns a Const Iterator pointing to the end of the ChunkedQueue
+     */
+    ConstIterator end() const
+    {
+        return ConstIterator(this, m_rearChunk, m_rearIndex); //the slot beyond the rear is the end
+    }
+
+    /**
+     * @brief Exception Class to deal with invalid operations done on an empty ChunkedQueue
+     *
+     *  Invalid operators on an empty ChunkedQueue:
+     *      front, popFront
+     */
+    class EmptyQueue {};
+};
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+ChunkedQueue<T, ChunkSize, Alloc>::ChunkedQueue() :
+    m_alloc(),
+    m_frontChunk(nullptr),
+    m_rearChunk(nullptr),
+    m_frontIndex(0),
+    m_rearIndex(0),
+    m_spare(nullptr),
+    m_size(0)
+{ }
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+ChunkedQueue<T, ChunkSize, Alloc>::ChunkedQueue(const Alloc& alloc) :
+    m_alloc(alloc),
+    m_frontChunk(nullptr),
+    m_rearChunk(nullptr),
+    m_frontIndex(0),
+    m_rearIndex(0),
+    m_spare(nullptr),
+    m_size(0)
+{ }
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+ChunkedQueue<T, ChunkSize, Alloc>::ChunkedQueue(const ChunkedQueue& other) :
+    ChunkedQueue(other, std::allocator_traits<Alloc>::select_on_container_copy_construction(other.getAllocator()))
+{ }
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+ChunkedQueue<T, ChunkSize, Alloc>::ChunkedQueue(const ChunkedQueue& other, const Alloc& alloc) :
+    ChunkedQueue(alloc)
+{
+    if constexpr(BITWISE_COPY){ //one memcpy per chunk, if an allocation fails the d'tor frees what was copied
+        other.forEachRun([this](const T* data, std::size_t count){
+            this->copyBack(data, count);
+        });
+        return;
+    }
+    try{
+        for(const T& data : other){
+            this->pushBack(data);
+        }
+    } catch(...){ //either the allocator or the copy c'tor of T failed
+        this->destroyChunks();
+        throw;
+    }
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+ChunkedQueue<T, ChunkSize, Alloc>::ChunkedQueue(ChunkedQueue&& other) noexcept :
+    m_alloc(std::move(other.m_alloc)),
+    m_frontChunk(other.m_frontChunk),
+    m_rearChunk(other.m_rearChunk),
+    m_frontIndex(other.m_frontIndex),
+    m_rearIndex(other.m_rearIndex),
+    m_spare(other.m_spare),
+    m_size(other.m_size)
+{
+    other.m_frontChunk = nullptr;
+    other.m_rearChunk = nullptr;
+    other.m_frontIndex = 0;
+    other.m_rearIndex = 0;
+    other.m_spare = nullptr;
+    other.m_size = 0;
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+ChunkedQueue<T, ChunkSize, Alloc>::~ChunkedQueue()
+{
+    this->destroyChunks();
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+ChunkedQueue<T, ChunkSize, Alloc>& ChunkedQueue<T, ChunkSize, Alloc>::operator=(const ChunkedQueue& other)
+{
+    if(this == &other){
+        return *this;
+    }
+
+    constexpr bool propagate = ChunkTraits::propagate_on_container_copy_assignment::value;
+    ChunkedQueue temp(other, propagate ? other.getAllocator() : this->getAllocator());
+    this->swapChunks(temp);
+    if(propagate){
+        std::swap(temp.m_alloc, m_alloc);
+    }
+        /*  copy & swap, temp's d'tor releases this's old chunks with the allocator they came from
+         *  if the copy fails, this is left untouched
+         */
+    return *this;
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+ChunkedQueue<T, ChunkSize, Alloc>& ChunkedQueue<T, ChunkSize, Alloc>::operator=(ChunkedQueue&& other)
+    noexcept(ChunkTraits::propagate_on_container_move_assignment::value || ChunkTraits::is_always_equal::value)
+{
+    if(this == &other){
+        return *this;
+    }
+
+    if(ChunkTraits::propagate_on_container_move_assignment::value){
+        this->swapChunks(other);
+        std::swap(other.m_alloc, m_alloc);
+    }
+    else if(m_alloc == other.m_alloc){
+        this->swapChunks(other);
+    }
+    else{ //this's allocator can't free other's chunks, moving element by element
+        ChunkedQueue temp(this->getAllocator());
+        for(T& data : other){
+            temp.pushBack(std::move(data));
+        }
+        this->swapChunks(temp);
+    }
+    other.destroyChunks();
+        /*  swaps the lists, this takes other's chunks in O(1) and other holds this's old ones,
+         *  which are freed right away with the allocator they came from, so other is left empty
+         */
+    return *this;
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+void ChunkedQueue<T, ChunkSize, Alloc>::pushBack(const T& val)
+{
+    this->emplaceBack(val);
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+void ChunkedQueue<T, ChunkSize, Alloc>::pushBack(T&& val)
+{
+    this->emplaceBack(std::move(val));
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+template<typename... Args>
+T& ChunkedQueue<T, ChunkSize, Alloc>::emplaceBack(Args&&... args)
+{
+    if(m_rearChunk != nullptr && m_rearIndex < ChunkSize){ //room left in the rear chunk
+        T* target = m_rearChunk->slot(m_rearIndex);
+        ::new (static_cast<void*>(target)) T(std::forward<Args>(args)...);
+        m_rearIndex++;
+        m_size++;
+        return *target;
+    }
+
+    Chunk* chunk = this->acquireChunk();
+    T* target = chunk->slot(0);
+    try{ //the chunk is linked only once its first element exists
+        ::new (static_cast<void*>(target)) T(std::forward<Args>(args)...);
+    } catch(...){
+        this->releaseChunk(chunk);
+        throw;
+    }
+    if(m_rearChunk == nullptr){ //first chunk of the queue
+        m_frontChunk = chunk;
+        m_frontIndex = 0;
+    }
+    else{ //rear chunk is full, linking the new one
+        m_rearChunk->next = chunk;
+    }
+    m_rearChunk = chunk;
+    m_rearIndex = 1;
+    m_size++;
+    return *target;
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+template<typename InputIt, typename>
+void ChunkedQueue<T, ChunkSize, Alloc>::pushBack(InputIt first, InputIt last)
+{
+    Chunk* oldRear = m_rearChunk;
+    std::size_t oldRearIndex = m_rearIndex;
+    std::size_t oldSize = m_size;
+    try{
+        if constexpr(BITWISE_COPY && std::is_pointer<InputIt>::value &&
+                     std::is_same<typename std::iterator_traits<InputIt>::value_type, T>::value){
+            this->copyBack(first, static_cast<std::size_t>(last - first));
+        }
+        else{
+            for(; first != last; ++first){
+                this->emplaceBack(*first);
+            }
+        }
+    } catch(...){ //removing what was already inserted
+        this->truncate(oldRear, oldRearIndex, oldSize);
+        throw;
+    }
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+T& ChunkedQueue<T, ChunkSize, Alloc>::front()
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    else{ //normal reference to the data
+        return *m_frontChunk->slot(m_frontIndex);
+    }
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+const T& ChunkedQueue<T, ChunkSize, Alloc>::front() const
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    else{ //const reference to the data
+        return *m_frontChunk->slot(m_frontIndex);
+    }
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+void ChunkedQueue<T, ChunkSize, Alloc>::popFront()
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    else{
+        this->removeFront();
+    }
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+void ChunkedQueue<T, ChunkSize, Alloc>::popFront(std::size_t n)
+{
+    if(n > m_size){ //checked once for the whole batch
+        throw EmptyQueue();
+    }
+    for(std::size_t i = 0; i < n; i++){
+        this->removeFront();
+    }
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+template<typename OutputIt>
+std::size_t ChunkedQueue<T, ChunkSize, Alloc>::drainTo(OutputIt out, std::size_t n)
+{
+    std::size_t count = n < m_size ? n : m_size;
+    for(std::size_t i = 0; i < count; i++){
+        *out = std::move(*m_frontChunk->slot(m_frontIndex));
+        ++out;
+        this->removeFront();
+    }
+    return count;
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+bool ChunkedQueue<T, ChunkSize, Alloc>::empty() const
+{
+    return m_size == 0;
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+T* ChunkedQueue<T, ChunkSize, Alloc>::tryFront()
+{
+    return m_size == 0 ? nullptr : &*m_frontChunk->slot(m_frontIndex);
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+const T* ChunkedQueue<T, ChunkSize, Alloc>::tryFront() const
+{
+    return m_size == 0 ? nullptr : &*m_frontChunk->slot(m_frontIndex);
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+std::optional<T> ChunkedQueue<T, ChunkSize, Alloc>::tryPop()
+{
+    if(m_size == 0){ //the common case for a polling consumer, no exception involved
+        return std::nullopt;
+    }
+    std::optional<T> result(std::move(*m_frontChunk->slot(m_frontIndex)));
+    this->removeFront();
+    return result;
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+void ChunkedQueue<T, ChunkSize, Alloc>::removeFront() noexcept
+{
+    m_frontChunk->slot(m_frontIndex)->~T();
+    m_frontIndex++;
+    m_size--;
+    if(m_size == 0){ //queue is empty, the remaining chunk starts over from its first slot
+        m_frontIndex = m_rearIndex = 0;
+    }
+    else if(m_frontIndex == ChunkSize){ //front chunk is used up, moving to the next one
+        Chunk* temp = m_frontChunk;
+        m_frontChunk = m_frontChunk->next;
+        m_frontIndex = 0;
+        this->releaseChunk(temp);
+    }
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+std::size_t ChunkedQueue<T, ChunkSize, Alloc>::size() const
+{
+    return m_size;
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+void ChunkedQueue<T, ChunkSize, Alloc>::clear() noexcept
+{
+    this->destroyChunks();
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+void ChunkedQueue<T, ChunkSize, Alloc>::shrinkToFit() noexcept
+{
+    if(m_spare != nullptr){
+        this->freeChunk(m_spare);
+        m_spare = nullptr;
+    }
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+template<typename Visitor>
+void ChunkedQueue<T, ChunkSize, Alloc>::forEachRun(Visitor visit) const
+{
+    if(m_size == 0){
+        return;
+    }
+    std::size_t index = m_frontIndex;
+    for(Chunk* chunk = m_frontChunk; chunk != nullptr; chunk = chunk->next){
+        //the rear chunk ends at m_rearIndex, every other chunk is full up to its last slot
+        std::size_t last = chunk == m_rearChunk ? m_rearIndex : ChunkSize;
+        visit(static_cast<const T*>(chunk->slot(index)), last - index);
+        index = 0;
+    }
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+Alloc ChunkedQueue<T, ChunkSize, Alloc>::getAllocator() const
+{
+    return Alloc(m_alloc);
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+typename ChunkedQueue<T, ChunkSize, Alloc>::Chunk* ChunkedQueue<T, ChunkSize, Alloc>::acquireChunk()
+{
+    if(m_spare != nullptr){
+        Chunk* chunk = m_spare;
+        m_spare = nullptr;
+        chunk->next = nullptr;
+        return chunk;
+    }
+    Chunk* chunk = ChunkTraits::allocate(m_alloc, 1);
+    ChunkTraits::construct(m_alloc, chunk); //can't throw, Chunk only holds raw storage
+    return chunk;
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+void ChunkedQueue<T, ChunkSize, Alloc>::releaseChunk(Chunk* chunk) noexcept
+{
+    if(m_spare == nullptr){
+        m_spare = chunk;
+    }
+    else{
+        this->freeChunk(chunk);
+    }
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+void ChunkedQueue<T, ChunkSize, Alloc>::freeChunk(Chunk* chunk) noexcept
+{
+    ChunkTraits::destroy(m_alloc, chunk);
+    ChunkTraits::deallocate(m_alloc, chunk, 1);
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+void ChunkedQueue<T, ChunkSize, Alloc>::destroyChunks() noexcept
+{
+    while(m_frontChunk != nullptr){
+        //the rear chunk ends at m_rearIndex, every other chunk is full up to its last slot
+        std::size_t last = m_frontChunk == m_rearChunk ? m_rearIndex : ChunkSize;
+        if constexpr(!TRIVIAL_DESTROY){
+            for(std::size_t i = m_frontIndex; i < last; i++){
+                m_frontChunk->slot(i)->~T();
+            }
+        }
+        Chunk* temp = m_frontChunk;
+        m_frontChunk = m_frontChunk->next;
+        m_frontIndex = 0;
+        this->freeChunk(temp);
+    }
+    if(m_spare != nullptr){
+        this->freeChunk(m_spare);
+    }
+    m_rearChunk = nullptr;
+    m_rearIndex = 0;
+    m_spare = nullptr;
+    m_size = 0;
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+void ChunkedQueue<T, ChunkSize, Alloc>::truncate(Chunk* rear, std::size_t rearIndex, std::size_t size) noexcept
+{
+    if(size == 0){ //everything in the queue is new
+        Chunk* spare = m_spare;
+        m_spare = nullptr;
+        this->destroyChunks();
+        m_spare = spare;
+        return;
+    }
+
+    Chunk* chunk = rear;
+    std::size_t index = rearIndex;
+    while(true){ //destroying the new elements, from where the old rear ended up to the current rear
+        std::size_t last = chunk == m_rearChunk ? m_rearIndex : ChunkSize;
+        if constexpr(!TRIVIAL_DESTROY){
+            for(; index < last; index++){
+                chunk->slot(index)->~T();
+            }
+        }
+        if(chunk == m_rearChunk){
+            break;
+        }
+        chunk = chunk->next;
+        index = 0;
+    }
+
+    Chunk* extra = rear->next;
+    while(extra != nullptr){ //chunks linked after the old rear only held new elements
+        Chunk* temp = extra;
+        extra = extra->next;
+        this->releaseChunk(temp);
+    }
+    rear->next = nullptr;
+    m_rearChunk = rear;
+    m_rearIndex = rearIndex;
+    m_size = size;
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+void ChunkedQueue<T, ChunkSize, Alloc>::copyBack(const T* data, std::size_t count)
+{
+    while(count > 0){
+        if(m_rearChunk == nullptr || m_rearIndex == ChunkSize){ //linked right before it gets its first elements
+            Chunk* chunk = this->acquireChunk();
+            if(m_rearChunk == nullptr){ //first chunk of the queue
+                m_frontChunk = chunk;
+                m_frontIndex = 0;
+            }
+            else{ //rear chunk is full, linking the new one
+                m_rearChunk->next = chunk;
+            }
+            m_rearChunk = chunk;
+            m_rearIndex = 0;
+        }
+        std::size_t room = ChunkSize - m_rearIndex;
+        std::size_t copied = count < room ? count : room;
+        std::memcpy(static_cast<void*>(m_rearChunk->storage + m_rearIndex * sizeof(T)), static_cast<const void*>(data),
+                    copied * sizeof(T));
+        m_rearIndex += copied;
+        m_size += copied;
+        data += copied;
+        count -= copied;
+    }
+}
+
+template<typename T, std::size_t ChunkSize, typename Alloc>
+void ChunkedQueue<T, ChunkSize, Alloc>::swapChunks(ChunkedQueue& other) noexcept
+{
+    std::swap(other.m_frontChunk, m_frontChunk);
+    std::swap(other.m_rearChunk, m_rearChunk);
+    std::swap(other.m_frontIndex, m_frontIndex);
+    std::swap(other.m_rearIndex, m_rearIndex);
+    std::swap(other.m_spare, m_spare);
+    std::swap(other.m_size, m_size);
+}
+
+/**
+ * @brief RawIterator template to support Iterator and ConstIterator classes
+ *
+ * @tparam Type - type of queue
+ * @tparam ChunkSize - amount of elements in a chunk of queue
+ * @tparam Alloc - allocator of queue
+ * @tparam Modified_Type
+ *      Type - normal iterator
+ *      const Type - const iterator
+ */
+template<typename Type, std::size_t ChunkSize, typename Alloc>
+template<typename Modified_Type>
+class ChunkedQueue<Type, ChunkSize, Alloc>::RawIterator {
+public:
+    //allowing the use of ConstIterator with a non-const ChunkedQueue by conversion
+    operator typename ChunkedQueue<Type, ChunkSize, Alloc>::template RawIterator<const Modified_Type>() const
+    {
+        return typename ChunkedQueue<Type, ChunkSize, Alloc>::template RawIterator<const Modified_Type>(
+            m_ptr, m_currentChunk, m_index);
+    }
+private:
+    const ChunkedQueue<Type, ChunkSize, Alloc>* m_ptr; //Pointer to the queue to be iterated
+    Chunk* m_currentChunk; //Current chunk iterator points into
+    std::size_t m_index; //Index of the current element in m_currentChunk
+
+    /**
+     * @brief Constructor for an Iterator
+     *
+     * @param ptr - pointer to the queue to iterate
+     * @param chunk - initial chunk to point into
+     * @param index - initial index in chunk
+     */
+    RawIterator(const ChunkedQueue<Type, ChunkSize, Alloc>* ptr, Chunk* chunk, std::size_t index) :
+        m_ptr(ptr),
+        m_currentChunk(chunk),
+        m_index(index)
+    { }
+
+    //returns true if the iterator points beyond the rear of the queue
+    bool atEnd() const
+    {
+        return m_currentChunk == m_ptr->m_rearChunk && m_index == m_ptr->m_rearIndex;
+    }
+
+    //moves to the next slot, hopping to the next chunk at the end of a chunk that isn't the rear
+    void advance()
+    {
+        m_index++;
+        if(m_index == ChunkSize && m_currentChunk->next != nullptr){
+            m_currentChunk = m_currentChunk->next;
+            m_index = 0;
+        }
+    }
+
+    //throws InvalidOperation if the iterator points to the end, only asserts with QUEUE_UNCHECKED_ITERATORS
+    void checkNotEnd() const
+    {
+#if QUEUE_UNCHECKED_ITERATORS
+        assert(!this->atEnd());
+#else
+        if(this->atEnd()){
+            throw InvalidOperation();
+        }
+#endif
+    }
+
+    //allows ChunkedQueue to access private c'tor
+    friend class ChunkedQueue<Type, ChunkSize, Alloc>;
+public:
+
+    /**
+     * Standard iterator traits, RawIterator is a forward iterator
+     *
+     */
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::remove_const<Modified_Type>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Modified_Type* pointer;
+    typedef Modified_Type& reference;
+
+    /**
+     * @brief Constructs a singular iterator, that may only be assigned to or compared
+     *
+     */
+    RawIterator() :
+        m_ptr(nullptr),
+        m_currentChunk(nullptr),
+        m_index(0)
+    { }
+
+    /**
+     * Explicitly stating that we use default c'tor, d'tor and assignment operator
+     *
+     */
+    RawIterator(const RawIterator&) = default;
+    ~RawIterator() = default;
+    RawIterator& operator=(const RawIterator&) = default;
+
+    /**
+     * @brief class for invalid operations done on iterator, thrown in following functions:
+     *
+     *  operator* when trying to dereference an element that's past the end
+     *  operator++(prefix and postfix) when trying to increment an iterator that's past the end
+     *  with QUEUE_UNCHECKED_ITERATORS these are assertions instead
+     */
+    class InvalidOperation {};
+
+    /**
+     * @brief Returns a reference to the data the iterator currently points to
+     *
+     * @return
+     *      reference if Iterator
+     *      const reference if ConstIterator
+     */
+    Modified_Type& operator*() const
+    {
+        this->checkNotEnd();
+        return *m_currentChunk->slot(m_index);
+    }
+
+    /**
+     * @brief Returns a pointer to the data the iterator currently points to
+     *
+     * @return
+     *      pointer if Iterator
+     *      const pointer if ConstIterator
+     */
+    Modified_Type* operator->() const
+    {
+        return &**this;
+    }
+
+    /**
+     * @brief Prefix incrementing the Iterator, making it point to the next object
+     *
+     * @return - Iterator after the increment
+     */
+    RawIterator& operator++()
+    {
+        this->checkNotEnd();
+        this->advance();
+        return *this;
+    }
+
+    /**
+     * @brief Postfix incrementing the Iterator, making it point to the next object
+     *
+     * @return - Iterator before the increment
+     */
+    RawIterator operator++(int)
+    {
+        this->checkNotEnd();
+        RawIterator result = *this;
+        this->advance();
+        return result;
+    }
+
+    /**
+     * @brief Checks if 2 Iterators point to the same element
+     *
+     * @param other - Iterator to compare to
+     * @return true if Iterators point to the same element
+     * @return false if Iterators point to a different element
+     */
+    bool operator==(const RawIterator& other) const
+    {
+        return m_currentChunk == other.m_currentChunk && m_index == other.m_index;
+    }
+
+    /**
+     * @brief Checks if 2 Iterators point to different elements
+     *
+     * @param other - Iterator to compare to
+     * @return true if Iterators point to a different element
+     * @return false if Iterators point to the same element
+     */
+    bool operator!=(const RawIterator& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+#endif
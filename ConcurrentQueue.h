@@ -0,0 +1,271 @@
+#ifndef CONCURRENT_QUEUE_H
+#define CONCURRENT_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "CacheLine.h"
+#include "HazardPointers.h"
+#include "QueueStats.h"
+
+/* ConcurrentQueue:
+ *      Lock-free unbounded queue for any amount of producer and consumer threads (Michael & Scott)
+ *      the node chain always starts with a dummy node, m_head points to it and m_tail to the last node
+ *      a push links its node after the last node with a CAS and then swings m_tail,
+ *      a pop swings m_head to the node after the dummy, which becomes the new dummy,
+ *      and the thread whose CAS won moves the element out of it
+ *      a thread that sees m_tail lagging behind helps advance it, so no thread ever waits for another
+ *      popped dummies are reclaimed through HazardPointers, never while another thread may still read them
+ *
+ *      Stats - policy counting the operations (QueueStats.h), AtomicQueueStats is the one safe to share,
+ *      NoStats compiles every hook away
+ *
+ *  copying and moving are disabled, the queue is meant to be shared by address
+ */
+template <class T, class Stats = NoStats>
+class ConcurrentQueue : private Stats {
+private:
+
+    //private node struct of the chain, the element is constructed in place and only the winning pop touches it
+    struct Node {
+        std::atomic<Node*> next; //pointer to next node
+        alignas(T) unsigned char storage[sizeof(T)]; //raw storage of the element, empty in the dummy
+
+        //C'tor of a node, makes a node without an element that points to nullptr
+        Node() :
+            next(nullptr)
+        { }
+
+        //returns the element stored in the node
+        T* value() noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    //hazard slots used by the operations of the queue
+    static constexpr std::size_t HAZARD_FIRST = 0;
+    static constexpr std::size_t HAZARD_NEXT = 1;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<Node*> m_head; //dummy node, written by consumers
+    alignas(CACHE_LINE_SIZE) std::atomic<Node*> m_tail; //last node or lagging behind it, written by producers
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_size; //approximate size, updated after the fact
+
+    //links a node that already holds its element
+    void link(Node* node);
+
+    //deleter handed to HazardPointers for retired nodes
+    static void deleteNode(void* node);
+
+    //stats policy the operations report to
+    Stats& counters() noexcept
+    {
+        return *this;
+    }
+
+public:
+
+    /**
+     * @brief Construct a new empty ConcurrentQueue
+     *
+     */
+    ConcurrentQueue();
+
+    /**
+     * @brief Destroys the ConcurrentQueue and every element left in it
+     *      must not run concurrently with any other function
+     *
+     */
+    ~ConcurrentQueue();
+
+    ConcurrentQueue(const ConcurrentQueue&) = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
+    /**
+     * @brief Inserts in the back of the queue
+     *
+     * @param val - value to be inserted
+     * @return - true, the queue is unbounded
+     */
+    bool tryPush(const T& val);
+
+    /**
+     * @brief Moves a value into the back of the queue
+     *
+     * @param val - value to be moved into the queue
+     * @return - true, the queue is unbounded
+     */
+    bool tryPush(T&& val);
+
+    /**
+     * @brief Constructs a new element in place in the back of the queue
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     * @return - true, the queue is unbounded
+     */
+    template<typename... Args>
+    bool tryEmplace(Args&&... args);
+
+    /**
+     * @brief Moves the front element into out and pops it
+     *
+     * @param out - receives the front element, untouched if the queue is empty
+     * @return true if an element was popped
+     * @return false if the queue was empty
+     */
+    bool tryPop(T& out);
+
+    /**
+     * @brief Returns the amount of elements in the queue
+     *      pushes and pops update the counter after they took effect,
+     *      so under concurrent use the result is only an approximation
+     *
+     * @return - approximate amount of elements in the queue
+     */
+    std::size_t approximateSize() const;
+
+    /**
+     * @brief Returns the counters of the stats policy, all zero with NoStats
+     *      the high-water mark is taken from the approximate size
+     *
+     * @return - pushes, pops, empty pops, high-water mark and allocations so far
+     */
+    QueueStatsSnapshot stats() const;
+};
+
+template<typename T, typename Stats>
+ConcurrentQueue<T, Stats>::ConcurrentQueue() :
+    m_head(new Node()),
+    m_tail(m_head.load(std::memory_order_relaxed)),
+    m_size(0)
+{ }
+
+template<typename T, typename Stats>
+ConcurrentQueue<T, Stats>::~ConcurrentQueue()
+{
+    Node* node = m_head.load(std::memory_order_relaxed);
+    Node* next = node->next.load(std::memory_order_relaxed);
+    delete node; //the dummy holds no element
+    while(next != nullptr){
+        node = next;
+        next = node->next.load(std::memory_order_relaxed);
+        node->value()->~T();
+        delete node;
+    }
+}
+
+template<typename T, typename Stats>
+bool ConcurrentQueue<T, Stats>::tryPush(const T& val)
+{
+    return this->tryEmplace(val);
+}
+
+template<typename T, typename Stats>
+bool ConcurrentQueue<T, Stats>::tryPush(T&& val)
+{
+    return this->tryEmplace(std::move(val));
+}
+
+template<typename T, typename Stats>
+template<typename... Args>
+bool ConcurrentQueue<T, Stats>::tryEmplace(Args&&... args)
+{
+    Node* node = new Node();
+    this->counters().onAllocate(1);
+    try{
+        ::new (static_cast<void*>(node->storage)) T(std::forward<Args>(args)...);
+    } catch(...){ //c'tor of T failed, the node was never visible
+        delete node;
+        throw;
+    }
+    this->link(node);
+    return true;
+}
+
+template<typename T, typename Stats>
+void ConcurrentQueue<T, Stats>::link(Node* node)
+{
+    while(true){
+        Node* tail = HazardPointers::protect(HAZARD_FIRST, m_tail);
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if(tail != m_tail.load()){ //tail moved on while reading its next
+            continue;
+        }
+        if(next != nullptr){ //m_tail is lagging, helping the push that linked next
+            m_tail.compare_exchange_weak(tail, next);
+            continue;
+        }
+        if(tail->next.compare_exchange_weak(next, node, std::memory_order_release, std::memory_order_relaxed)){
+            m_tail.compare_exchange_strong(tail, node); //may fail if another thread already helped
+            break;
+        }
+    }
+    HazardPointers::clear();
+    std::size_t size = m_size.fetch_add(1, std::memory_order_relaxed) + 1;
+    this->counters().onPush(1, size > static_cast<std::size_t>(-1) / 2 ? 0 : size);
+}
+
+template<typename T, typename Stats>
+bool ConcurrentQueue<T, Stats>::tryPop(T& out)
+{
+    while(true){
+        Node* head = HazardPointers::protect(HAZARD_FIRST, m_head);
+        Node* tail = m_tail.load();
+        Node* next = head->next.load(std::memory_order_acquire);
+        HazardPointers::set(HAZARD_NEXT, next);
+        if(head != m_head.load()){ //head was popped meanwhile, next may already be reclaimed
+            continue;
+        }
+        if(next == nullptr){ //only the dummy is left
+            HazardPointers::clear();
+            this->counters().onEmptyPop();
+            return false;
+        }
+        if(head == tail){ //m_tail is lagging behind a linked node, helping it before popping
+            m_tail.compare_exchange_weak(tail, next);
+            continue;
+        }
+        if(m_head.compare_exchange_weak(head, next)){
+            //next is the new dummy, only this thread may touch its element
+            T* value = next->value();
+            try{
+                out = std::move(*value);
+            } catch(...){ //the element is already unlinked, it is destroyed either way
+                value->~T();
+                HazardPointers::clear();
+                HazardPointers::retire(head, &ConcurrentQueue::deleteNode);
+                m_size.fetch_sub(1, std::memory_order_relaxed);
+                this->counters().onPop(1);
+                throw;
+            }
+            value->~T();
+            HazardPointers::clear();
+            HazardPointers::retire(head, &ConcurrentQueue::deleteNode);
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            this->counters().onPop(1);
+            return true;
+        }
+    }
+}
+
+template<typename T, typename Stats>
+std::size_t ConcurrentQueue<T, Stats>::approximateSize() const
+{
+    std::size_t size = m_size.load(std::memory_order_relaxed);
+    return size > static_cast<std::size_t>(-1) / 2 ? 0 : size; //a pop may be counted before its push
+}
+
+template<typename T, typename Stats>
+QueueStatsSnapshot ConcurrentQueue<T, Stats>::stats() const
+{
+    return Stats::snapshot();
+}
+
+template<typename T, typename Stats>
+void ConcurrentQueue<T, Stats>::deleteNode(void* node)
+{
+    delete static_cast<Node*>(node);
+}
+
+#endif
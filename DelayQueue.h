@@ -0,0 +1,479 @@
+#ifndef DELAY_QUEUE_H
+#define DELAY_QUEUE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+/* DelayQueue:
+ *      Queue whose elements carry a ready time, tryPop only hands out elements whose time has come
+ *      pending elements are kept in a hierarchical timing wheel of LEVELS wheels of SLOTS slots:
+ *      time is counted in ticks of a fixed resolution, level l holds the elements that are due within
+ *      the current rotation of level l + 1, in the slot of their tick's l-th byte
+ *      a push links its node into one slot in O(1), whatever the amount of pending elements
+ *      advancing time expires the slots of level 0 it passes, and whenever a level's index wraps the next
+ *      slot of the level above is cascaded: its elements are linked again, into a lower level or as due
+ *      every element is cascaded at most LEVELS - 1 times, so expiry is O(1) per element
+ *      occupancy bitmaps find the next occupied slot of every level, advancing jumps straight to it,
+ *      so time passing over empty slots costs nothing
+ *      due elements wait in a FIFO list, in the order of their ticks
+ *
+ *  ready times are rounded up to the next tick, an element is never handed out early
+ *  elements further away than SLOTS^LEVELS ticks are parked in the farthest slot and cascaded until in range
+ *  for a delay queue consumers can sleep on, see BlockingDelayQueue
+ *
+ * @tparam T - type of the elements
+ * @tparam Clock - clock of the ready times
+ * @tparam Alloc - allocator, rebound to allocate the nodes
+ */
+template <class T, class Clock = std::chrono::steady_clock, class Alloc = std::allocator<T>>
+class DelayQueue {
+public:
+    typedef typename Clock::time_point TimePoint;
+    typedef typename Clock::duration Duration;
+
+private:
+
+    //private node struct of the wheel, an element and the tick it is due at
+    struct Node {
+        T data; //data stored inside the node
+        std::uint64_t tick; //first tick at which the element is due
+        Node* next; //pointer to next node of the same slot
+
+        //C'tor of a node, constructs the data in place from the given arguments and points to nullptr
+        template<typename... Args>
+        explicit Node(std::uint64_t due, Args&&... args) :
+            data(std::forward<Args>(args)...),
+            tick(due),
+            next(nullptr)
+        { }
+    };
+
+    //list of the nodes of one slot, in insertion order
+    struct Slot {
+        Node* front; //first node, nullptr if the slot is empty
+        Node* rear; //last node
+    };
+
+    static constexpr unsigned LEVEL_BITS = 8;
+    static constexpr std::size_t SLOTS = std::size_t(1) << LEVEL_BITS; //slots of every level
+    static constexpr unsigned LEVELS = 4; //levels of the wheel, together they cover SLOTS^LEVELS ticks
+    static constexpr std::size_t WORDS = SLOTS / 64; //words of an occupancy bitmap
+
+    //allocator of nodes, rebound from Alloc
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Node> NodeAllocator;
+    typedef std::allocator_traits<NodeAllocator> NodeTraits;
+
+    NodeAllocator m_alloc; //allocates and frees every node of the queue
+    Slot m_slots[LEVELS][SLOTS]; //the wheels
+    std::uint64_t m_occupied[LEVELS][WORDS]; //bit s of level l is set while m_slots[l][s] isn't empty
+    Slot m_ready; //due elements, not handed out yet
+    TimePoint m_epoch; //time of tick 0
+    Duration m_resolution; //length of a tick
+    std::uint64_t m_now; //last tick the wheel was advanced to
+    std::size_t m_size; //amount of elements, due and pending
+    std::size_t m_pending; //amount of elements in the wheel
+
+    //allocates a node through m_alloc and constructs it from args
+    template<typename... Args>
+    Node* createNode(Args&&... args);
+
+    //destroys the data of a node and returns it to m_alloc
+    void destroyNode(Node* node) noexcept;
+
+    //links a node into the slot its tick belongs to relative to m_now, or into m_ready if it is due
+    void place(Node* node) noexcept;
+
+    //moves time forward to tick, expiring and cascading every slot on the way
+    void advance(std::uint64_t tick) noexcept;
+
+    //returns the tick at which the next occupied slot is expired or cascaded, the wheel isn't empty
+    std::uint64_t nextEvent() const noexcept;
+
+    //relinks the nodes of a slot of a higher level relative to m_now
+    void cascade(unsigned level, std::size_t slot) noexcept;
+
+    //moves the nodes of a level 0 slot to m_ready
+    void expire(std::size_t slot) noexcept;
+
+    //returns the first tick at or after which the element is due, never earlier than time
+    std::uint64_t dueTick(const TimePoint& time) const;
+
+    //returns the last tick that started at or before time
+    std::uint64_t tickOf(const TimePoint& time) const;
+
+    //returns the first occupied slot of a level at index from or after it, SLOTS if there is none
+    std::size_t nextOccupied(unsigned level, std::size_t from) const noexcept;
+
+    //returns the index of the lowest set bit, bits must not be 0
+    static unsigned lowestBit(std::uint64_t bits) noexcept;
+
+    //appends a node to a slot list
+    static void append(Slot& slot, Node* node) noexcept;
+
+public:
+
+    /**
+     * @brief Construct a new empty DelayQueue
+     *
+     * @param resolution - length of a tick, ready times are rounded up to it
+     * @param start - time of tick 0, ready times before it are due immediately
+     * @param alloc - allocator of the nodes
+     */
+    explicit DelayQueue(Duration resolution = std::chrono::milliseconds(1), TimePoint start = Clock::now(),
+                        const Alloc& alloc = Alloc());
+
+    /**
+     * @brief Destroys the DelayQueue and every element in it, due or not
+     *
+     */
+    ~DelayQueue();
+
+    DelayQueue(const DelayQueue&) = delete;
+    DelayQueue& operator=(const DelayQueue&) = delete;
+
+    /**
+     * @brief Inserts an element that becomes due at readyAt
+     *
+     * @param val - value to be inserted
+     * @param readyAt - time from which tryPop may hand the element out
+     */
+    void pushBack(const T& val, const TimePoint& readyAt);
+
+    /**
+     * @brief Moves an element into the queue that becomes due at readyAt
+     *
+     * @param val - value to be moved into the queue
+     * @param readyAt - time from which tryPop may hand the element out
+     */
+    void pushBack(T&& val, const TimePoint& readyAt);
+
+    /**
+     * @brief Constructs a new element in place that becomes due at readyAt
+     *
+     * @param readyAt - time from which tryPop may hand the element out
+     * @param args - arguments forwarded to the c'tor of T
+     */
+    template<typename... Args>
+    void emplaceBack(const TimePoint& readyAt, Args&&... args);
+
+    /**
+     * @brief Moves the first due element out of the queue and pops it
+     *
+     * @param now - current time, the queue never goes back in time: an earlier now than before counts as the same
+     * @return - the element, or an empty optional if no element is due at now
+     */
+    std::optional<T> tryPop(const TimePoint& now = Clock::now());
+
+    /**
+     * @brief Returns a time by which the next element may be due, for a consumer to sleep until
+     *      never later than the ready time of the next element, but possibly earlier:
+     *      an element more than one level 0 rotation away is only located to the slot of its level,
+     *      waking up there and asking again finds it more precisely
+     *
+     * @return - time to wait until, in the past if an element is due, empty if the queue is empty
+     */
+    std::optional<TimePoint> nextWakeup() const;
+
+    /**
+     * @brief Checks if the queue is empty
+     *
+     * @return true if the queue holds no elements, due or not
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns the size of the queue
+     *
+     * @return - amount of elements, due or not
+     */
+    std::size_t size() const;
+};
+
+template<typename T, typename Clock, typename Alloc>
+DelayQueue<T, Clock, Alloc>::DelayQueue(Duration resolution, TimePoint start, const Alloc& alloc) :
+    m_alloc(alloc),
+    m_slots(),
+    m_occupied(),
+    m_ready{nullptr, nullptr},
+    m_epoch(start),
+    m_resolution(resolution > Duration::zero() ? resolution : Duration(1)),
+    m_now(0),
+    m_size(0),
+    m_pending(0)
+{ }
+
+template<typename T, typename Clock, typename Alloc>
+DelayQueue<T, Clock, Alloc>::~DelayQueue()
+{
+    for(unsigned level = 0; level < LEVELS; level++){
+        for(Slot& slot : m_slots[level]){
+            while(slot.front != nullptr){
+                Node* temp = slot.front;
+                slot.front = slot.front->next;
+                this->destroyNode(temp);
+            }
+        }
+    }
+    while(m_ready.front != nullptr){
+        Node* temp = m_ready.front;
+        m_ready.front = m_ready.front->next;
+        this->destroyNode(temp);
+    }
+}
+
+template<typename T, typename Clock, typename Alloc>
+void DelayQueue<T, Clock, Alloc>::pushBack(const T& val, const TimePoint& readyAt)
+{
+    this->emplaceBack(readyAt, val);
+}
+
+template<typename T, typename Clock, typename Alloc>
+void DelayQueue<T, Clock, Alloc>::pushBack(T&& val, const TimePoint& readyAt)
+{
+    this->emplaceBack(readyAt, std::move(val));
+}
+
+template<typename T, typename Clock, typename Alloc>
+template<typename... Args>
+void DelayQueue<T, Clock, Alloc>::emplaceBack(const TimePoint& readyAt, Args&&... args)
+{
+    Node* node = this->createNode(this->dueTick(readyAt), std::forward<Args>(args)...);
+    this->place(node);
+    m_size++;
+}
+
+template<typename T, typename Clock, typename Alloc>
+std::optional<T> DelayQueue<T, Clock, Alloc>::tryPop(const TimePoint& now)
+{
+    this->advance(this->tickOf(now));
+    if(m_ready.front == nullptr){
+        return std::nullopt;
+    }
+    Node* node = m_ready.front;
+    std::optional<T> result(std::move(node->data));
+    m_ready.front = node->next;
+    this->destroyNode(node);
+    m_size--;
+    return result;
+}
+
+template<typename T, typename Clock, typename Alloc>
+std::optional<typename DelayQueue<T, Clock, Alloc>::TimePoint> DelayQueue<T, Clock, Alloc>::nextWakeup() const
+{
+    if(m_size == 0){
+        return std::nullopt;
+    }
+    if(m_ready.front != nullptr){
+        return m_epoch + m_resolution * static_cast<typename Duration::rep>(m_now);
+    }
+
+    return m_epoch + m_resolution * static_cast<typename Duration::rep>(this->nextEvent());
+}
+
+template<typename T, typename Clock, typename Alloc>
+bool DelayQueue<T, Clock, Alloc>::empty() const
+{
+    return m_size == 0;
+}
+
+template<typename T, typename Clock, typename Alloc>
+std::size_t DelayQueue<T, Clock, Alloc>::size() const
+{
+    return m_size;
+}
+
+template<typename T, typename Clock, typename Alloc>
+template<typename... Args>
+typename DelayQueue<T, Clock, Alloc>::Node* DelayQueue<T, Clock, Alloc>::createNode(Args&&... args)
+{
+    Node* node = NodeTraits::allocate(m_alloc, 1);
+    try{
+        NodeTraits::construct(m_alloc, node, std::forward<Args>(args)...);
+    } catch(...){ //c'tor of T failed, the storage goes back to the allocator
+        NodeTraits::deallocate(m_alloc, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template<typename T, typename Clock, typename Alloc>
+void DelayQueue<T, Clock, Alloc>::destroyNode(Node* node) noexcept
+{
+    NodeTraits::destroy(m_alloc, node);
+    NodeTraits::deallocate(m_alloc, node, 1);
+}
+
+template<typename T, typename Clock, typename Alloc>
+void DelayQueue<T, Clock, Alloc>::place(Node* node) noexcept
+{
+    node->next = nullptr;
+    if(node->tick <= m_now){
+        append(m_ready, node);
+        return;
+    }
+
+    //lowest level whose current rotation the tick falls in, the top level takes the rest
+    unsigned level = 0;
+    while(level < LEVELS - 1 && (node->tick >> (LEVEL_BITS * (level + 1))) != (m_now >> (LEVEL_BITS * (level + 1)))){
+        level++;
+    }
+    unsigned shift = LEVEL_BITS * level;
+    std::size_t slot;
+    if(level == LEVELS - 1 && node->tick - m_now >= (std::uint64_t(1) << (LEVEL_BITS * LEVELS))){
+        //out of range, parked in the top slot visited last, less than SLOTS^LEVELS ticks from now
+        slot = static_cast<std::size_t>((m_now >> shift) + SLOTS - 1) & (SLOTS - 1);
+    }
+    else{
+        slot = static_cast<std::size_t>(node->tick >> shift) & (SLOTS - 1);
+    }
+    append(m_slots[level][slot], node);
+    m_occupied[level][slot / 64] |= std::uint64_t(1) << (slot % 64);
+    m_pending++;
+}
+
+template<typename T, typename Clock, typename Alloc>
+void DelayQueue<T, Clock, Alloc>::advance(std::uint64_t tick) noexcept
+{
+    while(m_now < tick){
+        std::uint64_t event = m_pending == 0 ? tick : this->nextEvent();
+        if(event >= tick){ //nothing to expire or cascade before tick
+            event = tick;
+        }
+        m_now = event; //the empty slots on the way are skipped, they have nothing to move
+
+        //wrapping levels cascade from the top down, their elements may land in the slots processed after them
+        for(unsigned level = LEVELS - 1; level > 0; level--){
+            if((m_now & ((std::uint64_t(1) << (LEVEL_BITS * level)) - 1)) == 0){
+                this->cascade(level, static_cast<std::size_t>(m_now >> (LEVEL_BITS * level)) & (SLOTS - 1));
+            }
+        }
+        this->expire(static_cast<std::size_t>(m_now) & (SLOTS - 1));
+    }
+}
+
+template<typename T, typename Clock, typename Alloc>
+std::uint64_t DelayQueue<T, Clock, Alloc>::nextEvent() const noexcept
+{
+    std::uint64_t best = static_cast<std::uint64_t>(-1);
+    for(unsigned level = 0; level < LEVELS; level++){
+        unsigned shift = LEVEL_BITS * level;
+        std::size_t index = static_cast<std::size_t>(m_now >> shift) & (SLOTS - 1);
+        std::uint64_t rotation = (m_now >> (shift + LEVEL_BITS)) << (shift + LEVEL_BITS); //first tick of this rotation
+        std::size_t slot = this->nextOccupied(level, index + 1);
+        if(slot == SLOTS && level == LEVELS - 1){ //the top level also holds elements of its next rotation
+            slot = this->nextOccupied(level, 0);
+            rotation += std::uint64_t(1) << (shift + LEVEL_BITS);
+        }
+        if(slot != SLOTS){ //the slot's elements are due or cascaded at this tick
+            std::uint64_t tick = rotation + (static_cast<std::uint64_t>(slot) << shift);
+            best = tick < best ? tick : best;
+        }
+    }
+    return best;
+}
+
+template<typename T, typename Clock, typename Alloc>
+void DelayQueue<T, Clock, Alloc>::cascade(unsigned level, std::size_t slot) noexcept
+{
+    Node* node = m_slots[level][slot].front;
+    m_slots[level][slot].front = nullptr;
+    m_slots[level][slot].rear = nullptr;
+    m_occupied[level][slot / 64] &= ~(std::uint64_t(1) << (slot % 64));
+    while(node != nullptr){
+        Node* next = node->next; //place resets node->next
+        m_pending--;
+        this->place(node);
+        node = next;
+    }
+}
+
+template<typename T, typename Clock, typename Alloc>
+void DelayQueue<T, Clock, Alloc>::expire(std::size_t slot) noexcept
+{
+    Slot& expired = m_slots[0][slot];
+    if(expired.front == nullptr){
+        return;
+    }
+    std::size_t count = 0;
+    for(Node* node = expired.front; node != nullptr; node = node->next){
+        count++;
+    }
+    if(m_ready.front == nullptr){ //the whole slot list is linked at once
+        m_ready = expired;
+    }
+    else{
+        m_ready.rear->next = expired.front;
+        m_ready.rear = expired.rear;
+    }
+    expired.front = nullptr;
+    expired.rear = nullptr;
+    m_occupied[0][slot / 64] &= ~(std::uint64_t(1) << (slot % 64));
+    m_pending -= count;
+}
+
+template<typename T, typename Clock, typename Alloc>
+std::uint64_t DelayQueue<T, Clock, Alloc>::dueTick(const TimePoint& time) const
+{
+    if(time <= m_epoch){
+        return 0;
+    }
+    Duration elapsed = time - m_epoch;
+    return static_cast<std::uint64_t>((elapsed + m_resolution - Duration(1)) / m_resolution);
+}
+
+template<typename T, typename Clock, typename Alloc>
+std::uint64_t DelayQueue<T, Clock, Alloc>::tickOf(const TimePoint& time) const
+{
+    if(time <= m_epoch){
+        return 0;
+    }
+    return static_cast<std::uint64_t>((time - m_epoch) / m_resolution);
+}
+
+template<typename T, typename Clock, typename Alloc>
+std::size_t DelayQueue<T, Clock, Alloc>::nextOccupied(unsigned level, std::size_t from) const noexcept
+{
+    for(std::size_t word = from / 64; word < WORDS; word++){
+        std::uint64_t bits = m_occupied[level][word];
+        if(word == from / 64){ //ignoring the slots before from
+            bits &= ~std::uint64_t(0) << (from % 64);
+        }
+        if(bits != 0){
+            return word * 64 + lowestBit(bits);
+        }
+    }
+    return SLOTS;
+}
+
+template<typename T, typename Clock, typename Alloc>
+unsigned DelayQueue<T, Clock, Alloc>::lowestBit(std::uint64_t bits) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+    unsigned index = 0;
+    while((bits & 1) == 0){
+        bits >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+template<typename T, typename Clock, typename Alloc>
+void DelayQueue<T, Clock, Alloc>::append(Slot& slot, Node* node) noexcept
+{
+    if(slot.front == nullptr){
+        slot.front = node;
+    }
+    else{
+        slot.rear->next = node;
+    }
+    slot.rear = node;
+}
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef HAZARD_POINTERS_H
+#define HAZARD_POINTERS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/* HazardPointers:
+ *      Safe memory reclamation for lock-free node based containers
+ *      a thread announces the nodes it is about to dereference in its hazard slots,
+ *      a node that was unlinked is retired instead of deleted,
+ *      and is only deleted once no hazard slot of any thread points to it
+ *
+ *  every thread gets SLOTS hazard slots on its first use, they are returned when the thread exits
+ *  retired nodes are kept per thread and scanned once enough of them piled up,
+ *  nodes still protected when their thread exits are handed over to the next scan of another thread
+ */
+class HazardPointers {
+public:
+
+    //amount of hazard slots every thread owns
+    static constexpr std::size_t SLOTS = 2;
+
+    /**
+     * @brief Loads source and protects the loaded pointer with the given hazard slot of the calling thread
+     *      once this returns, the pointed node can't be deleted until the slot is cleared or reassigned
+     *
+     * @param index - hazard slot to use, smaller than SLOTS
+     * @param source - atomic pointer to load
+     * @return - protected value of source
+     */
+    template<typename Node>
+    static Node* protect(std::size_t index, const std::atomic<Node*>& source)
+    {
+        std::atomic<void*>& slot = local().record->slots[index];
+        Node* ptr = source.load();
+        while(true){ //the value is protected only if it is still in source after the slot was published
+            slot.store(ptr);
+            Node* again = source.load();
+            if(again == ptr){
+                return ptr;
+            }
+            ptr = again;
+        }
+    }
+
+    /**
+     * @brief Publishes ptr in the given hazard slot of the calling thread
+     *      the caller has to make sure ptr is still reachable after this call before dereferencing it
+     *
+     * @param index - hazard slot to use, smaller than SLOTS
+     * @param ptr - pointer to protect
+     */
+    static void set(std::size_t index, void* ptr)
+    {
+        local().record->slots[index].store(ptr);
+    }
+
+    /**
+     * @brief Clears every hazard slot of the calling thread
+     *
+     */
+    static void clear()
+    {
+        HazardRecord* record = local().record;
+        for(std::size_t i = 0; i < SLOTS; i++){
+            record->slots[i].store(nullptr, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Hands an unlinked node over for deletion once no thread protects it
+     *
+     * @param ptr - node that is no longer reachable from the container
+     * @param deleter - function that deletes the node
+     */
+    static void retire(void* ptr, void (*deleter)(void*))
+    {
+        ThreadState& state = local();
+        state.retired.push_back(Retired{ptr, deleter});
+        if(state.retired.size() >= domain().scanThreshold()){
+            domain().scan(state.retired);
+        }
+    }
+
+private:
+    //hazard slots of a single thread, records are never freed until the program ends, only reused
+    struct HazardRecord {
+        std::atomic<void*> slots[SLOTS];
+        std::atomic<bool> active; //true while a thread owns the record
+        HazardRecord* next; //next record in the domain, immutable once linked
+
+        HazardRecord() :
+            slots(),
+            active(true),
+            next(nullptr)
+        { }
+    };
+
+    //a retired node waiting for deletion
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    //every hazard record of the program and the nodes orphaned by exited threads
+    class Domain {
+    public:
+        Domain() :
+            m_records(nullptr),
+            m_recordCount(0)
+        { }
+
+        ~Domain()
+        {
+            for(Retired& retired : m_orphans){ //no thread is left to protect anything
+                retired.deleter(retired.ptr);
+            }
+            HazardRecord* record = m_records.load();
+            while(record != nullptr){
+                HazardRecord* temp = record;
+                record = record->next;
+                delete temp;
+            }
+        }
+
+        //reuses an inactive record or links a new one
+        HazardRecord* acquire()
+        {
+            for(HazardRecord* record = m_records.load(); record != nullptr; record = record->next){
+                bool inactive = false;
+                if(!record->active.load(std::memory_order_relaxed) &&
+                   record->active.compare_exchange_strong(inactive, true)){
+                    return record;
+                }
+            }
+            HazardRecord* record = new HazardRecord();
+            HazardRecord* head = m_records.load();
+            do{
+                record->next = head;
+            } while(!m_records.compare_exchange_weak(head, record));
+            m_recordCount.fetch_add(1, std::memory_order_relaxed);
+            return record;
+        }
+
+        //clears the slots of a record and makes it available for another thread
+        void release(HazardRecord* record)
+        {
+            for(std::size_t i = 0; i < SLOTS; i++){
+                record->slots[i].store(nullptr);
+            }
+            record->active.store(false, std::memory_order_release);
+        }
+
+        //deletes every node of retired that no hazard slot points to, the rest stays in retired
+        void scan(std::vector<Retired>& retired)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_orphanMutex); //adopting nodes left by exited threads
+                retired.insert(retired.end(), m_orphans.begin(), m_orphans.end());
+                m_orphans.clear();
+            }
+
+            std::vector<void*> hazards;
+            for(HazardRecord* record = m_records.load(); record != nullptr; record = record->next){
+                for(std::size_t i = 0; i < SLOTS; i++){
+                    void* hazard = record->slots[i].load();
+                    if(hazard != nullptr){
+                        hazards.push_back(hazard);
+                    }
+                }
+            }
+            std::sort(hazards.begin(), hazards.end());
+
+            std::size_t kept = 0;
+            for(std::size_t i = 0; i < retired.size(); i++){
+                if(std::binary_search(hazards.begin(), hazards.end(), retired[i].ptr)){
+                    retired[kept++] = retired[i];
+                }
+                else{
+                    retired[i].deleter(retired[i].ptr);
+                }
+            }
+            retired.resize(kept);
+        }
+
+        //takes over the nodes an exiting thread couldn't delete yet
+        void orphan(std::vector<Retired>& retired)
+        {
+            std::lock_guard<std::mutex> lock(m_orphanMutex);
+            m_orphans.insert(m_orphans.end(), retired.begin(), retired.end());
+            retired.clear();
+        }
+
+        //amount of retired nodes a thread collects before scanning, proportional to the amount of slots
+        std::size_t scanThreshold() const
+        {
+            std::size_t threshold = 2 * SLOTS * m_recordCount.load(std::memory_order_relaxed);
+            return threshold < 64 ? 64 : threshold;
+        }
+
+    private:
+        std::atomic<HazardRecord*> m_records; //lock-free list of every record ever acquired
+        std::atomic<std::size_t> m_recordCount; //amount of records in m_records
+        std::mutex m_orphanMutex; //protects m_orphans
+        std::vector<Retired> m_orphans; //retired nodes of exited threads
+    };
+
+    //per thread state, returns the record and scans the retired nodes when the thread exits
+    struct ThreadState {
+        HazardRecord* record;
+        std::vector<Retired> retired;
+
+        ThreadState() :
+            record(domain().acquire())
+        { }
+
+        ~ThreadState()
+        {
+            domain().release(record);
+            domain().scan(retired);
+            if(!retired.empty()){
+                domain().orphan(retired);
+            }
+        }
+    };
+
+    static Domain& domain()
+    {
+        static Domain instance; //constructed before the first ThreadState, so destroyed after all of them
+        return instance;
+    }
+
+    static ThreadState& local()
+    {
+        thread_local ThreadState state;
+        return state;
+    }
+};
+
+#endif
@@ -0,0 +1,494 @@
+#ifndef MAPPED_QUEUE_H
+#define MAPPED_QUEUE_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* MappedQueue:
+ *      Persistent bounded queue of trivially copyable elements, stored in a memory mapped file
+ *      the file is a header (magic, element size, header size, capacity, head and tail positions)
+ *      padded to the page size of the system that created it, at least 4096 bytes,
+ *      followed by a power of 2 ring of element slots, so the queue is found again after a restart
+ *      the header records its own size, so the slots are found at the same offset whatever the page size
+ *      a new file is set up under path + ".tmp" and renamed to path once its header is written,
+ *      so a crash while creating it never leaves a file without a header behind
+ *      head and tail only grow, the amount of elements is tail - head and a slot is position & (capacity - 1)
+ *      a push writes its element before publishing the new tail and a pop only moves head,
+ *      so the file is consistent whenever the process stops, writing it back to disk is left to the kernel
+ *      for durability across power loss the queue msyncs every syncEvery modifications (0 never does)
+ *      and on sync(): the slots are flushed before the header, a synced header never points at unsynced slots
+ *
+ *  POSIX only (open, mmap, msync), a file is used by a single MappedQueue of a single process at a time
+ *  copying and moving are disabled, the queue owns the mapping
+ */
+template <class T>
+class MappedQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedQueue stores its elements as raw bytes");
+private:
+
+    //start of the file
+    struct Header {
+        std::uint32_t magic; //MAGIC once the file was set up
+        std::uint32_t version; //VERSION of the layout
+        std::uint64_t elementSize; //sizeof(T) of the queue that created the file
+        std::uint64_t headerSize; //bytes before the first slot, a power of 2 of at least MIN_HEADER_SIZE
+        std::uint64_t capacity; //amount of slots, a power of 2
+        std::uint64_t head; //position of the front element
+        std::uint64_t tail; //position beyond the rear element
+    };
+
+    //"MQUE" in little endian
+    static constexpr std::uint32_t MAGIC = 0x4555514D;
+    static constexpr std::uint32_t VERSION = 1;
+
+    //smallest header size, the page size of the common systems
+    static constexpr std::size_t MIN_HEADER_SIZE = 4096;
+
+    //biggest header size accepted from a file, larger than any page size
+    static constexpr std::size_t MAX_HEADER_SIZE = std::size_t(1) << 30;
+
+    int m_fd; //descriptor of the file
+    unsigned char* m_map; //whole file, the header page and then the slots
+    std::size_t m_mapSize; //amount of bytes mapped
+    std::size_t m_headerSize; //size of the header, the slots start there
+    bool m_splitSync; //the header has pages of its own, so the slots can be msynced before it
+    Header* m_header; //header at the start of m_map
+    T* m_slots; //ring of m_header->capacity slots
+    std::size_t m_mask; //capacity - 1
+    std::size_t m_syncEvery; //modifications between two msyncs, 0 leaves writing back to the kernel
+    std::size_t m_unsynced; //modifications since the last msync
+
+    //opens or creates the file and maps it, cleans up and throws FileError on failure
+    void open(const std::string& path, std::size_t capacity);
+
+    //creates a complete new file under a temporary name and renames it to path, header is filled in
+    void create(const std::string& path, std::size_t capacity, Header& header);
+
+    //checks the header of an existing file of the given amount of bytes
+    static bool valid(const Header& header, std::size_t bytes);
+
+    //amount of bytes the file of a header takes, the header and the slots rounded up to the header size
+    static std::size_t fileSize(const Header& header);
+
+    //unmaps and closes whatever open() set up so far
+    void release() noexcept;
+
+    //counts a modification and msyncs when m_syncEvery modifications piled up
+    void modified();
+
+    //rounds capacity up to a power of 2, at least 1
+    static std::size_t roundCapacity(std::size_t capacity);
+
+public:
+
+    /**
+     * @brief Opens the queue stored in a file, or creates the file with an empty queue if it doesn't exist
+     *
+     * @param path - file of the queue
+     * @param capacity - amount of elements a new file can hold, rounded up to a power of 2,
+     *      an existing file keeps the capacity it was created with
+     * @param syncEvery - amount of modifications after which the file is msynced, 0 never msyncs on its own
+     */
+    MappedQueue(const std::string& path, std::size_t capacity, std::size_t syncEvery = 0);
+
+    /**
+     * @brief Unmaps the file, msyncs it first unless syncEvery is 0
+     *      the elements stay in the file
+     *
+     */
+    ~MappedQueue();
+
+    MappedQueue(const MappedQueue&) = delete;
+    MappedQueue& operator=(const MappedQueue&) = delete;
+
+    /**
+     * @brief Inserts in the back of the MappedQueue if there is room
+     *
+     * @param val - value to be inserted
+     * @return true if the value was inserted
+     * @return false if the queue is full
+     */
+    bool tryPush(const T& val);
+
+    /**
+     * @brief Inserts in the back of the MappedQueue
+     *
+     * @param val - value to be inserted, throws FullQueue if the queue is full
+     */
+    void pushBack(const T& val);
+
+    /**
+     * @brief Constructs a new element in the back of the MappedQueue
+     *
+     * @param args - arguments forwarded to the c'tor of T, throws FullQueue if the queue is full
+     * @return - reference to the newly constructed element
+     */
+    template<typename... Args>
+    T& emplaceBack(Args&&... args);
+
+    /**
+     * @brief Returns a reference to the front of the queue, writes through it are stored in the file
+     *
+     * @return - reference to the data stored in the front
+     */
+    T& front();
+
+    /**
+     * @brief Returns a const reference to the front of the queue
+     *
+     * @return - const reference to the data stored in the front
+     */
+    const T& front() const;
+
+    /**
+     * @brief Pops the element in the front of the queue
+     *
+     */
+    void popFront();
+
+    /**
+     * @brief Returns a pointer to the front of the queue without throwing
+     *
+     * @return - pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    T* tryFront();
+
+    /**
+     * @brief Copies the front element out of the queue and pops it, without throwing on an empty queue
+     *
+     * @return - the front element, or an empty optional if the queue is empty
+     */
+    std::optional<T> tryPop();
+
+    /**
+     * @brief Checks if the queue is empty
+     *
+     * @return true if the queue holds no elements
+     */
+    bool empty() const;
+
+    /**
+     * @brief Checks if the queue is full
+     *
+     * @return true if the queue holds capacity() elements
+     */
+    bool full() const;
+
+    /**
+     * @brief Returns the size of the queue
+     *
+     * @return - size of the queue
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Returns the maximal amount of elements of the queue
+     *
+     * @return - capacity of the file
+     */
+    std::size_t capacity() const;
+
+    /**
+     * @brief Writes the file back to disk and waits for it (msync), whatever the sync policy is
+     *
+     */
+    void sync();
+
+    /**
+     * @brief Exception Class to deal with invalid operations done on an empty MappedQueue
+     *
+     *  Invalid operators on an empty MappedQueue:
+     *      front, popFront
+     */
+    class EmptyQueue {};
+
+    /**
+     * @brief Exception Class to deal with pushing into a full MappedQueue
+     *
+     *  Invalid operators on a full MappedQueue:
+     *      pushBack, emplaceBack
+     */
+    class FullQueue {};
+
+    /**
+     * @brief Exception Class to deal with a file that can't hold the queue
+     *
+     *  thrown by the c'tor when the file can't be opened, sized or mapped,
+     *  or holds a different layout or element size; thrown by sync when msync fails
+     */
+    class FileError {};
+};
+
+template<typename T>
+MappedQueue<T>::MappedQueue(const std::string& path, std::size_t capacity, std::size_t syncEvery) :
+    m_fd(-1),
+    m_map(nullptr),
+    m_mapSize(0),
+    m_headerSize(0),
+    m_splitSync(false),
+    m_header(nullptr),
+    m_slots(nullptr),
+    m_mask(0),
+    m_syncEvery(syncEvery),
+    m_unsynced(0)
+{
+    this->open(path, capacity);
+}
+
+template<typename T>
+MappedQueue<T>::~MappedQueue()
+{
+    if(m_syncEvery != 0 && m_unsynced != 0){
+        try{
+            this->sync();
+        } catch(...){ //the data is still in the page cache, the kernel writes it back later
+        }
+    }
+    this->release();
+}
+
+template<typename T>
+void MappedQueue<T>::open(const std::string& path, std::size_t capacity)
+{
+    static_assert(sizeof(Header) <= MIN_HEADER_SIZE, "the header has to fit in MIN_HEADER_SIZE");
+    static_assert(alignof(T) <= MIN_HEADER_SIZE, "the slots start at a multiple of MIN_HEADER_SIZE");
+
+    Header header;
+    m_fd = ::open(path.c_str(), O_RDWR);
+    if(m_fd >= 0){ //existing file, its header decides the layout
+        struct stat info;
+        if(fstat(m_fd, &info) != 0 ||
+           pread(m_fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+           !valid(header, static_cast<std::size_t>(info.st_size))){
+            this->release();
+            throw FileError();
+        }
+    }
+    else if(errno == ENOENT){
+        this->create(path, capacity, header);
+    }
+    else{
+        throw FileError();
+    }
+
+    m_headerSize = static_cast<std::size_t>(header.headerSize);
+    m_mapSize = fileSize(header);
+    long page = sysconf(_SC_PAGESIZE);
+    m_splitSync = page > 0 && m_headerSize % static_cast<std::size_t>(page) == 0;
+    void* map = mmap(nullptr, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if(map == MAP_FAILED){
+        this->release();
+        throw FileError();
+    }
+
+    m_map = static_cast<unsigned char*>(map);
+    m_header = static_cast<Header*>(static_cast<void*>(m_map));
+    m_slots = static_cast<T*>(static_cast<void*>(m_map + m_headerSize));
+    m_mask = static_cast<std::size_t>(header.capacity) - 1;
+}
+
+template<typename T>
+void MappedQueue<T>::create(const std::string& path, std::size_t capacity, Header& header)
+{
+    long page = sysconf(_SC_PAGESIZE);
+    std::size_t headerSize = MIN_HEADER_SIZE;
+    while(page > 0 && headerSize < static_cast<std::size_t>(page)){ //page sizes are powers of 2
+        headerSize *= 2;
+    }
+    header = Header{MAGIC, VERSION, sizeof(T), headerSize, roundCapacity(capacity), 0, 0};
+
+    std::string temp = path + ".tmp"; //left over by a crash while creating, it is overwritten
+    m_fd = ::open(temp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(m_fd < 0){
+        throw FileError();
+    }
+    if(ftruncate(m_fd, static_cast<off_t>(fileSize(header))) != 0 ||
+       pwrite(m_fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+       (m_syncEvery != 0 && fsync(m_fd) != 0) || //the header reaches the disk before the name does
+       std::rename(temp.c_str(), path.c_str()) != 0){
+        this->release();
+        std::remove(temp.c_str());
+        throw FileError();
+    }
+}
+
+template<typename T>
+bool MappedQueue<T>::valid(const Header& header, std::size_t bytes)
+{
+    return bytes >= sizeof(header) && header.magic == MAGIC && header.version == VERSION &&
+           header.elementSize == sizeof(T) &&
+           header.headerSize >= MIN_HEADER_SIZE && header.headerSize <= MAX_HEADER_SIZE &&
+           (header.headerSize & (header.headerSize - 1)) == 0 &&
+           header.capacity != 0 && (header.capacity & (header.capacity - 1)) == 0 &&
+           header.capacity <= (SIZE_MAX - 2 * header.headerSize) / sizeof(T) && //fileSize can't overflow
+           header.tail - header.head <= header.capacity &&
+           bytes >= fileSize(header); //a truncated file loses slots
+}
+
+template<typename T>
+std::size_t MappedQueue<T>::fileSize(const Header& header)
+{
+    std::size_t headerSize = static_cast<std::size_t>(header.headerSize);
+    std::size_t slotBytes = static_cast<std::size_t>(header.capacity) * sizeof(T);
+    return headerSize + (slotBytes + headerSize - 1) / headerSize * headerSize;
+}
+
+template<typename T>
+void MappedQueue<T>::release() noexcept
+{
+    if(m_map != nullptr){
+        munmap(m_map, m_mapSize);
+        m_map = nullptr;
+    }
+    if(m_fd >= 0){
+        close(m_fd);
+        m_fd = -1;
+    }
+}
+
+template<typename T>
+void MappedQueue<T>::modified()
+{
+    if(m_syncEvery != 0 && ++m_unsynced >= m_syncEvery){
+        this->sync();
+    }
+}
+
+template<typename T>
+std::size_t MappedQueue<T>::roundCapacity(std::size_t capacity)
+{
+    std::size_t rounded = 1;
+    while(rounded < capacity){
+        rounded *= 2;
+    }
+    return rounded;
+}
+
+template<typename T>
+bool MappedQueue<T>::tryPush(const T& val)
+{
+    if(this->full()){
+        return false;
+    }
+    std::uint64_t tail = m_header->tail;
+    std::memcpy(static_cast<void*>(m_slots + (tail & m_mask)), static_cast<const void*>(&val), sizeof(T));
+    std::atomic_signal_fence(std::memory_order_release); //the element is in the mapping before the tail covers it
+    m_header->tail = tail + 1;
+    this->modified();
+    return true;
+}
+
+template<typename T>
+void MappedQueue<T>::pushBack(const T& val)
+{
+    if(!this->tryPush(val)){ //operation is invalid on a full queue
+        throw FullQueue();
+    }
+}
+
+template<typename T>
+template<typename... Args>
+T& MappedQueue<T>::emplaceBack(Args&&... args)
+{
+    std::uint64_t tail = m_header->tail;
+    this->pushBack(T(std::forward<Args>(args)...));
+    return m_slots[tail & m_mask];
+}
+
+template<typename T>
+T& MappedQueue<T>::front()
+{
+    if(this->empty()){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    return m_slots[m_header->head & m_mask];
+}
+
+template<typename T>
+const T& MappedQueue<T>::front() const
+{
+    if(this->empty()){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    return m_slots[m_header->head & m_mask];
+}
+
+template<typename T>
+void MappedQueue<T>::popFront()
+{
+    if(this->empty()){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    m_header->head++; //trivially copyable, nothing to destroy
+    this->modified();
+}
+
+template<typename T>
+T* MappedQueue<T>::tryFront()
+{
+    return this->empty() ? nullptr : &m_slots[m_header->head & m_mask];
+}
+
+template<typename T>
+std::optional<T> MappedQueue<T>::tryPop()
+{
+    if(this->empty()){
+        return std::nullopt;
+    }
+    std::optional<T> result(m_slots[m_header->head & m_mask]);
+    this->popFront();
+    return result;
+}
+
+template<typename T>
+bool MappedQueue<T>::empty() const
+{
+    return m_header->head == m_header->tail;
+}
+
+template<typename T>
+bool MappedQueue<T>::full() const
+{
+    return m_header->tail - m_header->head > m_mask;
+}
+
+template<typename T>
+std::size_t MappedQueue<T>::size() const
+{
+    return static_cast<std::size_t>(m_header->tail - m_header->head);
+}
+
+template<typename T>
+std::size_t MappedQueue<T>::capacity() const
+{
+    return m_mask + 1;
+}
+
+template<typename T>
+void MappedQueue<T>::sync()
+{
+    //slots first, so the header written after them never covers an element that isn't on disk yet
+    //a file created with a smaller page size shares its last header page with slots, it is msynced at once
+    bool failed = m_splitSync ? msync(m_map + m_headerSize, m_mapSize - m_headerSize, MS_SYNC) != 0 ||
+                                msync(m_map, m_headerSize, MS_SYNC) != 0 :
+                                msync(m_map, m_mapSize, MS_SYNC) != 0;
+    if(failed){
+        throw FileError();
+    }
+    m_unsynced = 0;
+}
+
+#endif
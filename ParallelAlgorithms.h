@@ -0,0 +1,185 @@
+#ifndef PARALLEL_ALGORITHMS_H
+#define PARALLEL_ALGORITHMS_H
+
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "QueueAlgorithms.h"
+
+/* Parallel algorithms:
+ *      filter and transform for big queues, split into one contiguous segment per thread
+ *      work on any of the queues (Queue, RingQueue, ChunkedQueue, ...)
+ *      the segments are found with a single walk over the queue, then every segment is processed by its own thread
+ *      predicts and transformers are called concurrently and must be safe to call from several threads
+ *      an exception thrown by any thread is rethrown once every thread finished
+ */
+
+//true if QueueType can take over the elements of another queue with append (Queue does it in O(1))
+template<typename QueueType, typename = void>
+struct HasAppend : std::false_type {};
+
+template<typename QueueType>
+struct HasAppend<QueueType, std::void_t<decltype(std::declval<QueueType&>().append(std::declval<QueueType&>()))>> :
+    std::true_type {};
+
+/**
+ * @brief Default amount of elements a segment holds at least, smaller queues use fewer threads
+ *
+ */
+constexpr std::size_t PARALLEL_MIN_SEGMENT = 4096;
+
+/**
+ * @brief Splits a range into segments of almost equal size and runs work on each of them in its own thread
+ *
+ * @param first - beginning of the range
+ * @param last - end of the range
+ * @param size - amount of elements in the range
+ * @param threads - maximal amount of threads to use, 0 means std::thread::hardware_concurrency()
+ * @param minSegment - minimal amount of elements in a segment
+ * @param work - called as work(segmentIndex, segmentBegin, segmentEnd) once per segment
+ * @return - amount of segments the range was split into
+ */
+template<typename Iter, typename WorkType>
+std::size_t runSegments(Iter first, Iter last, std::size_t size, std::size_t threads, std::size_t minSegment,
+                        WorkType work)
+{
+    if(threads == 0){
+        threads = std::thread::hardware_concurrency();
+    }
+    if(minSegment == 0){
+        minSegment = 1;
+    }
+    std::size_t segments = size / minSegment;
+    if(segments > threads){
+        segments = threads;
+    }
+    if(segments <= 1){ //not worth a thread, running in the caller
+        work(std::size_t(0), first, last);
+        return 1;
+    }
+
+    std::vector<Iter> bounds; //segment i is [bounds[i], bounds[i + 1])
+    bounds.reserve(segments + 1);
+    bounds.push_back(first);
+    for(std::size_t i = 1; i < segments; i++){
+        Iter next = bounds.back();
+        std::advance(next, size / segments + (i <= size % segments ? 1 : 0));
+        bounds.push_back(next);
+    }
+    bounds.push_back(last);
+
+    std::vector<std::exception_ptr> errors(segments);
+    std::vector<std::thread> workers;
+    workers.reserve(segments - 1);
+    try{
+        for(std::size_t i = 1; i < segments; i++){
+            workers.emplace_back([&work, &bounds, &errors, i](){
+                try{
+                    work(i, bounds[i], bounds[i + 1]);
+                } catch(...){
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+    } catch(...){ //couldn't start a thread, the started ones still have to be joined
+        for(std::thread& worker : workers){
+            worker.join();
+        }
+        throw;
+    }
+    try{
+        work(std::size_t(0), bounds[0], bounds[1]); //the caller takes the first segment
+    } catch(...){
+        errors[0] = std::current_exception();
+    }
+    for(std::thread& worker : workers){
+        worker.join();
+    }
+    for(std::exception_ptr& error : errors){
+        if(error){
+            std::rethrow_exception(error);
+        }
+    }
+    return segments;
+}
+
+/**
+ * @brief Transforms a queue in-place according to a map, in parallel
+ *      basic guarantee: if a transformer throws, other elements may already be transformed
+ *
+ * @param queue - queue to transform
+ * @param transformer - mapping operator, called concurrently on different elements
+ * @param threads - maximal amount of threads to use, 0 means std::thread::hardware_concurrency()
+ * @param minSegment - minimal amount of elements handed to a single thread
+ */
+template<typename QueueType, typename FuncType>
+void parallelTransform(QueueType& queue, FuncType transformer, std::size_t threads = 0,
+                       std::size_t minSegment = PARALLEL_MIN_SEGMENT)
+{
+    typedef typename QueueType::Iterator Iter;
+    runSegments(queue.begin(), queue.end(), queue.size(), threads, minSegment,
+        [&transformer](std::size_t, Iter first, Iter last){
+            for(; first != last; ++first){
+                transformer(*first);
+            }
+        });
+}
+
+/**
+ * @brief Filters a queue using a given predict, in parallel
+ *      every thread filters its segment into a queue of its own,
+ *      the segments are then stitched together in their original order (relinked in O(1) when QueueType has append)
+ *      every part allocates through select_on_container_copy_construction of the allocator of queue,
+ *      so an allocator that is not thread safe has to hand out independent copies that way (like PoolAllocator),
+ *      parts whose allocators then compare unequal are stitched element by element
+ *
+ * @param queue - queue to filter through
+ * @param predict - predict to filter by, called concurrently on different elements
+ * @param threads - maximal amount of threads to use, 0 means std::thread::hardware_concurrency()
+ * @param minSegment - minimal amount of elements handed to a single thread
+ * @return - new filtered queue
+ */
+template<typename QueueType, typename FuncType>
+QueueType parallelFilter(const QueueType& queue, FuncType predict, std::size_t threads = 0,
+                         std::size_t minSegment = PARALLEL_MIN_SEGMENT)
+{
+    typedef typename QueueType::ConstIterator Iter;
+    if(threads == 0){
+        threads = std::thread::hardware_concurrency();
+        threads = threads == 0 ? 1 : threads; //0 when the value isn't known
+    }
+    std::vector<QueueType> parts; //one filtered queue per segment, filled by its own thread
+    parts.reserve(threads);
+    for(std::size_t i = 0; i < threads; i++){
+        parts.push_back(queue_detail::emptyLike(queue, 0));
+    }
+    std::size_t segments = runSegments(queue.begin(), queue.end(), queue.size(),
+        threads, minSegment,
+        [&predict, &parts](std::size_t index, Iter first, Iter last){
+            QueueType& part = parts[index];
+            for(; first != last; ++first){
+                if(predict(*first)){
+                    part.pushBack(*first);
+                }
+            }
+        });
+
+    QueueType filtered = std::move(parts[0]);
+    for(std::size_t i = 1; i < segments; i++){ //stitching the segments back in order
+        if constexpr(HasAppend<QueueType>::value){
+            filtered.append(parts[i]);
+        }
+        else{
+            for(auto& data : parts[i]){
+                filtered.pushBack(std::move(data));
+            }
+        }
+    }
+    return filtered;
+}
+
+#endif
@@ -0,0 +1,403 @@
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/* NodePool:
+ *      Freelist of fixed-size blocks carved out of big slabs
+ *      a deallocated block is pushed onto the freelist and handed out again by the next allocate,
+ *      so a steady push/pop loop never reaches the global allocator
+ *      slabs are released when the pool itself is destroyed, or by shrink once every block of a slab is free
+ *      not thread safe - a pool belongs to a single container (or to containers used by one thread)
+ */
+class NodePool {
+public:
+
+    /**
+     * @brief Construct a new empty NodePool, no memory is allocated until the first allocate
+     *
+     * @param blockSize - size of every block handed out
+     * @param blockAlign - alignment of every block handed out
+     * @param blocksPerSlab - number of blocks allocated at once when the freelist runs dry
+     */
+    NodePool(std::size_t blockSize, std::size_t blockAlign, std::size_t blocksPerSlab) :
+        m_blockSize(normalizedSize(blockSize, blockAlign)),
+        m_blockAlign(normalizedAlign(blockAlign)),
+        m_blocksPerSlab(blocksPerSlab == 0 ? 1 : blocksPerSlab),
+        m_freeList(nullptr),
+        m_freeCount(0)
+    { }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    /**
+     * @brief Destroys the NodePool, releasing every slab
+     *
+     */
+    ~NodePool()
+    {
+        for(Slab& slab : m_slabs){
+            ::operator delete(slab.begin, std::align_val_t(m_blockAlign));
+        }
+    }
+
+    /**
+     * @brief Returns a block from the freelist, allocating a new slab only if the freelist is empty
+     *
+     * @return - pointer to an uninitialized block of blockSize() bytes
+     */
+    void* allocate()
+    {
+        if(m_freeList == nullptr){ //slow path, refill the freelist
+            addSlab(m_blocksPerSlab);
+        }
+        FreeBlock* block = m_freeList;
+        m_freeList = block->next;
+        m_freeCount--;
+        return block;
+    }
+
+    /**
+     * @brief Returns a block to the freelist so it can be reused
+     *
+     * @param block - block previously returned by allocate of this pool
+     */
+    void deallocate(void* block) noexcept
+    {
+        FreeBlock* freed = static_cast<FreeBlock*>(block);
+        freed->next = m_freeList;
+        m_freeList = freed;
+        m_freeCount++;
+    }
+
+    /**
+     * @brief Makes sure at least blocks allocations can be served without allocating a slab
+     *
+     * @param blocks - number of blocks that should be available in the freelist
+     */
+    void reserve(std::size_t blocks)
+    {
+        if(blocks > m_freeCount){
+            addSlab(blocks - m_freeCount);
+        }
+    }
+
+    /**
+     * @brief Releases every slab whose blocks are all in the freelist, blocks still in use are untouched
+     *      costs O(f log s) for f free blocks and s slabs
+     *
+     */
+    void shrink()
+    {
+        if(m_slabs.empty() || m_freeCount == 0){
+            return;
+        }
+        std::sort(m_slabs.begin(), m_slabs.end(), [](const Slab& a, const Slab& b){
+            return std::less<char*>()(a.begin, b.begin);
+        });
+        std::vector<std::size_t> freeBlocks(m_slabs.size(), 0); //free blocks counted per slab
+        for(FreeBlock* block = m_freeList; block != nullptr; block = block->next){
+            freeBlocks[slabOf(block)]++;
+        }
+
+        FreeBlock* kept = nullptr; //freelist without the blocks of released slabs, in the same order
+        FreeBlock** tail = &kept;
+        std::size_t keptCount = 0;
+        for(FreeBlock* block = m_freeList; block != nullptr; block = block->next){
+            std::size_t index = slabOf(block);
+            if(freeBlocks[index] != m_slabs[index].blocks){
+                *tail = block;
+                tail = &block->next;
+                keptCount++;
+            }
+        }
+        *tail = nullptr;
+        m_freeList = kept;
+        m_freeCount = keptCount;
+
+        std::size_t remaining = 0;
+        for(std::size_t i = 0; i < m_slabs.size(); i++){
+            if(freeBlocks[i] == m_slabs[i].blocks){
+                ::operator delete(m_slabs[i].begin, std::align_val_t(m_blockAlign));
+            }
+            else{
+                m_slabs[remaining++] = m_slabs[i];
+            }
+        }
+        m_slabs.resize(remaining);
+    }
+
+    /**
+     * @brief Returns the number of blocks currently available in the freelist
+     */
+    std::size_t freeCount() const
+    {
+        return m_freeCount;
+    }
+
+    /**
+     * @brief Returns the size of a single block
+     */
+    std::size_t blockSize() const
+    {
+        return m_blockSize;
+    }
+
+    /**
+     * @brief Returns the alignment of a single block
+     */
+    std::size_t blockAlign() const
+    {
+        return m_blockAlign;
+    }
+
+    /**
+     * @brief Returns the alignment a pool created with the given alignment actually uses
+     */
+    static std::size_t normalizedAlign(std::size_t align)
+    {
+        return align < alignof(FreeBlock) ? alignof(FreeBlock) : align;
+    }
+
+    /**
+     * @brief Returns the block size a pool created with the given size and alignment actually uses
+     */
+    static std::size_t normalizedSize(std::size_t size, std::size_t align)
+    {
+        std::size_t normalAlign = normalizedAlign(align);
+        if(size < sizeof(FreeBlock)){ //a free block has to hold the freelist link
+            size = sizeof(FreeBlock);
+        }
+        return (size + normalAlign - 1) / normalAlign * normalAlign;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next; //next free block in the freelist
+    };
+
+    //a slab allocated by the pool
+    struct Slab {
+        char* begin; //first block of the slab
+        std::size_t blocks; //amount of blocks in the slab
+    };
+
+    //returns the index of the slab holding block, m_slabs must be sorted by address
+    std::size_t slabOf(const FreeBlock* block) const
+    {
+        const char* address = reinterpret_cast<const char*>(block);
+        std::size_t low = 0;
+        std::size_t high = m_slabs.size();
+        while(high - low > 1){ //last slab that starts at or before address
+            std::size_t middle = low + (high - low) / 2;
+            if(std::less<const char*>()(address, m_slabs[middle].begin)){
+                high = middle;
+            }
+            else{
+                low = middle;
+            }
+        }
+        return low;
+    }
+
+    //allocates a slab of the given amount of blocks and threads all of them into the freelist
+    void addSlab(std::size_t blocks)
+    {
+        if(m_slabs.size() == m_slabs.capacity()){ //so push_back below can't throw after the slab is allocated
+            m_slabs.reserve(m_slabs.capacity() * 2 + 1);
+        }
+        char* slab = static_cast<char*>(::operator new(blocks * m_blockSize, std::align_val_t(m_blockAlign)));
+        m_slabs.push_back(Slab{slab, blocks});
+        for(std::size_t i = blocks; i > 0; i--){ //pushing backwards so blocks are handed out in address order
+            deallocate(slab + (i - 1) * m_blockSize);
+        }
+    }
+
+    std::size_t m_blockSize; //size of a block, at least big enough to hold a FreeBlock
+    std::size_t m_blockAlign; //alignment of a block
+    std::size_t m_blocksPerSlab; //amount of blocks allocated when the freelist runs dry
+    FreeBlock* m_freeList; //head of the freelist
+    std::size_t m_freeCount; //number of blocks in the freelist
+    std::vector<Slab> m_slabs; //every slab allocated by the pool
+};
+
+/* PoolResource:
+ *      Set of NodePools, one per (size, alignment) class
+ *      shared by every PoolAllocator copied or rebound from the same allocator,
+ *      so a Queue's rebound node allocator and the allocator it was built from use the same memory
+ */
+class PoolResource {
+public:
+
+    /**
+     * @brief Construct a new PoolResource
+     *
+     * @param blocksPerSlab - number of blocks allocated at once by each of the pools
+     */
+    explicit PoolResource(std::size_t blocksPerSlab) :
+        m_blocksPerSlab(blocksPerSlab)
+    { }
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    /**
+     * @brief Returns the pool that serves blocks of the given size and alignment, creating it if needed
+     *
+     * @param size - size of the blocks
+     * @param align - alignment of the blocks
+     * @return - reference to the pool, stays valid for the lifetime of the resource
+     */
+    NodePool& poolFor(std::size_t size, std::size_t align)
+    {
+        std::size_t blockSize = NodePool::normalizedSize(size, align);
+        std::size_t blockAlign = NodePool::normalizedAlign(align);
+        for(const std::unique_ptr<NodePool>& pool : m_pools){ //very few size classes are ever used
+            if(pool->blockSize() == blockSize && pool->blockAlign() == blockAlign){
+                return *pool;
+            }
+        }
+        m_pools.push_back(std::unique_ptr<NodePool>(new NodePool(size, align, m_blocksPerSlab)));
+        return *m_pools.back();
+    }
+
+private:
+    std::size_t m_blocksPerSlab; //slab size passed to every pool
+    std::vector<std::unique_ptr<NodePool>> m_pools; //pools by size class
+};
+
+/**
+ * @brief Allocator that serves single-object allocations from a freelist of recycled blocks
+ *
+ *  Meant to be used as the Alloc parameter of a node based container:
+ *      Queue<T, PoolAllocator<T>>
+ *  popped nodes go back to the freelist and the next push reuses them
+ *  allocations of more than one object are forwarded to std::allocator
+ *  copies and rebinds share the same PoolResource, copying a container gives the copy a pool of its own
+ *  not thread safe
+ *
+ * @tparam T - type to allocate
+ * @tparam BlocksPerSlab - number of blocks allocated at once when the freelist runs dry
+ */
+template<class T, std::size_t BlocksPerSlab = 256>
+class PoolAllocator {
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+
+    template<class U>
+    struct rebind {
+        typedef PoolAllocator<U, BlocksPerSlab> other;
+    };
+
+    /**
+     * @brief Construct a new PoolAllocator with a fresh PoolResource of its own
+     *
+     */
+    PoolAllocator() :
+        m_resource(std::make_shared<PoolResource>(BlocksPerSlab)),
+        m_pool(&m_resource->poolFor(sizeof(T), alignof(T)))
+    { }
+
+    PoolAllocator(const PoolAllocator&) = default;
+    PoolAllocator& operator=(const PoolAllocator&) = default;
+
+    /**
+     * @brief Rebinding c'tor, the new allocator shares the resource of other
+     *
+     * @param other - allocator to rebind from
+     */
+    template<class U>
+    PoolAllocator(const PoolAllocator<U, BlocksPerSlab>& other) :
+        m_resource(other.m_resource),
+        m_pool(&m_resource->poolFor(sizeof(T), alignof(T)))
+    { }
+
+    /**
+     * @brief Allocates storage for n objects of type T
+     *
+     * @param n - number of objects
+     * @return - pointer to uninitialized storage
+     */
+    T* allocate(std::size_t n)
+    {
+        if(n == 1){ //the hot path of node based containers
+            return static_cast<T*>(m_pool->allocate());
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    /**
+     * @brief Releases storage previously returned by allocate
+     *
+     * @param ptr - storage to release
+     * @param n - number of objects passed to allocate
+     */
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        if(n == 1){
+            m_pool->deallocate(ptr);
+        }
+        else{
+            std::allocator<T>().deallocate(ptr, n);
+        }
+    }
+
+    /**
+     * @brief Preallocates blocks so the next n single-object allocations don't allocate a slab
+     *
+     * @param n - number of objects to reserve storage for
+     */
+    void reserve(std::size_t n)
+    {
+        m_pool->reserve(n);
+    }
+
+    /**
+     * @brief Releases the slabs of the pool of T whose blocks are all free
+     *      the pool is shared with every copy and rebind of this allocator
+     *
+     */
+    void shrinkToFit()
+    {
+        m_pool->shrink();
+    }
+
+    /**
+     * @brief A copied container gets an allocator with a pool of its own
+     */
+    PoolAllocator select_on_container_copy_construction() const
+    {
+        return PoolAllocator();
+    }
+
+    template<class U>
+    bool operator==(const PoolAllocator<U, BlocksPerSlab>& other) const
+    {
+        return m_resource == other.m_resource;
+    }
+
+    template<class U>
+    bool operator!=(const PoolAllocator<U, BlocksPerSlab>& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    std::shared_ptr<PoolResource> m_resource; //memory shared with every copy and rebind
+    NodePool* m_pool; //pool of the resource serving blocks of sizeof(T)
+
+    template<class U, std::size_t B>
+    friend class PoolAllocator;
+};
+
+#endif
@@ -0,0 +1,432 @@
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/* PriorityQueue:
+ *      Queue whose front is always the element with the highest priority instead of the oldest one
+ *      Compare(a, b) returns true if a has a lower priority than b, std::less makes the front the largest element
+ *      elements are stored as a 4-ary heap in a single std::vector:
+ *          the children of index i are 4i + 1 .. 4i + 4, so they share one or two cache lines
+ *          the heap is half as deep as a binary heap, popFront touches half as many levels
+ *      sifting moves a hole instead of swapping, every level costs a single move
+ *
+ *  iteration sees every element exactly once, in heap order (not in priority order), and is read-only
+ *  basic guarantee: if Compare or a move of T throws while sifting, the elements stay valid but their order may not
+ */
+template <class T, class Compare = std::less<T>, class Alloc = std::allocator<T>>
+class PriorityQueue {
+private:
+    std::vector<T, Alloc> m_heap; //4-ary heap, the front is m_heap[0]
+    Compare m_compare; //priority order
+
+    //amount of children of every node of the heap
+    static constexpr std::size_t ARITY = 4;
+
+    //moves val up from the hole at index until its parent has no lower priority
+    void siftUp(std::size_t index, T val);
+
+    //moves val down from the hole at index until no child has a higher priority
+    void siftDown(std::size_t index, T val);
+
+    //restores the heap order of the whole vector in O(n)
+    void heapify();
+
+public:
+
+    /**
+     * @brief Construct a new empty PriorityQueue
+     *
+     */
+    PriorityQueue();
+
+    /**
+     * @brief Construct a new empty PriorityQueue with the given priority order
+     *
+     * @param compare - returns true if its first argument has a lower priority than its second
+     * @param alloc - allocator of the storage
+     */
+    explicit PriorityQueue(const Compare& compare, const Alloc& alloc = Alloc());
+
+    /**
+     * @brief Construct a new PriorityQueue holding the elements of a range, heapified in O(n)
+     *
+     * @param first - beginning of the range
+     * @param last - end of the range
+     * @param compare - returns true if its first argument has a lower priority than its second
+     * @param alloc - allocator of the storage
+     */
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    PriorityQueue(InputIt first, InputIt last, const Compare& compare = Compare(), const Alloc& alloc = Alloc());
+
+    /**
+     * @brief Inserts an element in its place in the PriorityQueue
+     *
+     * @param val - value to be inserted
+     */
+    void pushBack(const T& val);
+
+    /**
+     * @brief Moves a value into its place in the PriorityQueue
+     *
+     * @param val - value to be moved into the queue
+     */
+    void pushBack(T&& val);
+
+    /**
+     * @brief Constructs a new element and moves it into its place in the PriorityQueue
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     */
+    template<typename... Args>
+    void emplace(Args&&... args);
+
+    /**
+     * @brief Inserts every element of a range, heapifying everything at once when the range outnumbers the queue
+     *
+     * @param first - beginning of the range
+     * @param last - end of the range
+     */
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void pushBack(InputIt first, InputIt last);
+
+    /**
+     * @brief Returns a const reference to the element with the highest priority
+     *      a mutable reference could break the heap order, so there is none
+     *
+     * @return - const reference to the front
+     */
+    const T& front() const;
+
+    /**
+     * @brief Pops the element with the highest priority
+     *
+     */
+    void popFront();
+
+    /**
+     * @brief Returns a const pointer to the element with the highest priority without throwing
+     *
+     * @return - const pointer to the front, nullptr if the queue is empty
+     */
+    const T* tryFront() const;
+
+    /**
+     * @brief Moves the element with the highest priority out of the queue and pops it, without throwing on an empty queue
+     *
+     * @return - the front element, or an empty optional if the queue is empty
+     */
+    std::optional<T> tryPop();
+
+    /**
+     * @brief Checks if the queue is empty
+     *
+     * @return true if the queue holds no elements
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns the size of the queue
+     *
+     * @return - size of the queue
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Destroys every element, the storage is kept for the next pushes
+     *
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Allocates storage up front so the queue can grow to the given size without allocating
+     *
+     * @param count - amount of elements the queue should be able to hold without allocating
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * @brief Shrinks the storage to the amount of elements in the queue
+     *
+     */
+    void shrinkToFit();
+
+    /**
+     * @brief Returns a copy of the allocator the PriorityQueue was constructed with
+     *
+     */
+    Alloc getAllocator() const;
+
+    /**
+     * @brief Returns a copy of the priority order of the PriorityQueue
+     *
+     */
+    Compare getCompare() const;
+
+    /**
+     * @brief Iterator classes for PriorityQueue, both are read-only since writing through them could break the heap
+     *
+     */
+    typedef typename std::vector<T, Alloc>::const_iterator ConstIterator;
+    typedef ConstIterator Iterator;
+
+    ConstIterator begin() const
+    {
+        return m_heap.begin();
+    }
+
+    ConstIterator end() const
+    {
+        return m_heap.end();
+    }
+
+    /**
+     * @brief Exception Class to deal with invalid operations done on an empty PriorityQueue
+     *
+     *  Invalid operators on an empty PriorityQueue:
+     *      front, popFront
+     */
+    class EmptyQueue {};
+};
+
+/**
+ * @brief Filters a PriorityQueue using a given predict
+ *
+ * @param queue - queue to filter through
+ * @param predict - predict to filter by
+ * @return - new filtered PriorityQueue, heapified once
+ */
+template<typename T, typename Compare, typename Alloc, typename FuncType>
+PriorityQueue<T, Compare, Alloc> filter(const PriorityQueue<T, Compare, Alloc>& queue, FuncType predict)
+{
+    std::vector<T, Alloc> kept(std::allocator_traits<Alloc>::select_on_container_copy_construction(queue.getAllocator()));
+    for(const T& data : queue)
+    {
+        if(predict(data)){
+            kept.push_back(data);
+        }
+    }
+    return PriorityQueue<T, Compare, Alloc>(std::make_move_iterator(kept.begin()), std::make_move_iterator(kept.end()),
+                                            queue.getCompare(), kept.get_allocator());
+}
+
+/**
+ * @brief Transforms a PriorityQueue according to a map, the priorities may change so the result is heapified again
+ *
+ *  strong guarantee: if transformer throws, queue is left unchanged
+ *
+ * @param queue - queue to transform
+ * @param transformer - mapping operator, called on a copy of every element
+ */
+template<typename T, typename Compare, typename Alloc, typename FuncType>
+void transform(PriorityQueue<T, Compare, Alloc>& queue, FuncType transformer)
+{
+    std::vector<T, Alloc> transformed(queue.begin(), queue.end(),
+        std::allocator_traits<Alloc>::select_on_container_copy_construction(queue.getAllocator()));
+    for(T& data : transformed)
+    {
+        transformer(data);
+    }
+    queue = PriorityQueue<T, Compare, Alloc>(std::make_move_iterator(transformed.begin()),
+                                             std::make_move_iterator(transformed.end()),
+                                             queue.getCompare(), transformed.get_allocator());
+}
+
+template<typename T, typename Compare, typename Alloc>
+PriorityQueue<T, Compare, Alloc>::PriorityQueue() :
+    m_heap(),
+    m_compare()
+{ }
+
+template<typename T, typename Compare, typename Alloc>
+PriorityQueue<T, Compare, Alloc>::PriorityQueue(const Compare& compare, const Alloc& alloc) :
+    m_heap(alloc),
+    m_compare(compare)
+{ }
+
+template<typename T, typename Compare, typename Alloc>
+template<typename InputIt, typename>
+PriorityQueue<T, Compare, Alloc>::PriorityQueue(InputIt first, InputIt last, const Compare& compare,
+                                                const Alloc& alloc) :
+    m_heap(first, last, alloc),
+    m_compare(compare)
+{
+    this->heapify();
+}
+
+template<typename T, typename Compare, typename Alloc>
+void PriorityQueue<T, Compare, Alloc>::pushBack(const T& val)
+{
+    this->emplace(val);
+}
+
+template<typename T, typename Compare, typename Alloc>
+void PriorityQueue<T, Compare, Alloc>::pushBack(T&& val)
+{
+    this->emplace(std::move(val));
+}
+
+template<typename T, typename Compare, typename Alloc>
+template<typename... Args>
+void PriorityQueue<T, Compare, Alloc>::emplace(Args&&... args)
+{
+    m_heap.emplace_back(std::forward<Args>(args)...);
+    std::size_t index = m_heap.size() - 1;
+    this->siftUp(index, std::move(m_heap[index]));
+}
+
+template<typename T, typename Compare, typename Alloc>
+template<typename InputIt, typename>
+void PriorityQueue<T, Compare, Alloc>::pushBack(InputIt first, InputIt last)
+{
+    std::size_t oldSize = m_heap.size();
+    m_heap.insert(m_heap.end(), first, last);
+    std::size_t added = m_heap.size() - oldSize;
+    if(added > oldSize){ //sifting each one up would cost more than rebuilding the heap
+        this->heapify();
+        return;
+    }
+    for(std::size_t index = oldSize; index < m_heap.size(); index++){
+        this->siftUp(index, std::move(m_heap[index]));
+    }
+}
+
+template<typename T, typename Compare, typename Alloc>
+const T& PriorityQueue<T, Compare, Alloc>::front() const
+{
+    if(this->empty()){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    return m_heap.front();
+}
+
+template<typename T, typename Compare, typename Alloc>
+void PriorityQueue<T, Compare, Alloc>::popFront()
+{
+    if(this->empty()){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    T last = std::move(m_heap.back());
+    m_heap.pop_back();
+    if(!m_heap.empty()){ //the front is now a hole, the former last element falls into it
+        this->siftDown(0, std::move(last));
+    }
+}
+
+template<typename T, typename Compare, typename Alloc>
+const T* PriorityQueue<T, Compare, Alloc>::tryFront() const
+{
+    return this->empty() ? nullptr : &m_heap.front();
+}
+
+template<typename T, typename Compare, typename Alloc>
+std::optional<T> PriorityQueue<T, Compare, Alloc>::tryPop()
+{
+    if(this->empty()){
+        return std::nullopt;
+    }
+    std::optional<T> result(std::move(m_heap.front()));
+    this->popFront();
+    return result;
+}
+
+template<typename T, typename Compare, typename Alloc>
+bool PriorityQueue<T, Compare, Alloc>::empty() const
+{
+    return m_heap.empty();
+}
+
+template<typename T, typename Compare, typename Alloc>
+std::size_t PriorityQueue<T, Compare, Alloc>::size() const
+{
+    return m_heap.size();
+}
+
+template<typename T, typename Compare, typename Alloc>
+void PriorityQueue<T, Compare, Alloc>::clear() noexcept
+{
+    m_heap.clear();
+}
+
+template<typename T, typename Compare, typename Alloc>
+void PriorityQueue<T, Compare, Alloc>::reserve(std::size_t count)
+{
+    m_heap.reserve(count);
+}
+
+template<typename T, typename Compare, typename Alloc>
+void PriorityQueue<T, Compare, Alloc>::shrinkToFit()
+{
+    m_heap.shrink_to_fit();
+}
+
+template<typename T, typename Compare, typename Alloc>
+Alloc PriorityQueue<T, Compare, Alloc>::getAllocator() const
+{
+    return m_heap.get_allocator();
+}
+
+template<typename T, typename Compare, typename Alloc>
+Compare PriorityQueue<T, Compare, Alloc>::getCompare() const
+{
+    return m_compare;
+}
+
+template<typename T, typename Compare, typename Alloc>
+void PriorityQueue<T, Compare, Alloc>::siftUp(std::size_t index, T val)
+{
+    while(index > 0){
+        std::size_t parent = (index - 1) / ARITY;
+        if(!m_compare(m_heap[parent], val)){
+            break;
+        }
+        m_heap[index] = std::move(m_heap[parent]); //the hole moves up a level
+        index = parent;
+    }
+    m_heap[index] = std::move(val);
+}
+
+template<typename T, typename Compare, typename Alloc>
+void PriorityQueue<T, Compare, Alloc>::siftDown(std::size_t index, T val)
+{
+    std::size_t size = m_heap.size();
+    while(true){
+        std::size_t child = ARITY * index + 1;
+        if(child >= size){
+            break;
+        }
+        std::size_t last = child + ARITY < size ? child + ARITY : size;
+        std::size_t best = child;
+        for(child++; child < last; child++){ //the siblings are contiguous
+            if(m_compare(m_heap[best], m_heap[child])){
+                best = child;
+            }
+        }
+        if(!m_compare(val, m_heap[best])){
+            break;
+        }
+        m_heap[index] = std::move(m_heap[best]); //the hole moves down a level
+        index = best;
+    }
+    m_heap[index] = std::move(val);
+}
+
+template<typename T, typename Compare, typename Alloc>
+void PriorityQueue<T, Compare, Alloc>::heapify()
+{
+    std::size_t size = m_heap.size();
+    if(size < 2){
+        return;
+    }
+    for(std::size_t index = (size - 2) / ARITY + 1; index-- > 0; ){ //every node with a child, bottom up
+        this->siftDown(index, std::move(m_heap[index]));
+    }
+}
+
+#endif
@@ -1,11 +1,31 @@
 #ifndef QUEUE_H
 #define QUEUE_H
 
+#include <cassert>
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "PoolAllocator.h"
+#include "QueueAlgorithms.h"
+#include "QueueConfig.h"
+#include "QueueStats.h"
+#include "QueueTraits.h"
 
-template <class T>
-class Queue {
+/* Queue:
+ *      Stats - policy counting pushes, pops, empty pops, allocations and the high-water mark (QueueStats.h),
+ *      NoStats compiles every hook away and, as an empty base, adds nothing to the size of the queue
+ *
+ *  copies go through the bulk pushBack, which builds the whole chain before linking it
+ *  copy-assigning a queue of a trivially copyable T overwrites the nodes this already has,
+ *  and only allocates or frees the difference in size
+ */
+template <class T, class Alloc = std::allocator<T>, class Stats = NoStats>
+class Queue : private Stats {
 private:
 
     //private node struct to implement the queue
@@ -13,16 +33,22 @@ private:
         T data; //data stores inside the node
         Node* next; //pointer to next node
 
-        //C'tor of a node, makes a node with given data that points to nullptr
-        Node(T data) :
-            data(data),
+        //C'tor of a node, constructs the data in place from the given arguments and points to nullptr
+        template<typename... Args>
+        explicit Node(Args&&... args) :
+            data(std::forward<Args>(args)...),
             next(nullptr)
         { }
     };
 
+    //allocator of nodes, rebound from Alloc
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Node> NodeAllocator;
+    typedef std::allocator_traits<NodeAllocator> NodeTraits;
+
+    NodeAllocator m_alloc; //allocates and frees every node of the queue
     Node* m_front; //front of the queue
     Node* m_rear; //rear of the queue
-    int m_size; //size of the queue, dynamically increasing and decreasing as the queue changes
+    std::size_t m_size; //size of the queue, dynamically increasing and decreasing as the queue changes
 
     /* RawIterator:
      *      Iterator class that supports both const iteration and normal iteration
@@ -33,6 +59,56 @@ private:
     template<typename Modified_Type>
     class RawIterator;
 
+    //allocates a node through m_alloc and constructs its data from args
+    template<typename... Args>
+    Node* createNode(Args&&... args);
+
+    //destroys the data of a node and returns it to m_alloc
+    void destroyNode(Node* node) noexcept;
+
+    //destroys every node and leaves the queue empty
+    void destroyNodes() noexcept;
+
+    //swaps the node chains and sizes of two queues, allocators are untouched
+    void swapNodes(Queue& other) noexcept;
+
+    //copies other into the nodes of this, allocating or freeing only the difference, T is trivially copy assignable
+    //strong guarantee: if a node can't be allocated, this is left unchanged
+    void assignNodes(const Queue& other);
+
+    //true when copy-assigning keeps the existing nodes, assigning such a T can't throw
+    static constexpr bool REUSE_NODES = std::is_trivially_copyable<T>::value &&
+                                        std::is_trivially_copy_assignable<T>::value;
+
+    //pops the front element, the queue must not be empty
+    void removeFront() noexcept;
+
+    //stats policy the operations report to
+    Stats& counters() noexcept
+    {
+        return *this;
+    }
+
+    //preallocates nodes when the allocator supports it (PoolAllocator::reserve), otherwise does nothing
+    template<typename NodeAlloc>
+    static auto reserveNodes(NodeAlloc& alloc, std::size_t n, int) -> decltype(alloc.reserve(n), void());
+    template<typename NodeAlloc>
+    static void reserveNodes(NodeAlloc&, std::size_t, long) {}
+
+    //preallocates a node per element of [first, last) when the allocator supports it, otherwise does nothing
+    //the range is walked for its length only when the allocator can make use of it
+    template<typename NodeAlloc, typename ForwardIt>
+    static auto reserveRange(NodeAlloc& alloc, ForwardIt first, ForwardIt last, int)
+        -> decltype(alloc.reserve(std::size_t()), void());
+    template<typename NodeAlloc, typename ForwardIt>
+    static void reserveRange(NodeAlloc&, ForwardIt, ForwardIt, long) {}
+
+    //releases unused preallocated nodes when the allocator supports it (PoolAllocator::shrinkToFit), otherwise does nothing
+    template<typename NodeAlloc>
+    static auto shrinkNodes(NodeAlloc& alloc, int) -> decltype(alloc.shrinkToFit(), void());
+    template<typename NodeAlloc>
+    static void shrinkNodes(NodeAlloc&, long) {}
+
 public:
 
     /**
@@ -41,6 +117,13 @@ public:
      */
     Queue();
 
+    /**
+     * @brief Construct a new Queue that allocates its nodes with the given allocator
+     * 
+     * @param alloc - allocator to rebind for the nodes
+     */
+    explicit Queue(const Alloc& alloc);
+
     /**
      * @brief Copy Constructor for a Queue
      *
@@ -48,6 +131,21 @@ public:
      */
     Queue(const Queue& other);
 
+    /**
+     * @brief Copy Constructor for a Queue that uses the given allocator
+     *
+     * @param other - Queue to copy
+     * @param alloc - allocator to rebind for the nodes
+     */
+    Queue(const Queue& other, const Alloc& alloc);
+
+    /**
+     * @brief Move Constructor for a Queue, steals the nodes of other in O(1)
+     *
+     * @param other - Queue to move from, left empty
+     */
+    Queue(Queue&& other) noexcept;
+
     /**
      * @brief Destroys the Queue
      * 
@@ -62,6 +160,15 @@ public:
      */
     Queue& operator=(const Queue& other);
 
+    /**
+     * @brief Move assignment operator of a Queue, steals the nodes of other in O(1)
+     * 
+     * @param other - Queue to move from, left empty
+     * @return - reference to the assigned queue
+     */
+    Queue& operator=(Queue&& other) noexcept(NodeTraits::propagate_on_container_move_assignment::value ||
+                                             NodeTraits::is_always_equal::value);
+
     /**
      * @brief Inserts in the back of the Queue
      * 
@@ -69,6 +176,52 @@ public:
      */
     void pushBack(const T& val);
 
+    /**
+     * @brief Inserts in the back of the Queue by moving the given value
+     * 
+     * @param val - value to be moved into the queue
+     */
+    void pushBack(T&& val);
+
+    /**
+     * @brief Constructs a new element in place in the back of the Queue
+     * 
+     * @param args - arguments forwarded to the c'tor of T
+     * @return - reference to the newly constructed element
+     */
+    template<typename... Args>
+    T& emplaceBack(Args&&... args);
+
+    /**
+     * @brief Inserts the elements of [first, last) in the back of the queue, in order
+     * 
+     *      the new nodes are chained first and linked to the queue at once,
+     *      with PoolAllocator the nodes of a forward range come from a single slab
+     *      strong guarantee: if an element can't be inserted, the queue is left unchanged
+     * 
+     * @param first - beginning of the range to insert
+     * @param last - end of the range to insert
+     */
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void pushBack(InputIt first, InputIt last);
+
+    /**
+     * @brief Moves every element of other to the back of the Queue, leaving other empty
+     *      O(1) when both queues use equal allocators: the node chain of other is relinked,
+     *      no node is allocated and no element is copied or moved
+     *      otherwise the elements are moved one by one (basic guarantee)
+     * 
+     * @param other - Queue to take the elements of, appending a queue to itself does nothing
+     */
+    void append(Queue& other);
+
+    /**
+     * @brief Moves every element of other to the back of the Queue, same as append
+     * 
+     * @param other - Queue to take the elements of
+     */
+    void splice(Queue&& other);
+
     /**
      * @brief Returns a reference to the front of the queue
      * 
@@ -89,24 +242,104 @@ public:
      */
     void popFront();
 
+    /**
+     * @brief Pops the n elements in the front of the queue
+     * 
+     * @param n - amount of elements to pop, if the queue holds fewer EmptyQueue is thrown and nothing is popped
+     */
+    void popFront(std::size_t n);
+
+    /**
+     * @brief Moves up to n elements from the front of the queue into out and pops them
+     * 
+     * @param out - output iterator receiving the elements in order
+     * @param n - maximal amount of elements to move
+     * @return - amount of elements moved, smaller than n if the queue ran out of elements
+     */
+    template<typename OutputIt>
+    std::size_t drainTo(OutputIt out, std::size_t n);
+
+    /**
+     * @brief Checks if the queue is empty
+     * 
+     * @return true if the queue holds no elements
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns a pointer to the front of the queue without throwing
+     * 
+     * @return - pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    T* tryFront();
+
+    /**
+     * @brief Returns a const pointer to the front of the queue without throwing
+     * 
+     * @return - const pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    const T* tryFront() const;
+
+    /**
+     * @brief Moves the front element out of the queue and pops it, without throwing on an empty queue
+     * 
+     * @return - the front element, or an empty optional if the queue is empty
+     */
+    std::optional<T> tryPop();
+
     /**
      * @brief Returns the size of the list
      * 
      * @return - size of the list
      */
-    int size() const;
+    std::size_t size() const;
+
+    /**
+     * @brief Destroys every element, freeing the nodes in a single pass
+     *
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Preallocates nodes so the queue can grow to the given size without the allocator allocating
+     *      only has an effect with an allocator that can preallocate (PoolAllocator), otherwise does nothing
+     *
+     * @param count - amount of elements the queue should be able to hold without allocating
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * @brief Gives preallocated nodes that are not in use back to the system
+     *      only has an effect with an allocator that can release memory (PoolAllocator), otherwise does nothing
+     *
+     */
+    void shrinkToFit();
+
+    /**
+     * @brief Returns a copy of the allocator the Queue was constructed with
+     * 
+     * @return - allocator of the queue
+     */
+    Alloc getAllocator() const;
+
+    /**
+     * @brief Returns the counters of the stats policy, all zero with NoStats
+     *
+     * @return - pushes, pops, empty pops, high-water mark and allocations so far
+     */
+    QueueStatsSnapshot stats() const;
 
     /**
      * @brief Iterator class for Queue
      * 
      */
-    typedef Queue<T>::RawIterator<T> Iterator;
+    typedef RawIterator<T> Iterator;
 
     /**
      * @brief Const Iterator class for Queue
      * 
      */
-    typedef Queue<T>::RawIterator<const T> ConstIterator;
+    typedef RawIterator<const T> ConstIterator;
     
     /**
      * @brief Returns an Iterator pointing to the front of the Queue
@@ -150,44 +383,15 @@ public:
 };
 
 /**
- * @brief Filters a Queue using a given predict
- * 
- * @param queue - queue to filter through
- * @param predict - predict to filter by
- * @return - new filtered Queue
- */
-template<typename T, typename FuncType>
-Queue<T> filter(const Queue<T>& queue, FuncType predict)
-{
-    Queue<T> filtered;
-    for(const T& data : queue)
-    {
-        if(predict(data)){
-            filtered.pushBack(data);
-        }
-    }
-    return filtered;
-}
-
-/**
- * @brief Transforms a Queue in-place according to a map
+ * @brief Queue whose nodes are recycled through a freelist instead of going through new/delete
  * 
- * @param queue - queue to transform
- * @param transformer - mapping operator
  */
-template<typename T, typename FuncType>
-void transform(Queue<T>& queue, FuncType transformer)
-{
-    Queue<T> transformed = queue; //making a temporary queue to operate on
-    for(T& data : transformed)
-    {
-        transformer(data);
-    }
-    queue = transformed; //assigning the transformed queue
-}
-
 template<typename T>
-Queue<T>::Queue() :
+using PooledQueue = Queue<T, PoolAllocator<T>>;
+
+template<typename T, typename Alloc, typename Stats>
+Queue<T, Alloc, Stats>::Queue() :
+        m_alloc(),
         m_front(nullptr),
         m_rear(nullptr),
         m_size(0)
@@ -199,54 +403,121 @@ Queue<T>::Queue() :
          */
     { }
 
-template<typename T>
-Queue<T>::Queue(const Queue& other) :
+template<typename T, typename Alloc, typename Stats>
+Queue<T, Alloc, Stats>::Queue(const Alloc& alloc) :
+    m_alloc(alloc),
     m_front(nullptr),
     m_rear(nullptr),
     m_size(0)
+{ }
+
+template<typename T, typename Alloc, typename Stats>
+Queue<T, Alloc, Stats>::Queue(const Queue& other) :
+    Queue(other, std::allocator_traits<Alloc>::select_on_container_copy_construction(other.getAllocator()))
+{ }
+
+template<typename T, typename Alloc, typename Stats>
+Queue<T, Alloc, Stats>::Queue(const Queue& other, const Alloc& alloc) :
+    Queue(alloc)
 {
-    try{
-        for(ConstIterator iter = other.begin(); iter != other.end(); ++iter){
-            this->pushBack(*iter);
-        }
-    } catch(std::bad_alloc&){
-        this->~Queue();
-        throw;
-    }
+    this->pushBack(other.begin(), other.end()); //frees its own chain if the allocator or the copy c'tor of T fails
 }
 
-template<typename T>
-Queue<T>::~Queue()
+template<typename T, typename Alloc, typename Stats>
+Queue<T, Alloc, Stats>::Queue(Queue&& other) noexcept :
+    m_alloc(std::move(other.m_alloc)),
+    m_front(other.m_front),
+    m_rear(other.m_rear),
+    m_size(other.m_size)
 {
-    while(m_size > 0){
-        this->popFront();
-    }
+    other.m_front = nullptr;
+    other.m_rear = nullptr;
+    other.m_size = 0;
 }
 
-template<typename T>
-Queue<T>& Queue<T>::operator=(const Queue& other)
+template<typename T, typename Alloc, typename Stats>
+Queue<T, Alloc, Stats>::~Queue()
+{
+    this->destroyNodes();
+}
+
+template<typename T, typename Alloc, typename Stats>
+Queue<T, Alloc, Stats>& Queue<T, Alloc, Stats>::operator=(const Queue& other)
 {
     if(this == &other){
         return *this;
     }
 
-    Queue<T> temp(other);
-    std::swap(temp.m_front, m_front);
-    std::swap(temp.m_rear, m_rear);
-    std::swap(temp.m_size, m_size);
+    constexpr bool propagate = NodeTraits::propagate_on_container_copy_assignment::value;
+    if constexpr(REUSE_NODES){
+        if(!propagate || m_alloc == other.m_alloc){ //this's nodes can hold the copy
+            this->assignNodes(other);
+            return *this;
+        }
+    }
+    Queue temp(other, propagate ? other.getAllocator() : this->getAllocator());
+    this->swapNodes(temp);
+    if(propagate){
+        std::swap(temp.m_alloc, m_alloc);
+    }
+    this->counters().onAllocate(m_size); //temp counted the copy, this is where it ended up
+    this->counters().onPush(m_size, m_size);
         /*  Uses c'tor for temp
          *  swaps pointers of the list and size of temp with this's
          *  when temp gets out of scope, it's d'tor will be called and destroy this's list
+         *  (with the allocator this's list was allocated with)
          * 
-         * if c'tor fails, memory cleans itself and throws bad_alloc to whoever called this function
+         * if c'tor fails, memory cleans itself and throws to whoever called this function
          */
     return *this;
 }
 
-template<typename T>
-void Queue<T>::pushBack(const T& val)
+template<typename T, typename Alloc, typename Stats>
+Queue<T, Alloc, Stats>& Queue<T, Alloc, Stats>::operator=(Queue&& other)
+    noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value)
+{
+    if(this == &other){
+        return *this;
+    }
+
+    if(NodeTraits::propagate_on_container_move_assignment::value){
+        this->swapNodes(other);
+        std::swap(other.m_alloc, m_alloc);
+    }
+    else if(m_alloc == other.m_alloc){
+        this->swapNodes(other);
+    }
+    else{ //this's allocator can't free other's nodes, moving element by element
+        Queue temp(this->getAllocator());
+        for(T& data : other){
+            temp.pushBack(std::move(data));
+        }
+        this->swapNodes(temp);
+    }
+    other.destroyNodes();
+        /*  swaps the lists, this takes other's nodes in O(1) and other holds this's old nodes,
+         *  which are destroyed right away with the allocator they came from, so other is left empty
+         */
+    return *this;
+}
+
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::pushBack(const T& val)
+{
+    this->emplaceBack(val);
+}
+
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::pushBack(T&& val)
+{
+    this->emplaceBack(std::move(val));
+}
+
+template<typename T, typename Alloc, typename Stats>
+template<typename... Args>
+T& Queue<T, Alloc, Stats>::emplaceBack(Args&&... args)
 {
-    Node* temp = new Node(val);
+    Node* temp = this->createNode(std::forward<Args>(args)...); //the only allocation of the push
     if(m_size == 0){ //if queue is empty, front=rear
         m_front = m_rear = temp;
         m_size++;
@@ -256,10 +527,96 @@ void Queue<T>::pushBack(const T& val)
         m_rear = temp;
         m_size++;
     }
+    this->counters().onPush(1, m_size);
+    return temp->data;
 }
 
-template<typename T>
-T& Queue<T>::front()
+template<typename T, typename Alloc, typename Stats>
+template<typename InputIt, typename>
+void Queue<T, Alloc, Stats>::pushBack(InputIt first, InputIt last)
+{
+    typedef typename std::iterator_traits<InputIt>::iterator_category Category;
+    if constexpr(std::is_base_of<std::forward_iterator_tag, Category>::value){
+        reserveRange(m_alloc, first, last, 0);
+    }
+
+    Node* chainFront = nullptr; //the new nodes, not linked to the queue yet
+    Node* chainRear = nullptr;
+    std::size_t count = 0;
+    try{
+        for(; first != last; ++first){
+            Node* temp = this->createNode(*first);
+            if(chainFront == nullptr){
+                chainFront = temp;
+            }
+            else{
+                chainRear->next = temp;
+            }
+            chainRear = temp;
+            count++;
+        }
+    } catch(...){ //the queue was never touched, only the new chain has to go
+        while(chainFront != nullptr){
+            Node* temp = chainFront;
+            chainFront = chainFront->next;
+            this->destroyNode(temp);
+        }
+        throw;
+    }
+
+    if(count == 0){
+        return;
+    }
+    if(m_size == 0){ //if queue is empty, the chain is the whole queue
+        m_front = chainFront;
+    }
+    else{ //linking the chain after the rear
+        m_rear->next = chainFront;
+    }
+    m_rear = chainRear;
+    m_size += count;
+    this->counters().onPush(count, m_size);
+}
+
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::append(Queue& other)
+{
+    if(this == &other || other.m_size == 0){
+        return;
+    }
+
+    if(!(m_alloc == other.m_alloc)){ //this's allocator can't free other's nodes, moving element by element
+        for(T& data : other){
+            this->pushBack(std::move(data));
+        }
+        other.counters().onPop(other.m_size);
+        other.destroyNodes();
+        return;
+    }
+
+    if(m_size == 0){ //if queue is empty, other's chain is the whole queue
+        m_front = other.m_front;
+    }
+    else{ //linking other's chain after the rear
+        m_rear->next = other.m_front;
+    }
+    m_rear = other.m_rear;
+    m_size += other.m_size;
+    this->counters().onPush(other.m_size, m_size);
+    other.counters().onPop(other.m_size);
+    other.m_front = nullptr;
+    other.m_rear = nullptr;
+    other.m_size = 0;
+}
+
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::splice(Queue&& other)
+{
+    this->append(other);
+}
+
+template<typename T, typename Alloc, typename Stats>
+T& Queue<T, Alloc, Stats>::front()
 {
     if(m_size == 0){ //operation is invalid on an empty queue
         throw EmptyQueue();
@@ -269,8 +626,8 @@ T& Queue<T>::front()
     }
 }
 
-template<typename T>
-const T& Queue<T>::front() const
+template<typename T, typename Alloc, typename Stats>
+const T& Queue<T, Alloc, Stats>::front() const
 {
     if(m_size == 0){ //operation is invalid on an empty queue
         throw EmptyQueue();
@@ -280,49 +637,287 @@ const T& Queue<T>::front() const
     }
 }
 
-template<typename T>
-void Queue<T>::popFront()
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::popFront()
 {
     if(m_size == 0){ //operation is invalid on an empty queue
+        this->counters().onEmptyPop();
         throw EmptyQueue();
     }
     else{
-        Node* temp = m_front;
-        m_front = m_front->next;
-        delete temp;
-        m_size--;
+        this->removeFront();
+    }
+}
+
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::popFront(std::size_t n)
+{
+    if(n > m_size){ //checked once for the whole batch
+        this->counters().onEmptyPop();
+        throw EmptyQueue();
+    }
+    for(std::size_t i = 0; i < n; i++){
+        this->removeFront();
+    }
+}
+
+template<typename T, typename Alloc, typename Stats>
+template<typename OutputIt>
+std::size_t Queue<T, Alloc, Stats>::drainTo(OutputIt out, std::size_t n)
+{
+    std::size_t count = n < m_size ? n : m_size;
+    for(std::size_t i = 0; i < count; i++){
+        *out = std::move(m_front->data);
+        ++out;
+        this->removeFront();
+    }
+    return count;
+}
+
+template<typename T, typename Alloc, typename Stats>
+bool Queue<T, Alloc, Stats>::empty() const
+{
+    return m_size == 0;
+}
+
+template<typename T, typename Alloc, typename Stats>
+T* Queue<T, Alloc, Stats>::tryFront()
+{
+    return m_size == 0 ? nullptr : &m_front->data;
+}
+
+template<typename T, typename Alloc, typename Stats>
+const T* Queue<T, Alloc, Stats>::tryFront() const
+{
+    return m_size == 0 ? nullptr : &m_front->data;
+}
+
+template<typename T, typename Alloc, typename Stats>
+std::optional<T> Queue<T, Alloc, Stats>::tryPop()
+{
+    if(m_size == 0){ //the common case for a polling consumer, no exception involved
+        this->counters().onEmptyPop();
+        return std::nullopt;
+    }
+    std::optional<T> result(std::move(m_front->data));
+    this->removeFront();
+    return result;
+}
+
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::removeFront() noexcept
+{
+    Node* temp = m_front;
+    m_front = m_front->next;
+    this->destroyNode(temp);
+    m_size--;
+    this->counters().onPop(1);
         /*
          *  saving m_front in temp
          *  advanding m_front, deleting temp and decreasing the size
          */
-    }
 }
 
-template<typename T>
-int Queue<T>::size() const
+template<typename T, typename Alloc, typename Stats>
+std::size_t Queue<T, Alloc, Stats>::size() const
 {
     return m_size;
 }
 
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::clear() noexcept
+{
+    this->destroyNodes();
+}
+
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::reserve(std::size_t count)
+{
+    if(count > m_size){
+        reserveNodes(m_alloc, count - m_size, 0);
+    }
+}
+
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::shrinkToFit()
+{
+    shrinkNodes(m_alloc, 0);
+}
+
+template<typename T, typename Alloc, typename Stats>
+Alloc Queue<T, Alloc, Stats>::getAllocator() const
+{
+    return Alloc(m_alloc);
+}
+
+template<typename T, typename Alloc, typename Stats>
+QueueStatsSnapshot Queue<T, Alloc, Stats>::stats() const
+{
+    return Stats::snapshot();
+}
+
+template<typename T, typename Alloc, typename Stats>
+template<typename... Args>
+typename Queue<T, Alloc, Stats>::Node* Queue<T, Alloc, Stats>::createNode(Args&&... args)
+{
+    Node* node = NodeTraits::allocate(m_alloc, 1);
+    this->counters().onAllocate(1);
+    if constexpr(std::is_nothrow_constructible<T, Args&&...>::value){
+        NodeTraits::construct(m_alloc, node, std::forward<Args>(args)...);
+        return node;
+    }
+    try{
+        NodeTraits::construct(m_alloc, node, std::forward<Args>(args)...);
+    } catch(...){ //c'tor of T failed, the storage goes back to the allocator
+        NodeTraits::deallocate(m_alloc, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::destroyNode(Node* node) noexcept
+{
+    if constexpr(!queue_detail::IsTriviallyDestroyed<Node, NodeAllocator>::value){
+        NodeTraits::destroy(m_alloc, node);
+    }
+    NodeTraits::deallocate(m_alloc, node, 1);
+}
+
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::destroyNodes() noexcept
+{
+    while(m_front != nullptr){
+        Node* temp = m_front;
+        m_front = m_front->next;
+        this->destroyNode(temp);
+    }
+    m_rear = nullptr;
+    m_size = 0;
+}
+
+template<typename T, typename Alloc, typename Stats>
+template<typename NodeAlloc>
+auto Queue<T, Alloc, Stats>::reserveNodes(NodeAlloc& alloc, std::size_t n, int) -> decltype(alloc.reserve(n), void())
+{
+    alloc.reserve(n);
+}
+
+template<typename T, typename Alloc, typename Stats>
+template<typename NodeAlloc, typename ForwardIt>
+auto Queue<T, Alloc, Stats>::reserveRange(NodeAlloc& alloc, ForwardIt first, ForwardIt last, int)
+    -> decltype(alloc.reserve(std::size_t()), void())
+{
+    alloc.reserve(static_cast<std::size_t>(std::distance(first, last)));
+}
+
+template<typename T, typename Alloc, typename Stats>
+template<typename NodeAlloc>
+auto Queue<T, Alloc, Stats>::shrinkNodes(NodeAlloc& alloc, int) -> decltype(alloc.shrinkToFit(), void())
+{
+    alloc.shrinkToFit();
+}
+
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::swapNodes(Queue& other) noexcept
+{
+    std::swap(other.m_front, m_front);
+    std::swap(other.m_rear, m_rear);
+    std::swap(other.m_size, m_size);
+}
+
+template<typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::assignNodes(const Queue& other)
+{
+    //the elements this has no node for, allocated into a chain of their own before anything changes
+    Node* extraFront = nullptr;
+    Node* extraRear = nullptr;
+    const Node* source = other.m_front;
+    if(other.m_size > m_size){
+        for(std::size_t i = 0; i < m_size; i++){
+            source = source->next;
+        }
+        try{
+            for(; source != nullptr; source = source->next){
+                Node* temp = this->createNode(source->data);
+                if(extraFront == nullptr){
+                    extraFront = temp;
+                }
+                else{
+                    extraRear->next = temp;
+                }
+                extraRear = temp;
+            }
+        } catch(...){ //an allocation failed, freeing the part of the chain already made
+            while(extraFront != nullptr){
+                Node* temp = extraFront;
+                extraFront = extraFront->next;
+                this->destroyNode(temp);
+            }
+            throw;
+        }
+        source = other.m_front;
+    }
+    if(other.m_size == 0){
+        this->destroyNodes();
+        return;
+    }
+
+    //overwriting the common prefix, then freeing the nodes of this beyond it
+    Node* target = m_front;
+    Node* last = nullptr;
+    for(; target != nullptr && source != nullptr; target = target->next, source = source->next){
+        target->data = source->data;
+        last = target;
+    }
+    while(target != nullptr){
+        Node* temp = target;
+        target = target->next;
+        this->destroyNode(temp);
+    }
+    if(last != nullptr){
+        last->next = nullptr;
+        m_rear = last;
+    }
+    else{
+        m_front = nullptr;
+        m_rear = nullptr;
+    }
+
+    if(extraFront != nullptr){ //the chain was allocated through m_alloc, it is linked as is
+        if(m_rear == nullptr){
+            m_front = extraFront;
+        }
+        else{
+            m_rear->next = extraFront;
+        }
+        m_rear = extraRear;
+    }
+    m_size = other.m_size;
+    this->counters().onPush(m_size, m_size); //counted like the copy c'tor, allocations by createNode
+}
+
 /**
  * @brief RawIterator template to support Iterator and ConstIterator classes
  * 
  * @tparam Type - type of queue
+ * @tparam Alloc - allocator of queue
+ * @tparam Stats - stats policy of queue
  * @tparam Modified_Type
  *      Type - normal iterator
  *      const Type - const iterator
  */
-template<typename Type>
+template<typename Type, typename Alloc, typename Stats>
 template<typename Modified_Type>
-class Queue<Type>::RawIterator {
+class Queue<Type, Alloc, Stats>::RawIterator {
 public:
     //allowing the use of ConstIterator with a non-const Queue by conversion
-    operator Queue<Type>::RawIterator<const Modified_Type>()
+    operator typename Queue<Type, Alloc, Stats>::template RawIterator<const Modified_Type>() const
     {
-        return Queue<Type>::RawIterator<const Modified_Type>(m_ptr, m_currentNode);
+        return typename Queue<Type, Alloc, Stats>::template RawIterator<const Modified_Type>(m_ptr, m_currentNode);
     }
 private:    
-    const Queue<Type>* m_ptr; //Pointer to the queue to be iterated
+    const Queue<Type, Alloc, Stats>* m_ptr; //Pointer to the queue to be iterated
     Node* m_currentNode; //Current node iterator points to in queue
 
     /**
@@ -331,15 +926,46 @@ private:
      * @param ptr - pointer to the queue to iterate
      * @param node - initial node to point to
      */
-    RawIterator(const Queue<Type>* ptr, Node* node) :
+    RawIterator(const Queue<Type, Alloc, Stats>* ptr, Node* node) :
         m_ptr(ptr),
         m_currentNode(node)
     { }
 
+    //throws InvalidOperation if the iterator points to the end, only asserts with QUEUE_UNCHECKED_ITERATORS
+    void checkNotEnd() const
+    {
+#if QUEUE_UNCHECKED_ITERATORS
+        assert(m_currentNode != nullptr);
+#else
+        if(m_currentNode == nullptr){
+            throw InvalidOperation();
+        }
+#endif
+    }
+
     //allows Queue to access private c'tor
-    friend class Queue<Type>;
+    friend class Queue<Type, Alloc, Stats>;
 public:
 
+    /**
+     * Standard iterator traits, RawIterator is a forward iterator
+     *
+     */
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::remove_const<Modified_Type>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Modified_Type* pointer;
+    typedef Modified_Type& reference;
+
+    /**
+     * @brief Constructs a singular iterator, that may only be assigned to or compared
+     *
+     */
+    RawIterator() :
+        m_ptr(nullptr),
+        m_currentNode(nullptr)
+    { }
+
     /**
      * Explicitly stating that we use default c'tor, d'tor and assignment operator
      * 
@@ -353,6 +979,7 @@ public:
      *  
      *  operator* when trying to dereference a node that's past the end
      *  operator++(prefix and postfix) when trying to increment a node that's past the end
+     *  with QUEUE_UNCHECKED_ITERATORS these are assertions instead
      */
     class InvalidOperation {};
     
@@ -365,12 +992,20 @@ public:
      */
     Modified_Type& operator*() const
     {
-        if(m_currentNode == nullptr){
-            throw InvalidOperation();
-        }
-        else{
-            return m_currentNode->data;
-        }
+        this->checkNotEnd();
+        return m_currentNode->data;
+    }
+
+    /**
+     * @brief Returns a pointer to the data the iterator currently points to
+     *
+     * @return
+     *      pointer if Iterator
+     *      const pointer if ConstIterator
+     */
+    Modified_Type* operator->() const
+    {
+        return &**this;
     }
 
     /**
@@ -380,13 +1015,9 @@ public:
      */
     RawIterator& operator++()
     {
-        if(m_currentNode == nullptr){ //invalid operation if iterator points to the end
-            throw InvalidOperation();
-        }
-        else{
-            m_currentNode = m_currentNode->next;
-            return *this;
-        }
+        this->checkNotEnd();
+        m_currentNode = m_currentNode->next;
+        return *this;
     }
 
     /**
@@ -396,26 +1027,34 @@ public:
      */
     RawIterator operator++(int)
     {
-        if(m_currentNode == nullptr){ //invalid operation if iterator points to the end
-            throw InvalidOperation();
-        }
-        else{
-            RawIterator result = *this;
-            m_currentNode = m_currentNode->next;
-            return result;
-        }
+        this->checkNotEnd();
+        RawIterator result = *this;
+        m_currentNode = m_currentNode->next;
+        return result;
     }
 
     /**
      * @brief Checks if 2 Iterators point to the same node
-     * 
+     *
      * @param other - Iterator to compare to
      * @return true if Iterators point to the same element
      * @return false if Iterators point to a different element
      */
+    bool operator==(const RawIterator& other) const
+    {
+        return m_currentNode == other.m_currentNode;
+    }
+
+    /**
+     * @brief Checks if 2 Iterators point to different nodes
+     * 
+     * @param other - Iterator to compare to
+     * @return true if Iterators point to a different element
+     * @return false if Iterators point to the same element
+     */
     bool operator!=(const RawIterator& other) const
     {
-        return !(m_currentNode == other.m_currentNode);
+        return !(*this == other);
     }
 };
 
@@ -0,0 +1,110 @@
+#ifndef QUEUE_ALGORITHMS_H
+#define QUEUE_ALGORITHMS_H
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/* Queue algorithms:
+ *      filter, transformInPlace and transform for every queue that iterates with begin() and end()
+ *      and grows with pushBack, written once instead of per backend
+ *      everything is constexpr, so they run at compile time on the queues that do (StaticQueue)
+ *      a queue that keeps its elements in an order of its own (PriorityQueue) has its own overloads,
+ *      they are more specialized and win over these
+ */
+namespace queue_detail {
+
+//an empty queue allocating like queue, through select_on_container_copy_construction of its allocator
+template<typename QueueType>
+constexpr auto emptyLike(const QueueType& queue, int)
+    -> decltype(QueueType(std::allocator_traits<std::decay_t<decltype(queue.getAllocator())>>::
+                              select_on_container_copy_construction(queue.getAllocator())))
+{
+    using AllocTraits = std::allocator_traits<std::decay_t<decltype(queue.getAllocator())>>;
+    return QueueType(AllocTraits::select_on_container_copy_construction(queue.getAllocator()));
+}
+
+//an empty queue for queues without an allocator
+template<typename QueueType>
+constexpr auto emptyLike(const QueueType&, long) -> decltype(QueueType())
+{
+    return QueueType();
+}
+
+//the element type of QueueType when its elements can be changed through begin(), otherwise SFINAE out
+template<typename QueueType>
+using MutableElement = std::enable_if_t<
+    !std::is_const<std::remove_reference_t<decltype(*std::declval<QueueType&>().begin())>>::value,
+    std::remove_reference_t<decltype(*std::declval<QueueType&>().begin())>>;
+
+} //namespace queue_detail
+
+/**
+ * @brief Filters a queue using a given predict
+ *
+ * @param queue - queue to filter through
+ * @param predict - predict to filter by
+ * @return - new filtered queue, of the same type and allocating like queue
+ */
+template<typename QueueType, typename FuncType>
+constexpr auto filter(const QueueType& queue, FuncType predict)
+    -> decltype(queue.end(), queue_detail::emptyLike(queue, 0).pushBack(*queue.begin()),
+                queue_detail::emptyLike(queue, 0))
+{
+    QueueType filtered = queue_detail::emptyLike(queue, 0);
+    for(const auto& data : queue)
+    {
+        if(predict(data)){
+            filtered.pushBack(data);
+        }
+    }
+    return filtered;
+}
+
+/**
+ * @brief Transforms a queue in-place according to a map, without any copy or allocation
+ *
+ *  basic guarantee: if transformer throws, the elements before the failing one are already transformed
+ *
+ * @param queue - queue to transform
+ * @param transformer - mapping operator
+ */
+template<typename QueueType, typename FuncType, typename T = queue_detail::MutableElement<QueueType>>
+constexpr auto transformInPlace(QueueType& queue, FuncType transformer)
+    -> decltype(queue.end(), transformer(std::declval<T&>()), void())
+{
+    for(T& data : queue)
+    {
+        transformer(data);
+    }
+}
+
+/**
+ * @brief Transforms a queue in-place according to a map
+ *
+ *  strong guarantee: if transformer throws, queue is left unchanged
+ *  a noexcept transformer can't fail midway, so it is applied in place with no copy at all,
+ *  otherwise the map is applied to a single copy that is then moved back into queue
+ *  (in O(1) for every queue that owns its storage on the heap)
+ *
+ * @param queue - queue to transform
+ * @param transformer - mapping operator
+ */
+template<typename QueueType, typename FuncType, typename T = queue_detail::MutableElement<QueueType>>
+constexpr auto transform(QueueType& queue, FuncType transformer)
+    -> decltype(queue.end(), transformer(std::declval<T&>()), queue = std::declval<QueueType>(), void())
+{
+    if constexpr(noexcept(transformer(std::declval<T&>()))){
+        transformInPlace(queue, transformer);
+    }
+    else{
+        QueueType transformed = queue; //making a temporary queue to operate on
+        for(T& data : transformed)
+        {
+            transformer(data);
+        }
+        queue = std::move(transformed); //stealing the transformed queue instead of copying it back
+    }
+}
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef QUEUE_CONFIG_H
+#define QUEUE_CONFIG_H
+
+/**
+ * @brief Unchecked iterator mode
+ *
+ *  when QUEUE_UNCHECKED_ITERATORS is 1, dereferencing or incrementing an end iterator is checked by assert
+ *  instead of throwing InvalidOperation, leaving range-for loops without a throwing branch per element
+ *  defaults to 1 in NDEBUG builds and to 0 otherwise, define it before including a queue header to override
+ */
+#ifndef QUEUE_UNCHECKED_ITERATORS
+#ifdef NDEBUG
+#define QUEUE_UNCHECKED_ITERATORS 1
+#else
+#define QUEUE_UNCHECKED_ITERATORS 0
+#endif
+#endif
+
+#endif
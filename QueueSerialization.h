@@ -0,0 +1,339 @@
+#ifndef QUEUE_SERIALIZATION_H
+#define QUEUE_SERIALIZATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+
+/* Queue serialization:
+ *      Binary snapshot of a queue of trivially copyable elements, for every backend
+ *      a snapshot is a SnapshotHeader followed by the elements as raw bytes, front to back
+ *      writing goes through forEachRun when the queue has it (RingQueue, SmallQueue, ChunkedQueue),
+ *      so every contiguous run is written at once, the elements of a Queue are gathered into
+ *      a staging buffer of SNAPSHOT_STAGING_BYTES first
+ *      reading appends every element with one bulk pushBack, which links a Queue's nodes in one pass
+ *      and grows a RingQueue once
+ *      a stream is read into a staging buffer first, a buffer holding elements aligned for T is pushed from directly,
+ *      otherwise its elements are copied to aligned storage first
+ *      the count in the header isn't trusted: a seekable stream must still hold count elements
+ *      before anything is allocated, a stream that can't seek is read SNAPSHOT_STAGING_BYTES at a time
+ *      into a buffer that only grows as the elements actually arrive
+ *
+ *  the byte order, alignment and size of T are the ones of the machine that wrote the snapshot,
+ *  a snapshot is meant to be read back by the same program, elementSize only catches a changed T
+ */
+
+//first bytes of every snapshot, "QSNP" in little endian
+constexpr std::uint32_t SNAPSHOT_MAGIC = 0x504E5351;
+
+//format version written into new snapshots
+constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+
+//size of the buffer a queue without contiguous runs is gathered into before writing
+constexpr std::size_t SNAPSHOT_STAGING_BYTES = 64 * 1024;
+
+/**
+ * @brief Header in front of the elements of a snapshot
+ *
+ */
+struct SnapshotHeader {
+    std::uint32_t magic; //SNAPSHOT_MAGIC
+    std::uint32_t version; //SNAPSHOT_VERSION
+    std::uint64_t elementSize; //sizeof(T) of the writer
+    std::uint64_t count; //amount of elements following the header
+};
+
+/**
+ * @brief Exception Class to deal with reading something that isn't a valid snapshot for the queue
+ *
+ *  thrown by deserialize on: a wrong magic or version, a different element size, a truncated snapshot
+ */
+class InvalidSnapshot {};
+
+namespace queue_detail {
+
+//element type of a queue, found through its ConstIterator
+template<typename QueueType>
+struct SnapshotElement {
+    typedef decltype(*std::declval<const QueueType&>().begin()) Reference;
+    typedef typename std::remove_cv<typename std::remove_reference<Reference>::type>::type type;
+    static_assert(std::is_trivially_copyable<type>::value, "snapshots need trivially copyable elements");
+};
+
+//raw, uninitialized storage for count elements, the elements are created by memcpy
+template<typename T>
+class SnapshotBuffer {
+public:
+    explicit SnapshotBuffer(std::size_t count) :
+        m_data(count == 0 ? nullptr : std::allocator<T>().allocate(count)),
+        m_count(count)
+    { }
+
+    ~SnapshotBuffer()
+    {
+        if(m_data != nullptr){
+            std::allocator<T>().deallocate(m_data, m_count);
+        }
+    }
+
+    //reallocates the buffer to room for count elements, keeping the first kept ones
+    void resize(std::size_t count, std::size_t kept)
+    {
+        T* data = std::allocator<T>().allocate(count);
+        if(kept > 0){
+            std::memcpy(static_cast<void*>(data), static_cast<const void*>(m_data), kept * sizeof(T));
+        }
+        if(m_data != nullptr){
+            std::allocator<T>().deallocate(m_data, m_count);
+        }
+        m_data = data;
+        m_count = count;
+    }
+
+    SnapshotBuffer(const SnapshotBuffer&) = delete;
+    SnapshotBuffer& operator=(const SnapshotBuffer&) = delete;
+
+    T* data() const noexcept
+    {
+        return m_data;
+    }
+
+private:
+    T* m_data; //storage of m_count elements
+    std::size_t m_count; //amount of elements m_data has room for
+};
+
+inline SnapshotHeader makeHeader(std::size_t elementSize, std::size_t count)
+{
+    return SnapshotHeader{SNAPSHOT_MAGIC, SNAPSHOT_VERSION, elementSize, count};
+}
+
+//throws InvalidSnapshot unless header describes elements of elementSize bytes
+inline void checkHeader(const SnapshotHeader& header, std::size_t elementSize)
+{
+    if(header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION || header.elementSize != elementSize){
+        throw InvalidSnapshot();
+    }
+}
+
+//hands the elements to write(bytes, size) a contiguous run at a time, queue has forEachRun
+template<typename QueueType, typename Writer>
+auto writeElements(const QueueType& queue, Writer& write, int) -> decltype(queue.forEachRun(nullptr), void())
+{
+    typedef typename SnapshotElement<QueueType>::type T;
+    queue.forEachRun([&write](const T* data, std::size_t count){
+        write(static_cast<const void*>(data), count * sizeof(T));
+    });
+}
+
+//hands the elements to write(bytes, size) gathered into a staging buffer, for queues without contiguous runs
+template<typename QueueType, typename Writer>
+void writeElements(const QueueType& queue, Writer& write, long)
+{
+    typedef typename SnapshotElement<QueueType>::type T;
+    constexpr std::size_t capacity = SNAPSHOT_STAGING_BYTES / sizeof(T) > 0 ? SNAPSHOT_STAGING_BYTES / sizeof(T) : 1;
+    SnapshotBuffer<T> staging(capacity);
+    std::size_t staged = 0;
+    for(const T& data : queue){
+        std::memcpy(static_cast<void*>(staging.data() + staged), static_cast<const void*>(&data), sizeof(T));
+        if(++staged == capacity){
+            write(static_cast<const void*>(staging.data()), staged * sizeof(T));
+            staged = 0;
+        }
+    }
+    if(staged > 0){
+        write(static_cast<const void*>(staging.data()), staged * sizeof(T));
+    }
+}
+
+//amount of bytes left in a seekable stream, -1 if the stream can't seek
+//a failed seek leaves the stream readable from where it was, with the state flags it had
+inline std::streamoff remainingBytes(std::istream& in)
+{
+    std::ios::iostate state = in.rdstate();
+    std::streampos position = in.tellg();
+    if(position == std::streampos(-1)){
+        in.clear(state);
+        return -1;
+    }
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    if(!in || end == std::streampos(-1)){ //tells its position but can't seek to the end, nothing was moved
+        in.clear(state);
+        return -1;
+    }
+    in.seekg(position);
+    if(!in){ //the elements can't be reached again
+        throw InvalidSnapshot();
+    }
+    return end - position;
+}
+
+//reads count elements into elements, growing it only as fast as the stream delivers them
+//throws InvalidSnapshot if the stream ends first
+template<typename T>
+void readElements(std::istream& in, SnapshotBuffer<T>& elements, std::size_t count)
+{
+    if(count == 0){
+        return;
+    }
+    std::streamoff remaining = remainingBytes(in);
+    if(remaining >= 0){ //the whole snapshot has to be there before it is allocated
+        if(count > static_cast<std::uint64_t>(remaining) / sizeof(T)){
+            throw InvalidSnapshot();
+        }
+        elements.resize(count, 0);
+        if(!in.read(reinterpret_cast<char*>(elements.data()), static_cast<std::streamsize>(count * sizeof(T)))){
+            throw InvalidSnapshot();
+        }
+        return;
+    }
+
+    constexpr std::size_t chunk = SNAPSHOT_STAGING_BYTES / sizeof(T) > 0 ? SNAPSHOT_STAGING_BYTES / sizeof(T) : 1;
+    std::size_t capacity = 0;
+    std::size_t read = 0;
+    while(read < count){
+        std::size_t wanted = count - read < chunk ? count - read : chunk;
+        if(read + wanted > capacity){ //doubling, but never beyond count
+            std::size_t grown = capacity * 2 > read + wanted ? capacity * 2 : read + wanted;
+            elements.resize(grown < count ? grown : count, read);
+            capacity = grown < count ? grown : count;
+        }
+        if(!in.read(reinterpret_cast<char*>(elements.data() + read), static_cast<std::streamsize>(wanted * sizeof(T)))){
+            throw InvalidSnapshot();
+        }
+        read += wanted;
+    }
+}
+
+} //namespace queue_detail
+
+/**
+ * @brief Returns the amount of bytes serialize writes for a queue
+ *
+ * @param queue - queue of trivially copyable elements
+ * @return - size of the snapshot of queue
+ */
+template<typename QueueType>
+std::size_t serializedSize(const QueueType& queue)
+{
+    typedef typename queue_detail::SnapshotElement<QueueType>::type T;
+    return sizeof(SnapshotHeader) + queue.size() * sizeof(T);
+}
+
+/**
+ * @brief Writes a snapshot of the queue into a stream, the queue is unchanged
+ *
+ * @param queue - queue of trivially copyable elements
+ * @param out - binary stream to write to, its exception mask decides how write errors are reported
+ */
+template<typename QueueType>
+void serialize(const QueueType& queue, std::ostream& out)
+{
+    typedef typename queue_detail::SnapshotElement<QueueType>::type T;
+    SnapshotHeader header = queue_detail::makeHeader(sizeof(T), queue.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    auto write = [&out](const void* bytes, std::size_t size){
+        out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+    };
+    queue_detail::writeElements(queue, write, 0);
+}
+
+/**
+ * @brief Writes a snapshot of the queue into a buffer, the queue is unchanged
+ *
+ * @param queue - queue of trivially copyable elements
+ * @param buffer - at least serializedSize(queue) bytes, no alignment needed
+ * @return - amount of bytes written
+ */
+template<typename QueueType>
+std::size_t serialize(const QueueType& queue, void* buffer)
+{
+    typedef typename queue_detail::SnapshotElement<QueueType>::type T;
+    SnapshotHeader header = queue_detail::makeHeader(sizeof(T), queue.size());
+    unsigned char* position = static_cast<unsigned char*>(buffer);
+    std::memcpy(position, &header, sizeof(header));
+    position += sizeof(header);
+    auto write = [&position](const void* bytes, std::size_t size){
+        std::memcpy(position, bytes, size);
+        position += size;
+    };
+    queue_detail::writeElements(queue, write, 0);
+    return static_cast<std::size_t>(position - static_cast<unsigned char*>(buffer));
+}
+
+/**
+ * @brief Reads a snapshot from a stream and appends its elements to the back of the queue
+ *
+ *  strong guarantee: on InvalidSnapshot or an exception from the queue, the queue is left unchanged
+ *
+ * @param queue - queue the snapshot was written from, or any queue of the same element type
+ * @param in - binary stream positioned at the start of a snapshot, left after its end
+ * @return - amount of elements appended
+ */
+template<typename QueueType>
+std::size_t deserialize(QueueType& queue, std::istream& in)
+{
+    typedef typename queue_detail::SnapshotElement<QueueType>::type T;
+    SnapshotHeader header;
+    if(!in.read(reinterpret_cast<char*>(&header), sizeof(header))){
+        throw InvalidSnapshot();
+    }
+    queue_detail::checkHeader(header, sizeof(T));
+    if(header.count > static_cast<std::size_t>(-1) / sizeof(T)){ //can't be a snapshot this machine wrote
+        throw InvalidSnapshot();
+    }
+
+    std::size_t count = static_cast<std::size_t>(header.count);
+    queue_detail::SnapshotBuffer<T> elements(0);
+    queue_detail::readElements(in, elements, count);
+    queue.pushBack(elements.data(), elements.data() + count);
+    return count;
+}
+
+/**
+ * @brief Reads a snapshot from a buffer and appends its elements to the back of the queue
+ *
+ *  strong guarantee: on InvalidSnapshot or an exception from the queue, the queue is left unchanged
+ *
+ * @param queue - queue the snapshot was written from, or any queue of the same element type
+ * @param buffer - snapshot written by serialize, no alignment needed, aligned elements save a copy
+ * @param size - amount of bytes in buffer
+ * @return - amount of bytes the snapshot took up in buffer
+ */
+template<typename QueueType>
+std::size_t deserialize(QueueType& queue, const void* buffer, std::size_t size)
+{
+    typedef typename queue_detail::SnapshotElement<QueueType>::type T;
+    SnapshotHeader header;
+    if(size < sizeof(header)){
+        throw InvalidSnapshot();
+    }
+    std::memcpy(&header, buffer, sizeof(header));
+    queue_detail::checkHeader(header, sizeof(T));
+    if(header.count > (size - sizeof(header)) / sizeof(T)){ //truncated, checked without overflowing
+        throw InvalidSnapshot();
+    }
+
+    std::size_t count = static_cast<std::size_t>(header.count);
+    const unsigned char* bytes = static_cast<const unsigned char*>(buffer) + sizeof(header);
+    if(reinterpret_cast<std::uintptr_t>(bytes) % alignof(T) == 0){ //pushed straight from the buffer
+        const T* first = reinterpret_cast<const T*>(bytes);
+        queue.pushBack(first, first + count);
+        return sizeof(header) + count * sizeof(T);
+    }
+
+    //copied to aligned storage, buffer may start anywhere
+    queue_detail::SnapshotBuffer<T> elements(count);
+    if(count > 0){
+        std::memcpy(static_cast<void*>(elements.data()), bytes, count * sizeof(T));
+    }
+    queue.pushBack(elements.data(), elements.data() + count);
+    return sizeof(header) + count * sizeof(T);
+}
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef QUEUE_STATS_H
+#define QUEUE_STATS_H
+
+#include <atomic>
+#include <cstddef>
+#include "CacheLine.h"
+
+/**
+ * @brief Counters of a queue at one point in time, returned by stats()
+ *
+ */
+struct QueueStatsSnapshot {
+    std::size_t pushes; //elements inserted
+    std::size_t pops; //elements removed from the front
+    std::size_t emptyPops; //pops that found the queue empty, thrown EmptyQueue included
+    std::size_t highWater; //biggest size the queue ever had
+    std::size_t allocations; //calls into the allocator for element storage
+};
+
+/* Stats policies:
+ *      template parameter of the queues that decides what their operations count
+ *      every hook is called right after the operation took effect, with the size the queue has then
+ *      NoStats - counts nothing, every hook is an empty inline function and the policy takes no space
+ *      QueueStats - plain counters, for queues used by a single thread at a time
+ *      AtomicQueueStats - relaxed atomic counters, for queues shared between threads
+ *
+ *  a queue starts with zeroed counters, copying or moving a queue doesn't carry them over
+ *  a copy, constructed or assigned, counts the copied elements as pushes and the nodes it allocated for them
+ */
+class NoStats {
+public:
+    void onPush(std::size_t, std::size_t) noexcept {}
+    void onPop(std::size_t) noexcept {}
+    void onEmptyPop() noexcept {}
+    void onAllocate(std::size_t) noexcept {}
+
+    QueueStatsSnapshot snapshot() const noexcept
+    {
+        return QueueStatsSnapshot{0, 0, 0, 0, 0};
+    }
+};
+
+class QueueStats {
+public:
+    QueueStats() noexcept :
+        m_stats{0, 0, 0, 0, 0}
+    { }
+
+    //count elements were pushed and the queue now holds size elements
+    void onPush(std::size_t count, std::size_t size) noexcept
+    {
+        m_stats.pushes += count;
+        if(size > m_stats.highWater){
+            m_stats.highWater = size;
+        }
+    }
+
+    void onPop(std::size_t count) noexcept
+    {
+        m_stats.pops += count;
+    }
+
+    void onEmptyPop() noexcept
+    {
+        m_stats.emptyPops++;
+    }
+
+    void onAllocate(std::size_t count) noexcept
+    {
+        m_stats.allocations += count;
+    }
+
+    QueueStatsSnapshot snapshot() const noexcept
+    {
+        return m_stats;
+    }
+
+private:
+    QueueStatsSnapshot m_stats; //counters so far
+};
+
+class AtomicQueueStats {
+public:
+    AtomicQueueStats() noexcept :
+        m_pushes(0),
+        m_highWater(0),
+        m_allocations(0),
+        m_pops(0),
+        m_emptyPops(0)
+    { }
+
+    //size may be stale as soon as it was read, the high-water mark is a lower bound of the true peak
+    void onPush(std::size_t count, std::size_t size) noexcept
+    {
+        m_pushes.fetch_add(count, std::memory_order_relaxed);
+        std::size_t peak = m_highWater.load(std::memory_order_relaxed);
+        while(size > peak && !m_highWater.compare_exchange_weak(peak, size, std::memory_order_relaxed)){ }
+    }
+
+    void onPop(std::size_t count) noexcept
+    {
+        m_pops.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void onEmptyPop() noexcept
+    {
+        m_emptyPops.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void onAllocate(std::size_t count) noexcept
+    {
+        m_allocations.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    //every counter is read on its own, under concurrent use they may come from slightly different moments
+    QueueStatsSnapshot snapshot() const noexcept
+    {
+        return QueueStatsSnapshot{m_pushes.load(std::memory_order_relaxed), m_pops.load(std::memory_order_relaxed),
+                                  m_emptyPops.load(std::memory_order_relaxed),
+                                  m_highWater.load(std::memory_order_relaxed),
+                                  m_allocations.load(std::memory_order_relaxed)};
+    }
+
+private:
+    //producer and consumer counters on different lines, so counting doesn't add sharing between the two sides
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_pushes; //written by producers
+    std::atomic<std::size_t> m_highWater; //written by producers
+    std::atomic<std::size_t> m_allocations; //written by producers
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_pops; //written by consumers
+    std::atomic<std::size_t> m_emptyPops; //written by consumers
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef QUEUE_TRAITS_H
+#define QUEUE_TRAITS_H
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/* Queue traits:
+ *      decide when a queue may copy and destroy its elements as raw memory instead of one by one
+ *      std::allocator_traits::construct and destroy only go through the allocator when it has its own
+ *      construct and destroy members, otherwise they are placement new and ~T, which for a trivially copyable
+ *      (trivially destructible) T are a memcpy (nothing at all)
+ *      std::allocator still declares deprecated members that do exactly that, so it is always treated as plain
+ */
+namespace queue_detail {
+
+//true_type when Alloc has its own construct(T*, const T&)
+template<typename Alloc, typename T>
+auto hasConstruct(int) -> decltype(std::declval<Alloc&>().construct(std::declval<T*>(), std::declval<const T&>()),
+                                   std::true_type());
+template<typename Alloc, typename T>
+std::false_type hasConstruct(long);
+
+//true_type when Alloc has its own destroy(T*)
+template<typename Alloc, typename T>
+auto hasDestroy(int) -> decltype(std::declval<Alloc&>().destroy(std::declval<T*>()), std::true_type());
+template<typename Alloc, typename T>
+std::false_type hasDestroy(long);
+
+//true when copying an element constructed through Alloc is a memcpy
+template<typename T, typename Alloc>
+struct IsBitwiseCopyable : std::integral_constant<bool, std::is_trivially_copyable<T>::value &&
+                                                        (std::is_same<Alloc, std::allocator<T>>::value ||
+                                                         !decltype(hasConstruct<Alloc, T>(0))::value)> {};
+
+//true when destroying an element constructed through Alloc does nothing
+template<typename T, typename Alloc>
+struct IsTriviallyDestroyed : std::integral_constant<bool, std::is_trivially_destructible<T>::value &&
+                                                           (std::is_same<Alloc, std::allocator<T>>::value ||
+                                                            !decltype(hasDestroy<Alloc, T>(0))::value)> {};
+
+} //namespace queue_detail
+
+#endif
@@ -0,0 +1,343 @@
+#ifndef QUEUE_VIEW_H
+#define QUEUE_VIEW_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/* Lazy views:
+ *      Read-only adapters over the ConstIterator of a queue (Queue, RingQueue, ChunkedQueue, ...)
+ *      that compose with operator| and do no work until they are iterated:
+ *
+ *          for(int x : queue | filtered(isEven) | mapped(square)) { ... }
+ *          Queue<int> result = collect<Queue<int>>(queue | filtered(isEven) | mapped(square));
+ *
+ *      a chain of views is a single pass over the queue with no intermediate queue
+ *      a view refers to the queue it was built from, the queue has to outlive it
+ *      a view built on top of another view holds a copy of it, so temporaries in a chain are safe
+ */
+
+//marks the views of this header, a view is copied into the view built on top of it
+struct QueueViewBase {};
+
+/**
+ * @brief View of a whole container, the bottom of every chain of views
+ *
+ * @tparam Container - container with ConstIterator begin() const and end() const
+ */
+template<class Container>
+class ContainerView : public QueueViewBase {
+public:
+    typedef typename Container::ConstIterator Iterator;
+
+    /**
+     * @brief Construct a new ContainerView
+     *
+     * @param container - container to view, has to outlive the view
+     */
+    explicit ContainerView(const Container& container) :
+        m_container(&container)
+    { }
+
+    Iterator begin() const
+    {
+        return m_container->begin();
+    }
+
+    Iterator end() const
+    {
+        return m_container->end();
+    }
+
+private:
+    const Container* m_container; //viewed container
+};
+
+/**
+ * @brief Type a range is held as inside a view: views are held by value, containers through a ContainerView
+ *
+ */
+template<class Range>
+struct ViewOf {
+    typedef typename std::conditional<std::is_base_of<QueueViewBase, Range>::value,
+                                      Range, ContainerView<Range>>::type type;
+};
+
+/**
+ * @brief View of the elements of Base for which Predicate returns true
+ *
+ * @tparam Base - view to filter
+ * @tparam Predicate - predict to filter by
+ */
+template<class Base, class Predicate>
+class FilterView : public QueueViewBase {
+private:
+    typedef decltype(std::declval<const Base&>().begin()) BaseIterator;
+
+public:
+    class Iterator;
+
+    /**
+     * @brief Construct a new FilterView
+     *
+     * @param base - view to filter
+     * @param predicate - predict to filter by
+     */
+    FilterView(Base base, Predicate predicate) :
+        m_base(std::move(base)),
+        m_predicate(std::move(predicate))
+    { }
+
+    /**
+     * @brief Returns an Iterator to the first element that passes the predict
+     */
+    Iterator begin() const
+    {
+        return Iterator(this, this->skip(m_base.begin()));
+    }
+
+    /**
+     * @brief Returns an Iterator beyond the last element
+     */
+    Iterator end() const
+    {
+        return Iterator(this, m_base.end());
+    }
+
+private:
+    //advances iter to the first element that passes the predict, or to the end
+    BaseIterator skip(BaseIterator iter) const
+    {
+        BaseIterator last = m_base.end();
+        while(iter != last && !m_predicate(*iter)){
+            ++iter;
+        }
+        return iter;
+    }
+
+    Base m_base; //filtered view
+    mutable Predicate m_predicate; //mutable so stateful predicts can be used
+};
+
+/**
+ * @brief Iterator of a FilterView, yields the elements of the base view
+ *
+ */
+template<class Base, class Predicate>
+class FilterView<Base, Predicate>::Iterator {
+public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef typename std::iterator_traits<BaseIterator>::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::iterator_traits<BaseIterator>::pointer pointer;
+    typedef typename std::iterator_traits<BaseIterator>::reference reference;
+
+    reference operator*() const
+    {
+        return *m_current;
+    }
+
+    Iterator& operator++()
+    {
+        m_current = m_view->skip(++m_current);
+        return *this;
+    }
+
+    Iterator operator++(int)
+    {
+        Iterator result = *this;
+        ++*this;
+        return result;
+    }
+
+    bool operator==(const Iterator& other) const
+    {
+        return !(m_current != other.m_current);
+    }
+
+    bool operator!=(const Iterator& other) const
+    {
+        return m_current != other.m_current;
+    }
+
+private:
+    Iterator(const FilterView* view, BaseIterator current) :
+        m_view(view),
+        m_current(current)
+    { }
+
+    const FilterView* m_view; //view being iterated, holds the predict
+    BaseIterator m_current; //current element in the base view
+
+    //allows FilterView to access private c'tor
+    friend class FilterView<Base, Predicate>;
+};
+
+/**
+ * @brief View of the results of Function applied to every element of Base
+ *
+ * @tparam Base - view to map
+ * @tparam Function - mapping operator, called with an element and returning the mapped value
+ */
+template<class Base, class Function>
+class MapView : public QueueViewBase {
+private:
+    typedef decltype(std::declval<const Base&>().begin()) BaseIterator;
+
+public:
+    class Iterator;
+
+    /**
+     * @brief Construct a new MapView
+     *
+     * @param base - view to map
+     * @param function - mapping operator
+     */
+    MapView(Base base, Function function) :
+        m_base(std::move(base)),
+        m_function(std::move(function))
+    { }
+
+    /**
+     * @brief Returns an Iterator to the first mapped element
+     */
+    Iterator begin() const
+    {
+        return Iterator(this, m_base.begin());
+    }
+
+    /**
+     * @brief Returns an Iterator beyond the last mapped element
+     */
+    Iterator end() const
+    {
+        return Iterator(this, m_base.end());
+    }
+
+private:
+    Base m_base; //mapped view
+    mutable Function m_function; //mutable so stateful mapping operators can be used
+};
+
+/**
+ * @brief Iterator of a MapView, yields mapped values by value, computed on every dereference
+ *
+ */
+template<class Base, class Function>
+class MapView<Base, Function>::Iterator {
+public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef decltype(std::declval<Function&>()(*std::declval<BaseIterator&>())) reference;
+    typedef typename std::decay<reference>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef void pointer;
+
+    reference operator*() const
+    {
+        return m_view->m_function(*m_current);
+    }
+
+    Iterator& operator++()
+    {
+        ++m_current;
+        return *this;
+    }
+
+    Iterator operator++(int)
+    {
+        Iterator result = *this;
+        ++m_current;
+        return result;
+    }
+
+    bool operator==(const Iterator& other) const
+    {
+        return !(m_current != other.m_current);
+    }
+
+    bool operator!=(const Iterator& other) const
+    {
+        return m_current != other.m_current;
+    }
+
+private:
+    Iterator(const MapView* view, BaseIterator current) :
+        m_view(view),
+        m_current(current)
+    { }
+
+    const MapView* m_view; //view being iterated, holds the mapping operator
+    BaseIterator m_current; //current element in the base view
+
+    //allows MapView to access private c'tor
+    friend class MapView<Base, Function>;
+};
+
+//right hand side of queue | filtered(predict)
+template<class Predicate>
+struct FilterAdaptor {
+    Predicate predicate;
+};
+
+//right hand side of queue | mapped(function)
+template<class Function>
+struct MapAdaptor {
+    Function function;
+};
+
+/**
+ * @brief Lazily filters a queue or view, used as queue | filtered(predict)
+ *
+ * @param predicate - predict to filter by
+ */
+template<class Predicate>
+FilterAdaptor<Predicate> filtered(Predicate predicate)
+{
+    return FilterAdaptor<Predicate>{std::move(predicate)};
+}
+
+/**
+ * @brief Lazily maps a queue or view, used as queue | mapped(function)
+ *
+ * @param function - mapping operator
+ */
+template<class Function>
+MapAdaptor<Function> mapped(Function function)
+{
+    return MapAdaptor<Function>{std::move(function)};
+}
+
+template<class Range, class Predicate>
+FilterView<typename ViewOf<Range>::type, Predicate> operator|(const Range& range, FilterAdaptor<Predicate> adaptor)
+{
+    return FilterView<typename ViewOf<Range>::type, Predicate>(typename ViewOf<Range>::type(range),
+                                                               std::move(adaptor.predicate));
+}
+
+template<class Range, class Function>
+MapView<typename ViewOf<Range>::type, Function> operator|(const Range& range, MapAdaptor<Function> adaptor)
+{
+    return MapView<typename ViewOf<Range>::type, Function>(typename ViewOf<Range>::type(range),
+                                                           std::move(adaptor.function));
+}
+
+/**
+ * @brief Materializes a view (or copies any range) into a new container, in a single pass
+ *
+ * @tparam Container - container to build, needs pushBack
+ * @param range - view to materialize
+ * @return - new container holding the elements of range
+ */
+template<class Container, class Range>
+Container collect(const Range& range)
+{
+    Container result;
+    for(auto&& data : range)
+    {
+        result.pushBack(std::forward<decltype(data)>(data));
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,596 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "QueueConfig.h"
+#include "QueueTraits.h"
+
+/* RingBuffer:
+ *      the growable circular buffer under RingQueue and SmallQueue, and the iterator walking it
+ *      the capacity is always a power of 2 (or 0), wrapping an index is a mask
+ *      InlineCapacity slots live inside the object and hold the elements until a push overflows them,
+ *      without inline slots (RingQueue) there is no buffer at all until the first push
+ *      a full buffer doubles on the heap, the elements are moved and unwrapped to slot 0 and on
+ *      for a trivially copyable T copies, relocations and pushes of a pointer range are memcpy calls,
+ *      and clearing or destroying trivially destructible elements never walks them
+ *
+ *  the queues derive from it privately and keep their interface, copying, moving and EmptyQueue to themselves
+ */
+namespace queue_detail {
+
+//rounds capacity up to a power of 2
+constexpr std::size_t roundCapacity(std::size_t capacity)
+{
+    std::size_t rounded = 1;
+    while(rounded < capacity){
+        rounded *= 2;
+    }
+    return rounded;
+}
+
+//uninitialized slots for Capacity elements inside the object
+template<class T, std::size_t Capacity>
+class InlineSlots {
+private:
+    alignas(T) unsigned char m_inline[sizeof(T) * Capacity]; //inline slots, used until the first spill
+
+protected:
+    T* inlineData() noexcept
+    {
+        return reinterpret_cast<T*>(m_inline);
+    }
+
+    const T* inlineData() const noexcept
+    {
+        return reinterpret_cast<const T*>(m_inline);
+    }
+};
+
+//no inline slots, the buffer is nullptr while it isn't allocated
+template<class T>
+class InlineSlots<T, 0> {
+protected:
+    T* inlineData() noexcept
+    {
+        return nullptr;
+    }
+
+    const T* inlineData() const noexcept
+    {
+        return nullptr;
+    }
+};
+
+/* RingIterator:
+ *      Iterator class of the circular buffers that supports both const iteration and normal iteration
+ *      requires a template that decides which type of iteration to do
+ *      for normal iteration: Modified_Type is the element type
+ *      for const iteration: Modified_Type is the const element type
+ */
+template<typename Modified_Type>
+class RingIterator;
+
+/**
+ * @brief Growable circular buffer of elements of T, allocated by Alloc
+ *
+ * @tparam T - type of the elements
+ * @tparam Alloc - allocator of the heap buffer
+ * @tparam InlineCapacity - amount of slots inside the object, 0 or a power of 2
+ */
+template<class T, class Alloc, std::size_t InlineCapacity>
+class RingBuffer : protected InlineSlots<T, InlineCapacity> {
+    static_assert(InlineCapacity == roundCapacity(InlineCapacity) || InlineCapacity == 0,
+                  "InlineCapacity must be 0 or a power of 2");
+protected:
+    typedef std::allocator_traits<Alloc> AllocTraits;
+
+    //capacity of the buffer allocated by the first push when there are no inline slots
+    static constexpr std::size_t INITIAL_CAPACITY = 16;
+
+    //true when elements are copied as raw memory
+    static constexpr bool BITWISE_COPY = IsBitwiseCopyable<T, Alloc>::value;
+
+    //true when destroying an element does nothing
+    static constexpr bool TRIVIAL_DESTROY = IsTriviallyDestroyed<T, Alloc>::value;
+
+    Alloc m_alloc; //allocates the heap buffer
+    T* m_data; //circular buffer of m_capacity slots, the inline slots (nullptr without any) or a heap buffer
+    std::size_t m_capacity; //amount of slots in m_data, 0 or a power of 2
+    std::size_t m_head; //index of the front of the queue in m_data
+    std::size_t m_size; //size of the queue, dynamically increasing and decreasing as the queue changes
+
+    explicit RingBuffer(const Alloc& alloc) noexcept;
+
+    //the queues copy and move their buffers themselves
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+    ~RingBuffer() = default;
+
+    //true if the elements are in a heap buffer, not in the inline slots (or nowhere)
+    bool onHeap() const noexcept;
+
+    //returns the slot of the element at the given distance from the front
+    T* slot(std::size_t index) const noexcept;
+
+    //returns an iterator to the element at the given distance from the front, m_size for the end
+    template<typename Modified_Type>
+    RingIterator<Modified_Type> iteratorAt(std::size_t index) const noexcept;
+
+    //calls visit(data, count) for every contiguous run of elements, front to back
+    template<typename Visitor>
+    void forEachRun(Visitor visit) const;
+
+    //moves the elements to slot 0 and on of newData and adopts it as the buffer, newCapacity is a power of 2 > m_size
+    //if moving fails newData is left without any element and still belongs to the caller
+    void relocate(T* newData, std::size_t newCapacity);
+
+    //relocates the elements to a new heap buffer of newCapacity slots, nothing changes if that fails
+    void reallocate(std::size_t newCapacity);
+
+    //grows the buffer so it holds at least the given amount of elements
+    void reserveSlots(std::size_t count);
+
+    //constructs an element from args behind the rear, doubling a full buffer first
+    template<typename... Args>
+    T& emplaceRear(Args&&... args);
+
+    //inserts [first, last) behind the rear, a forward range grows the buffer at most once
+    //if an element can't be inserted the ones already inserted are removed again, a grown buffer is kept
+    template<typename InputIt>
+    void pushRange(InputIt first, InputIt last);
+
+    //copies the elements of other to slot 0 and on, this must be empty
+    //if a copy fails the elements already copied are destroyed and this is left empty
+    void copyFrom(const RingBuffer& other);
+
+    //replaces the elements with a copy of other's in place, only used when BITWISE_COPY and other fits the buffer
+    void overwriteWith(const RingBuffer& other) noexcept;
+
+    //pops the front element, the queue must not be empty
+    void removeFront() noexcept;
+
+    //destroys the elements beyond the first size elements
+    void truncate(std::size_t size) noexcept;
+
+    //memcpys count elements behind the rear, the buffer must have room for them, only used when BITWISE_COPY
+    void copyBack(const T* data, std::size_t count) noexcept;
+
+    //moves the elements back to the inline slots if they fit (frees the buffer of an empty queue without any),
+    //otherwise shrinks the heap buffer to the smallest power of 2 that holds them
+    void shrinkBuffer();
+
+    //destroys every element, frees a heap buffer and goes back to the inline slots (or to no buffer at all)
+    void destroyBuffer() noexcept;
+};
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+RingBuffer<T, Alloc, InlineCapacity>::RingBuffer(const Alloc& alloc) noexcept :
+    m_alloc(alloc),
+    m_data(this->inlineData()),
+    m_capacity(InlineCapacity),
+    m_head(0),
+    m_size(0)
+{ }
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+bool RingBuffer<T, Alloc, InlineCapacity>::onHeap() const noexcept
+{
+    return m_data != this->inlineData();
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+T* RingBuffer<T, Alloc, InlineCapacity>::slot(std::size_t index) const noexcept
+{
+    return m_data + ((m_head + index) & (m_capacity - 1));
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+template<typename Modified_Type>
+RingIterator<Modified_Type> RingBuffer<T, Alloc, InlineCapacity>::iteratorAt(std::size_t index) const noexcept
+{
+    return RingIterator<Modified_Type>(m_data, m_capacity - 1, m_head + index, m_head + m_size);
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+template<typename Visitor>
+void RingBuffer<T, Alloc, InlineCapacity>::forEachRun(Visitor visit) const
+{
+    if(m_size == 0){
+        return;
+    }
+    std::size_t first = m_capacity - m_head < m_size ? m_capacity - m_head : m_size; //elements before the wrap
+    visit(static_cast<const T*>(m_data + m_head), first);
+    if(first < m_size){
+        visit(static_cast<const T*>(m_data), m_size - first);
+    }
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+void RingBuffer<T, Alloc, InlineCapacity>::relocate(T* newData, std::size_t newCapacity)
+{
+    if constexpr(BITWISE_COPY){ //unwrapping the runs to slot 0 and on, nothing can fail
+        std::size_t moved = 0;
+        this->forEachRun([newData, &moved](const T* data, std::size_t count){
+            std::memcpy(static_cast<void*>(newData + moved), static_cast<const void*>(data), count * sizeof(T));
+            moved += count;
+        });
+    }
+    else{
+        std::size_t moved = 0;
+        try{
+            for(; moved < m_size; moved++){ //unwrapping the elements to slot 0 and on
+                AllocTraits::construct(m_alloc, newData + moved, std::move_if_noexcept(*this->slot(moved)));
+            }
+        } catch(...){ //only reachable when T is copied, the old buffer is still intact
+            for(std::size_t i = 0; i < moved; i++){
+                AllocTraits::destroy(m_alloc, newData + i);
+            }
+            throw;
+        }
+    }
+
+    std::size_t size = m_size;
+    this->destroyBuffer();
+    m_data = newData;
+    m_capacity = newCapacity;
+    m_size = size;
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+void RingBuffer<T, Alloc, InlineCapacity>::reallocate(std::size_t newCapacity)
+{
+    T* newData = AllocTraits::allocate(m_alloc, newCapacity);
+    try{
+        this->relocate(newData, newCapacity);
+    } catch(...){
+        AllocTraits::deallocate(m_alloc, newData, newCapacity);
+        throw;
+    }
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+void RingBuffer<T, Alloc, InlineCapacity>::reserveSlots(std::size_t count)
+{
+    if(count <= m_capacity){
+        return;
+    }
+    std::size_t newCapacity = m_capacity == 0 ? INITIAL_CAPACITY : m_capacity;
+    while(newCapacity < count){
+        newCapacity *= 2;
+    }
+    this->reallocate(newCapacity);
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+template<typename... Args>
+T& RingBuffer<T, Alloc, InlineCapacity>::emplaceRear(Args&&... args)
+{
+    if(m_size == m_capacity){ //buffer is full, allocating or doubling the heap buffer
+        std::size_t newCapacity = m_capacity == 0 ? INITIAL_CAPACITY : m_capacity * 2;
+        T* newData = AllocTraits::allocate(m_alloc, newCapacity);
+        T* target = newData + m_size;
+        try{ //the new element first, args may refer to an element of the old buffer
+            AllocTraits::construct(m_alloc, target, std::forward<Args>(args)...);
+        } catch(...){
+            AllocTraits::deallocate(m_alloc, newData, newCapacity);
+            throw;
+        }
+        try{
+            this->relocate(newData, newCapacity);
+        } catch(...){
+            AllocTraits::destroy(m_alloc, target);
+            AllocTraits::deallocate(m_alloc, newData, newCapacity);
+            throw;
+        }
+        m_size++;
+        return *target;
+    }
+    T* target = this->slot(m_size);
+    AllocTraits::construct(m_alloc, target, std::forward<Args>(args)...);
+    m_size++;
+    return *target;
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+template<typename InputIt>
+void RingBuffer<T, Alloc, InlineCapacity>::pushRange(InputIt first, InputIt last)
+{
+    typedef typename std::iterator_traits<InputIt>::iterator_category Category;
+    if constexpr(std::is_base_of<std::forward_iterator_tag, Category>::value){
+        this->reserveSlots(m_size + static_cast<std::size_t>(std::distance(first, last)));
+    }
+    if constexpr(BITWISE_COPY && std::is_pointer<InputIt>::value &&
+                 std::is_same<typename std::iterator_traits<InputIt>::value_type, T>::value){
+        this->copyBack(first, static_cast<std::size_t>(last - first)); //room was reserved above
+        return;
+    }
+
+    std::size_t oldSize = m_size;
+    try{
+        for(; first != last; ++first){
+            this->emplaceRear(*first);
+        }
+    } catch(...){ //removing what was already inserted, a grown buffer is kept
+        this->truncate(oldSize);
+        throw;
+    }
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+void RingBuffer<T, Alloc, InlineCapacity>::copyFrom(const RingBuffer& other)
+{
+    this->reserveSlots(other.m_size);
+    if constexpr(BITWISE_COPY){ //one memcpy per run, nothing can fail
+        other.forEachRun([this](const T* data, std::size_t count){
+            this->copyBack(data, count);
+        });
+        return;
+    }
+    try{
+        for(std::size_t i = 0; i < other.m_size; i++){ //copies land contiguously from slot 0
+            AllocTraits::construct(m_alloc, m_data + m_size, *other.slot(i));
+            m_size++;
+        }
+    } catch(...){ //copy c'tor of T failed, releasing what was already copied
+        this->destroyBuffer();
+        throw;
+    }
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+void RingBuffer<T, Alloc, InlineCapacity>::overwriteWith(const RingBuffer& other) noexcept
+{
+    this->truncate(0);
+    m_head = 0;
+    other.forEachRun([this](const T* data, std::size_t count){
+        this->copyBack(data, count);
+    });
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+void RingBuffer<T, Alloc, InlineCapacity>::removeFront() noexcept
+{
+    AllocTraits::destroy(m_alloc, m_data + m_head);
+    m_head = (m_head + 1) & (m_capacity - 1);
+    m_size--;
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+void RingBuffer<T, Alloc, InlineCapacity>::truncate(std::size_t size) noexcept
+{
+    if constexpr(TRIVIAL_DESTROY){
+        m_size = m_size < size ? m_size : size;
+        return;
+    }
+    while(m_size > size){
+        m_size--;
+        AllocTraits::destroy(m_alloc, this->slot(m_size));
+    }
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+void RingBuffer<T, Alloc, InlineCapacity>::copyBack(const T* data, std::size_t count) noexcept
+{
+    if(count == 0){
+        return;
+    }
+    std::size_t rear = (m_head + m_size) & (m_capacity - 1);
+    std::size_t first = m_capacity - rear < count ? m_capacity - rear : count; //elements before the wrap
+    std::memcpy(static_cast<void*>(m_data + rear), static_cast<const void*>(data), first * sizeof(T));
+    if(first < count){
+        std::memcpy(static_cast<void*>(m_data), static_cast<const void*>(data + first), (count - first) * sizeof(T));
+    }
+    m_size += count;
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+void RingBuffer<T, Alloc, InlineCapacity>::shrinkBuffer()
+{
+    if(!this->onHeap()){
+        return;
+    }
+    if(m_size <= InlineCapacity){ //relocating into the inline slots, nothing to free if it fails
+        this->relocate(this->inlineData(), InlineCapacity);
+        return;
+    }
+    std::size_t newCapacity = InlineCapacity == 0 ? 1 : InlineCapacity;
+    while(newCapacity < m_size){
+        newCapacity *= 2;
+    }
+    if(newCapacity == m_capacity){
+        return;
+    }
+    this->reallocate(newCapacity);
+}
+
+template<typename T, typename Alloc, std::size_t InlineCapacity>
+void RingBuffer<T, Alloc, InlineCapacity>::destroyBuffer() noexcept
+{
+    if constexpr(!TRIVIAL_DESTROY){
+        for(std::size_t i = 0; i < m_size; i++){
+            AllocTraits::destroy(m_alloc, this->slot(i));
+        }
+    }
+    if(this->onHeap()){
+        AllocTraits::deallocate(m_alloc, m_data, m_capacity);
+    }
+    m_data = this->inlineData();
+    m_capacity = InlineCapacity;
+    m_head = 0;
+    m_size = 0;
+}
+
+/**
+ * @brief RingIterator template to support the Iterator and ConstIterator classes of the circular buffers
+ *
+ *  positions are unwrapped (head + distance from the front) and masked only on dereference,
+ *  so begin and end never compare equal on a full buffer
+ *
+ * @tparam Modified_Type
+ *      Type - normal iterator
+ *      const Type - const iterator
+ */
+template<typename Modified_Type>
+class RingIterator {
+public:
+    //allowing the use of ConstIterator with a non-const queue by conversion
+    operator RingIterator<const Modified_Type>() const
+    {
+        return RingIterator<const Modified_Type>(m_data, m_mask, m_position, m_end);
+    }
+private:
+    Modified_Type* m_data; //buffer of the queue to be iterated
+    std::size_t m_mask; //capacity of the buffer - 1
+    std::size_t m_position; //unwrapped position the iterator points to
+    std::size_t m_end; //unwrapped position beyond the last element
+
+    //throws InvalidOperation if the iterator points to the end, only asserts with QUEUE_UNCHECKED_ITERATORS
+    void checkNotEnd() const
+    {
+#if QUEUE_UNCHECKED_ITERATORS
+        assert(m_position != m_end);
+#else
+        if(m_position == m_end){
+            throw InvalidOperation();
+        }
+#endif
+    }
+public:
+
+    /**
+     * Standard iterator traits, RingIterator is a forward iterator
+     *
+     */
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::remove_const<Modified_Type>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Modified_Type* pointer;
+    typedef Modified_Type& reference;
+
+    /**
+     * @brief Constructs a singular iterator, that may only be assigned to or compared
+     *
+     */
+    RingIterator() :
+        m_data(nullptr),
+        m_mask(0),
+        m_position(0),
+        m_end(0)
+    { }
+
+    /**
+     * @brief Constructor for an Iterator, used by the queues
+     *
+     * @param data - buffer of the queue to iterate
+     * @param mask - capacity of the buffer - 1
+     * @param position - initial unwrapped position to point to
+     * @param end - unwrapped position beyond the last element
+     */
+    RingIterator(Modified_Type* data, std::size_t mask, std::size_t position, std::size_t end) :
+        m_data(data),
+        m_mask(mask),
+        m_position(position),
+        m_end(end)
+    { }
+
+    /**
+     * Explicitly stating that we use default c'tor, d'tor and assignment operator
+     *
+     */
+    RingIterator(const RingIterator&) = default;
+    ~RingIterator() = default;
+    RingIterator& operator=(const RingIterator&) = default;
+
+    /**
+     * @brief class for invalid operations done on iterator, thrown in following functions:
+     *
+     *  operator* when trying to dereference an element that's past the end
+     *  operator++(prefix and postfix) when trying to increment an iterator that's past the end
+     *  with QUEUE_UNCHECKED_ITERATORS these are assertions instead
+     */
+    class InvalidOperation {};
+
+    /**
+     * @brief Returns a reference to the data the iterator currently points to
+     *
+     * @return
+     *      reference if Iterator
+     *      const reference if ConstIterator
+     */
+    Modified_Type& operator*() const
+    {
+        this->checkNotEnd();
+        return m_data[m_position & m_mask];
+    }
+
+    /**
+     * @brief Returns a pointer to the data the iterator currently points to
+     *
+     * @return
+     *      pointer if Iterator
+     *      const pointer if ConstIterator
+     */
+    Modified_Type* operator->() const
+    {
+        return &**this;
+    }
+
+    /**
+     * @brief Prefix incrementing the Iterator, making it point to the next object
+     *
+     * @return - Iterator after the increment
+     */
+    RingIterator& operator++()
+    {
+        this->checkNotEnd();
+        m_position++;
+        return *this;
+    }
+
+    /**
+     * @brief Postfix incrementing the Iterator, making it point to the next object
+     *
+     * @return - Iterator before the increment
+     */
+    RingIterator operator++(int)
+    {
+        this->checkNotEnd();
+        RingIterator result = *this;
+        m_position++;
+        return result;
+    }
+
+    /**
+     * @brief Checks if 2 Iterators point to the same element
+     *
+     * @param other - Iterator to compare to
+     * @return true if Iterators point to the same element
+     * @return false if Iterators point to a different element
+     */
+    bool operator==(const RingIterator& other) const
+    {
+        return m_position == other.m_position;
+    }
+
+    /**
+     * @brief Checks if 2 Iterators point to different elements
+     *
+     * @param other - Iterator to compare to
+     * @return true if Iterators point to a different element
+     * @return false if Iterators point to the same element
+     */
+    bool operator!=(const RingIterator& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+} //namespace queue_detail
+
+#endif
@@ -0,0 +1,553 @@
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "QueueAlgorithms.h"
+#include "RingBuffer.h"
+
+/* RingQueue:
+ *      Queue with the same interface as Queue<T>, stored in a growable circular buffer
+ *      elements are contiguous (up to one wraparound), so iteration walks memory linearly
+ *      and a push costs no allocation until the buffer has to grow
+ *      the capacity is always a power of 2, wrapping an index is a mask
+ *
+ *      for a trivially copyable T copies, growth and pushes of a pointer range are memcpy calls,
+ *      and clearing or destroying a queue of a trivially destructible T never walks the elements
+ *
+ *  unlike Queue<T>, growing the buffer moves the elements,
+ *  so references and iterators are invalidated by a push that grows the queue
+ *
+ *  switching a call site is a typedef away:
+ *      typedef RingQueue<int> IntQueue; //was Queue<int>
+ */
+template <class T, class Alloc = std::allocator<T>>
+class RingQueue : private queue_detail::RingBuffer<T, Alloc, 0> {
+private:
+    typedef queue_detail::RingBuffer<T, Alloc, 0> Ring;
+    typedef std::allocator_traits<Alloc> AllocTraits;
+
+    using Ring::m_alloc;
+    using Ring::m_data;
+    using Ring::m_capacity;
+    using Ring::m_head;
+    using Ring::m_size;
+    using Ring::BITWISE_COPY;
+
+    //swaps the buffers and sizes of two queues, allocators are untouched
+    void swapBuffers(RingQueue& other) noexcept;
+
+public:
+
+    /**
+     * @brief Construct a new RingQueue, no memory is allocated until the first push
+     *
+     */
+    RingQueue();
+
+    /**
+     * @brief Construct a new RingQueue that allocates its buffer with the given allocator
+     *
+     * @param alloc - allocator of the buffer
+     */
+    explicit RingQueue(const Alloc& alloc);
+
+    /**
+     * @brief Copy Constructor for a RingQueue
+     *
+     * @param other - RingQueue to copy
+     */
+    RingQueue(const RingQueue& other);
+
+    /**
+     * @brief Copy Constructor for a RingQueue that uses the given allocator
+     *
+     * @param other - RingQueue to copy
+     * @param alloc - allocator of the buffer
+     */
+    RingQueue(const RingQueue& other, const Alloc& alloc);
+
+    /**
+     * @brief Move Constructor for a RingQueue, steals the buffer of other in O(1)
+     *
+     * @param other - RingQueue to move from, left empty
+     */
+    RingQueue(RingQueue&& other) noexcept;
+
+    /**
+     * @brief Destroys the RingQueue
+     *
+     */
+    ~RingQueue();
+
+    /**
+     * @brief Assignment operator of a RingQueue
+     *
+     * @param other - RingQueue to copy & assign
+     * @return - reference to the copied queue
+     */
+    RingQueue& operator=(const RingQueue& other);
+
+    /**
+     * @brief Move assignment operator of a RingQueue, steals the buffer of other in O(1)
+     *
+     * @param other - RingQueue to move from, left empty
+     * @return - reference to the assigned queue
+     */
+    RingQueue& operator=(RingQueue&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value ||
+                                                     AllocTraits::is_always_equal::value);
+
+    /**
+     * @brief Inserts in the back of the RingQueue
+     *
+     * @param val - value to be inserted
+     */
+    void pushBack(const T& val);
+
+    /**
+     * @brief Inserts in the back of the RingQueue by moving the given value
+     *
+     * @param val - value to be moved into the queue
+     */
+    void pushBack(T&& val);
+
+    /**
+     * @brief Constructs a new element in place in the back of the RingQueue
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     * @return - reference to the newly constructed element
+     */
+    template<typename... Args>
+    T& emplaceBack(Args&&... args);
+
+    /**
+     * @brief Inserts the elements of [first, last) in the back of the queue, in order
+     *
+     *      for a forward range the buffer grows at most once
+     *      strong guarantee: if an element can't be inserted, the queue is left unchanged
+     *
+     * @param first - beginning of the range to insert
+     * @param last - end of the range to insert
+     */
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void pushBack(InputIt first, InputIt last);
+
+    /**
+     * @brief Returns a reference to the front of the queue
+     *
+     * @return - reference to the data stored in the front
+     */
+    T& front();
+
+    /**
+     * @brief Returns a const reference to the front of the queue
+     *
+     * @return - const reference to the data stored in the front
+     */
+    const T& front() const;
+
+    /**
+     * @brief Pops the element in the front of the queue
+     *
+     */
+    void popFront();
+
+    /**
+     * @brief Pops the n elements in the front of the queue
+     *
+     * @param n - amount of elements to pop, if the queue holds fewer EmptyQueue is thrown and nothing is popped
+     */
+    void popFront(std::size_t n);
+
+    /**
+     * @brief Moves up to n elements from the front of the queue into out and pops them
+     *
+     * @param out - output iterator receiving the elements in order
+     * @param n - maximal amount of elements to move
+     * @return - amount of elements moved, smaller than n if the queue ran out of elements
+     */
+    template<typename OutputIt>
+    std::size_t drainTo(OutputIt out, std::size_t n);
+
+    /**
+     * @brief Checks if the queue is empty
+     *
+     * @return true if the queue holds no elements
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns a pointer to the front of the queue without throwing
+     *
+     * @return - pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    T* tryFront();
+
+    /**
+     * @brief Returns a const pointer to the front of the queue without throwing
+     *
+     * @return - const pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    const T* tryFront() const;
+
+    /**
+     * @brief Moves the front element out of the queue and pops it, without throwing on an empty queue
+     *
+     * @return - the front element, or an empty optional if the queue is empty
+     */
+    std::optional<T> tryPop();
+
+    /**
+     * @brief Returns the size of the queue
+     *
+     * @return - size of the queue
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Returns the amount of elements the RingQueue can hold before its buffer has to grow
+     *
+     * @return - capacity of the buffer
+     */
+    std::size_t capacity() const;
+
+    /**
+     * @brief Grows the buffer up front so the next pushes up to the given size don't allocate
+     *
+     * @param count - amount of elements the queue should be able to hold without growing
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * @brief Destroys every element, the buffer is kept for the next pushes
+     *
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Shrinks the buffer to the smallest power of 2 that holds the elements, frees it if the queue is empty
+     *
+     */
+    void shrinkToFit();
+
+
+    /**
+     * @brief Calls visit(data, count) for every contiguous run of elements, front to back
+     *      a buffer that doesn't wrap around is a single run, a wrapping one two runs
+     *
+     * @param visit - callable taking a const T* to the first element of a run and the length of the run
+     */
+    using Ring::forEachRun;
+
+
+    /**
+     * @brief Returns a copy of the allocator the RingQueue was constructed with
+     *
+     * @return - allocator of the queue
+     */
+    Alloc getAllocator() const;
+
+    /**
+     * @brief Iterator class for RingQueue
+     *
+     */
+    typedef queue_detail::RingIterator<T> Iterator;
+
+    /**
+     * @brief Const Iterator class for RingQueue
+     *
+     */
+    typedef queue_detail::RingIterator<const T> ConstIterator;
+
+    /**
+     * @brief Returns an Iterator pointing to the front of the RingQueue
+     */
+    Iterator begin()
+    {
+        return this->template iteratorAt<T>(0);
+    }
+
+    /**
+     * @brief Returns an Iterator pointing to the end of the RingQueue
+     */
+    Iterator end()
+    {
+        return this->template iteratorAt<T>(m_size);
+    }
+
+    /**
+     * @brief Returns a Const Iterator pointing to the front of the RingQueue
+     */
+    ConstIterator begin() const
+    {
+        return this->template iteratorAt<const T>(0);
+    }
+
+    /**
+     * @brief Returns a Const Iterator pointing to the end of the RingQueue
+     */
+    ConstIterator end() const
+    {
+        return this->template iteratorAt<const T>(m_size);
+    }
+
+    /**
+     * @brief Exception Class to deal with invalid operations done on an empty RingQueue
+     *
+     *  Invalid operators on an empty RingQueue:
+     *      front, popFront
+     */
+    class EmptyQueue {};
+};
+template<typename T, typename Alloc>
+RingQueue<T, Alloc>::RingQueue() :
+    Ring(Alloc())
+{ }
+
+template<typename T, typename Alloc>
+RingQueue<T, Alloc>::RingQueue(const Alloc& alloc) :
+    Ring(alloc)
+{ }
+
+template<typename T, typename Alloc>
+RingQueue<T, Alloc>::RingQueue(const RingQueue& other) :
+    RingQueue(other, AllocTraits::select_on_container_copy_construction(other.m_alloc))
+{ }
+
+template<typename T, typename Alloc>
+RingQueue<T, Alloc>::RingQueue(const RingQueue& other, const Alloc& alloc) :
+    RingQueue(alloc)
+{
+    this->copyFrom(other);
+}
+
+template<typename T, typename Alloc>
+RingQueue<T, Alloc>::RingQueue(RingQueue&& other) noexcept :
+    Ring(other.m_alloc)
+{
+    this->swapBuffers(other);
+}
+
+template<typename T, typename Alloc>
+RingQueue<T, Alloc>::~RingQueue()
+{
+    this->destroyBuffer();
+}
+
+template<typename T, typename Alloc>
+RingQueue<T, Alloc>& RingQueue<T, Alloc>::operator=(const RingQueue& other)
+{
+    if(this == &other){
+        return *this;
+    }
+
+    constexpr bool propagate = AllocTraits::propagate_on_container_copy_assignment::value;
+    if constexpr(BITWISE_COPY){
+        if(other.m_size <= m_capacity && (!propagate || m_alloc == other.m_alloc)){ //the buffer is reused in place
+            this->overwriteWith(other);
+            return *this;
+        }
+    }
+    RingQueue temp(other, propagate ? other.m_alloc : m_alloc);
+    this->swapBuffers(temp);
+    if(propagate){
+        std::swap(temp.m_alloc, m_alloc);
+    }
+        /*  copy & swap, temp's d'tor releases this's old buffer with the allocator it came from
+         *  if the copy fails, this is left untouched
+         */
+    return *this;
+}
+
+template<typename T, typename Alloc>
+RingQueue<T, Alloc>& RingQueue<T, Alloc>::operator=(RingQueue&& other)
+    noexcept(AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+{
+    if(this == &other){
+        return *this;
+    }
+
+    if(AllocTraits::propagate_on_container_move_assignment::value){
+        this->swapBuffers(other);
+        std::swap(other.m_alloc, m_alloc);
+    }
+    else if(m_alloc == other.m_alloc){
+        this->swapBuffers(other);
+    }
+    else{ //this's allocator can't free other's buffer, moving element by element
+        RingQueue temp(m_alloc);
+        for(T& data : other){
+            temp.pushBack(std::move(data));
+        }
+        this->swapBuffers(temp);
+    }
+    other.destroyBuffer();
+        /*  swaps the buffers, this takes other's buffer in O(1) and other holds this's old one,
+         *  which is released right away with the allocator it came from, so other is left empty
+         */
+    return *this;
+}
+
+template<typename T, typename Alloc>
+void RingQueue<T, Alloc>::pushBack(const T& val)
+{
+    this->emplaceRear(val);
+}
+
+template<typename T, typename Alloc>
+void RingQueue<T, Alloc>::pushBack(T&& val)
+{
+    this->emplaceRear(std::move(val));
+}
+
+template<typename T, typename Alloc>
+template<typename... Args>
+T& RingQueue<T, Alloc>::emplaceBack(Args&&... args)
+{
+    return this->emplaceRear(std::forward<Args>(args)...);
+}
+
+template<typename T, typename Alloc>
+template<typename InputIt, typename>
+void RingQueue<T, Alloc>::pushBack(InputIt first, InputIt last)
+{
+    this->pushRange(first, last);
+}
+
+template<typename T, typename Alloc>
+T& RingQueue<T, Alloc>::front()
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    else{ //normal reference to the data
+        return m_data[m_head];
+    }
+}
+
+template<typename T, typename Alloc>
+const T& RingQueue<T, Alloc>::front() const
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    else{ //const reference to the data
+        return m_data[m_head];
+    }
+}
+
+template<typename T, typename Alloc>
+void RingQueue<T, Alloc>::popFront()
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    else{
+        this->removeFront();
+    }
+}
+
+template<typename T, typename Alloc>
+void RingQueue<T, Alloc>::popFront(std::size_t n)
+{
+    if(n > m_size){ //checked once for the whole batch
+        throw EmptyQueue();
+    }
+    for(std::size_t i = 0; i < n; i++){
+        this->removeFront();
+    }
+}
+
+template<typename T, typename Alloc>
+template<typename OutputIt>
+std::size_t RingQueue<T, Alloc>::drainTo(OutputIt out, std::size_t n)
+{
+    std::size_t count = n < m_size ? n : m_size;
+    for(std::size_t i = 0; i < count; i++){
+        *out = std::move(m_data[m_head]);
+        ++out;
+        this->removeFront();
+    }
+    return count;
+}
+
+template<typename T, typename Alloc>
+bool RingQueue<T, Alloc>::empty() const
+{
+    return m_size == 0;
+}
+
+template<typename T, typename Alloc>
+T* RingQueue<T, Alloc>::tryFront()
+{
+    return m_size == 0 ? nullptr : &m_data[m_head];
+}
+
+template<typename T, typename Alloc>
+const T* RingQueue<T, Alloc>::tryFront() const
+{
+    return m_size == 0 ? nullptr : &m_data[m_head];
+}
+
+template<typename T, typename Alloc>
+std::optional<T> RingQueue<T, Alloc>::tryPop()
+{
+    if(m_size == 0){ //the common case for a polling consumer, no exception involved
+        return std::nullopt;
+    }
+    std::optional<T> result(std::move(m_data[m_head]));
+    this->removeFront();
+    return result;
+}
+
+template<typename T, typename Alloc>
+std::size_t RingQueue<T, Alloc>::size() const
+{
+    return m_size;
+}
+
+template<typename T, typename Alloc>
+std::size_t RingQueue<T, Alloc>::capacity() const
+{
+    return m_capacity;
+}
+
+template<typename T, typename Alloc>
+void RingQueue<T, Alloc>::reserve(std::size_t count)
+{
+    this->reserveSlots(count);
+}
+
+template<typename T, typename Alloc>
+void RingQueue<T, Alloc>::clear() noexcept
+{
+    this->truncate(0);
+    m_head = 0;
+}
+
+template<typename T, typename Alloc>
+void RingQueue<T, Alloc>::shrinkToFit()
+{
+    this->shrinkBuffer();
+}
+
+template<typename T, typename Alloc>
+Alloc RingQueue<T, Alloc>::getAllocator() const
+{
+    return m_alloc;
+}
+
+template<typename T, typename Alloc>
+void RingQueue<T, Alloc>::swapBuffers(RingQueue& other) noexcept
+{
+    std::swap(other.m_data, m_data);
+    std::swap(other.m_capacity, m_capacity);
+    std::swap(other.m_head, m_head);
+    std::swap(other.m_size, m_size);
+}
+
+#endif
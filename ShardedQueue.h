@@ -0,0 +1,209 @@
+#ifndef SHARDED_QUEUE_H
+#define SHARDED_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "CacheLine.h"
+#include "Queue.h"
+
+/* ShardedQueue:
+ *      Queue shared between threads that trades global FIFO order for throughput
+ *      the elements are spread over shards (by default one per hardware thread), each a mutex and a Queue
+ *      on its own cache lines, so threads working on different shards never touch the same line
+ *      every thread has a home shard, handed out round robin the first time the thread uses a ShardedQueue of that type
+ *      a push goes to the home shard, a pop takes the front of the home shard
+ *      and only when it is empty steals from the others, round robin starting after the home shard
+ *
+ *  order is FIFO per shard: two elements pushed by the same thread are popped in order,
+ *  elements pushed by threads with different home shards are popped in no particular order
+ *  shards are skipped by a pop while their size reads 0, so a pop racing with a push to another shard
+ *  may find nothing, like every relaxed queue it is meant for consumers that poll or retry
+ *  every shard allocates through its own select_on_container_copy_construction copy of the allocator
+ *  copying and moving are disabled, the queue is meant to be shared by address
+ */
+template <class T, class Alloc = std::allocator<T>>
+class ShardedQueue {
+private:
+    //a mutex and its queue, padded to their own cache lines
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::mutex mutex; //protects queue
+        Queue<T, Alloc> queue; //elements of the shard
+        std::atomic<std::size_t> size; //size of queue, written under mutex and read without it
+
+        explicit Shard(const Alloc& alloc) :
+            queue(alloc),
+            size(0)
+        { }
+    };
+
+    std::vector<std::unique_ptr<Shard>> m_shards; //at least one shard, never resized
+
+    //shard count used when the c'tor is given 0
+    static std::size_t defaultShardCount();
+
+    //index of the home shard of the calling thread, the same for every queue of this type with as many shards
+    std::size_t home() const;
+
+    //pops the front of a shard, an empty optional if it is empty
+    static std::optional<T> popShard(Shard& shard);
+
+public:
+
+    /**
+     * @brief Construct a new empty ShardedQueue
+     *
+     * @param shards - amount of shards, 0 for one per hardware thread
+     * @param alloc - allocator of the nodes, every shard gets select_on_container_copy_construction(alloc),
+     *      so an allocator that is not thread safe must hand out independent copies that way (like PoolAllocator)
+     */
+    explicit ShardedQueue(std::size_t shards = 0, const Alloc& alloc = Alloc());
+
+    ShardedQueue(const ShardedQueue&) = delete;
+    ShardedQueue& operator=(const ShardedQueue&) = delete;
+
+    /**
+     * @brief Inserts in the back of the home shard of the calling thread
+     *
+     * @param val - value to be inserted
+     */
+    void pushBack(const T& val);
+
+    /**
+     * @brief Moves a value into the back of the home shard of the calling thread
+     *
+     * @param val - value to be moved into the queue
+     */
+    void pushBack(T&& val);
+
+    /**
+     * @brief Constructs a new element in place in the back of the home shard of the calling thread
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     */
+    template<typename... Args>
+    void emplaceBack(Args&&... args);
+
+    /**
+     * @brief Pops the front of the home shard, or steals the front of another shard if it is empty
+     *
+     * @return - the element, or an empty optional if every shard looked empty
+     */
+    std::optional<T> tryPop();
+
+    /**
+     * @brief Returns the sum of the shard sizes, read one by one without locking
+     *      the result may be stale, and while threads push and pop it isn't the size at any single moment
+     *
+     * @return - approximate amount of elements
+     */
+    std::size_t approximateSize() const;
+
+    /**
+     * @brief Returns the amount of shards the elements are spread over
+     *
+     * @return - amount of shards
+     */
+    std::size_t shardCount() const;
+};
+
+template<typename T, typename Alloc>
+ShardedQueue<T, Alloc>::ShardedQueue(std::size_t shards, const Alloc& alloc)
+{
+    std::size_t count = shards == 0 ? defaultShardCount() : shards;
+    m_shards.reserve(count);
+    for(std::size_t i = 0; i < count; i++){ //one allocation per shard, a mutex can't be moved
+        //shards are locked independently, they must not share allocator state
+        Alloc shardAlloc = std::allocator_traits<Alloc>::select_on_container_copy_construction(alloc);
+        m_shards.push_back(std::make_unique<Shard>(shardAlloc));
+    }
+}
+
+template<typename T, typename Alloc>
+std::size_t ShardedQueue<T, Alloc>::defaultShardCount()
+{
+    unsigned threads = std::thread::hardware_concurrency();
+    return threads == 0 ? 1 : threads; //0 when the value isn't known
+}
+
+template<typename T, typename Alloc>
+std::size_t ShardedQueue<T, Alloc>::home() const
+{
+    static std::atomic<std::size_t> nextTicket(0);
+    thread_local std::size_t ticket = nextTicket.fetch_add(1, std::memory_order_relaxed);
+    return ticket % m_shards.size();
+}
+
+template<typename T, typename Alloc>
+std::optional<T> ShardedQueue<T, Alloc>::popShard(Shard& shard)
+{
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::optional<T> result = shard.queue.tryPop();
+    if(result){
+        shard.size.store(shard.queue.size(), std::memory_order_relaxed);
+    }
+    return result;
+}
+
+template<typename T, typename Alloc>
+void ShardedQueue<T, Alloc>::pushBack(const T& val)
+{
+    this->emplaceBack(val);
+}
+
+template<typename T, typename Alloc>
+void ShardedQueue<T, Alloc>::pushBack(T&& val)
+{
+    this->emplaceBack(std::move(val));
+}
+
+template<typename T, typename Alloc>
+template<typename... Args>
+void ShardedQueue<T, Alloc>::emplaceBack(Args&&... args)
+{
+    Shard& shard = *m_shards[this->home()];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.queue.emplaceBack(std::forward<Args>(args)...);
+    shard.size.store(shard.queue.size(), std::memory_order_relaxed);
+}
+
+template<typename T, typename Alloc>
+std::optional<T> ShardedQueue<T, Alloc>::tryPop()
+{
+    std::size_t count = m_shards.size();
+    std::size_t index = this->home();
+    for(std::size_t i = 0; i < count; i++){ //the home shard first, then stealing round robin
+        Shard& shard = *m_shards[index];
+        if(shard.size.load(std::memory_order_relaxed) > 0){ //an empty shard isn't locked at all
+            std::optional<T> result = popShard(shard);
+            if(result){
+                return result;
+            }
+        }
+        index = index + 1 == count ? 0 : index + 1;
+    }
+    return std::nullopt;
+}
+
+template<typename T, typename Alloc>
+std::size_t ShardedQueue<T, Alloc>::approximateSize() const
+{
+    std::size_t total = 0;
+    for(const std::unique_ptr<Shard>& shard : m_shards){
+        total += shard->size.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+template<typename T, typename Alloc>
+std::size_t ShardedQueue<T, Alloc>::shardCount() const
+{
+    return m_shards.size();
+}
+
+#endif
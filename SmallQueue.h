@@ -0,0 +1,596 @@
+#ifndef SMALL_QUEUE_H
+#define SMALL_QUEUE_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "QueueAlgorithms.h"
+#include "RingBuffer.h"
+
+/* SmallQueue:
+ *      Queue with the same interface as Queue<T>, whose first elements are stored inside the object itself
+ *      the elements live in a circular buffer that starts as an inline array of N slots (rounded up to a power of 2),
+ *      a queue that never holds more than that never allocates at all
+ *      once a push overflows the inline array, the elements spill to a heap buffer that keeps doubling like RingQueue
+ *      like RingQueue, a trivially copyable T is copied, moved between buffers and pushed from a pointer range by memcpy
+ *
+ *  like RingQueue, growing the buffer moves the elements, so references and iterators are invalidated by it
+ *  moving an inline SmallQueue moves its elements one by one, moving a spilled one steals its buffer in O(1)
+ *
+ * @tparam T - type of the elements
+ * @tparam N - amount of elements stored inline
+ * @tparam Alloc - allocator of the heap buffer
+ */
+template <class T, std::size_t N = 8, class Alloc = std::allocator<T>>
+class SmallQueue : private queue_detail::RingBuffer<T, Alloc, queue_detail::roundCapacity(N)> {
+    static_assert(N > 0, "N must be positive");
+public:
+    //amount of elements a SmallQueue holds without allocating, N rounded up to a power of 2 so wrapping an index is a mask
+    static constexpr std::size_t INLINE_CAPACITY = queue_detail::roundCapacity(N);
+
+private:
+    typedef queue_detail::RingBuffer<T, Alloc, INLINE_CAPACITY> Ring;
+    typedef std::allocator_traits<Alloc> AllocTraits;
+
+    using Ring::m_alloc;
+    using Ring::m_data;
+    using Ring::m_capacity;
+    using Ring::m_head;
+    using Ring::m_size;
+    using Ring::BITWISE_COPY;
+
+    //takes over the elements of other, this must be empty and inline and both allocators equal
+    //a heap buffer is stolen, inline elements are moved one by one, other is left empty and inline
+    void takeBuffer(SmallQueue& other) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+public:
+
+    /**
+     * @brief Construct a new SmallQueue, no memory is allocated until the inline array overflows
+     *
+     */
+    SmallQueue();
+
+    /**
+     * @brief Construct a new SmallQueue that allocates its heap buffer with the given allocator
+     *
+     * @param alloc - allocator of the heap buffer
+     */
+    explicit SmallQueue(const Alloc& alloc);
+
+    /**
+     * @brief Copy Constructor for a SmallQueue
+     *
+     * @param other - SmallQueue to copy
+     */
+    SmallQueue(const SmallQueue& other);
+
+    /**
+     * @brief Copy Constructor for a SmallQueue that uses the given allocator
+     *
+     * @param other - SmallQueue to copy
+     * @param alloc - allocator of the heap buffer
+     */
+    SmallQueue(const SmallQueue& other, const Alloc& alloc);
+
+    /**
+     * @brief Move Constructor for a SmallQueue, steals a heap buffer in O(1), moves inline elements one by one
+     *
+     * @param other - SmallQueue to move from, left empty
+     */
+    SmallQueue(SmallQueue&& other) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+    /**
+     * @brief Destroys the SmallQueue
+     *
+     */
+    ~SmallQueue();
+
+    /**
+     * @brief Assignment operator of a SmallQueue
+     *
+     * @param other - SmallQueue to copy & assign
+     * @return - reference to the copied queue
+     */
+    SmallQueue& operator=(const SmallQueue& other);
+
+    /**
+     * @brief Move assignment operator of a SmallQueue, steals a heap buffer in O(1), moves inline elements one by one
+     *
+     * @param other - SmallQueue to move from, left empty
+     * @return - reference to the assigned queue
+     */
+    SmallQueue& operator=(SmallQueue&& other) noexcept(std::is_nothrow_move_constructible<T>::value &&
+                                                       (AllocTraits::propagate_on_container_move_assignment::value ||
+                                                        AllocTraits::is_always_equal::value));
+
+    /**
+     * @brief Inserts in the back of the SmallQueue
+     *
+     * @param val - value to be inserted
+     */
+    void pushBack(const T& val);
+
+    /**
+     * @brief Inserts in the back of the SmallQueue by moving the given value
+     *
+     * @param val - value to be moved into the queue
+     */
+    void pushBack(T&& val);
+
+    /**
+     * @brief Constructs a new element in place in the back of the SmallQueue
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     * @return - reference to the newly constructed element
+     */
+    template<typename... Args>
+    T& emplaceBack(Args&&... args);
+
+    /**
+     * @brief Inserts the elements of [first, last) in the back of the queue, in order
+     *
+     *      for a forward range the buffer grows at most once
+     *      strong guarantee: if an element can't be inserted, the queue is left unchanged
+     *
+     * @param first - beginning of the range to insert
+     * @param last - end of the range to insert
+     */
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void pushBack(InputIt first, InputIt last);
+
+    /**
+     * @brief Returns a reference to the front of the queue
+     *
+     * @return - reference to the data stored in the front
+     */
+    T& front();
+
+    /**
+     * @brief Returns a const reference to the front of the queue
+     *
+     * @return - const reference to the data stored in the front
+     */
+    const T& front() const;
+
+    /**
+     * @brief Pops the element in the front of the queue
+     *
+     */
+    void popFront();
+
+    /**
+     * @brief Pops the n elements in the front of the queue
+     *
+     * @param n - amount of elements to pop, if the queue holds fewer EmptyQueue is thrown and nothing is popped
+     */
+    void popFront(std::size_t n);
+
+    /**
+     * @brief Moves up to n elements from the front of the queue into out and pops them
+     *
+     * @param out - output iterator receiving the elements in order
+     * @param n - maximal amount of elements to move
+     * @return - amount of elements moved, smaller than n if the queue ran out of elements
+     */
+    template<typename OutputIt>
+    std::size_t drainTo(OutputIt out, std::size_t n);
+
+    /**
+     * @brief Checks if the queue is empty
+     *
+     * @return true if the queue holds no elements
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns a pointer to the front of the queue without throwing
+     *
+     * @return - pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    T* tryFront();
+
+    /**
+     * @brief Returns a const pointer to the front of the queue without throwing
+     *
+     * @return - const pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    const T* tryFront() const;
+
+    /**
+     * @brief Moves the front element out of the queue and pops it, without throwing on an empty queue
+     *
+     * @return - the front element, or an empty optional if the queue is empty
+     */
+    std::optional<T> tryPop();
+
+    /**
+     * @brief Returns the size of the queue
+     *
+     * @return - size of the queue
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Returns the amount of elements the SmallQueue can hold before its buffer has to grow
+     *
+     * @return - capacity of the buffer, INLINE_CAPACITY until the first spill
+     */
+    std::size_t capacity() const;
+
+    /**
+     * @brief Checks if the elements are still stored inside the object
+     *
+     * @return true if the queue never spilled to the heap, or went back to the inline array since
+     */
+    bool isInline() const;
+
+    /**
+     * @brief Grows the buffer up front so the next pushes up to the given size don't allocate
+     *
+     * @param count - amount of elements the queue should be able to hold without growing
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * @brief Destroys every element, a heap buffer is kept for the next pushes
+     *
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Moves the elements back to the inline array if they fit, otherwise shrinks the heap buffer
+     *      to the smallest power of 2 that holds them
+     *
+     */
+    void shrinkToFit();
+
+
+    /**
+     * @brief Calls visit(data, count) for every contiguous run of elements, front to back
+     *      a buffer that doesn't wrap around is a single run, a wrapping one two runs
+     *
+     * @param visit - callable taking a const T* to the first element of a run and the length of the run
+     */
+    using Ring::forEachRun;
+
+
+    /**
+     * @brief Returns a copy of the allocator the SmallQueue was constructed with
+     *
+     * @return - allocator of the queue
+     */
+    Alloc getAllocator() const;
+
+    /**
+     * @brief Iterator class for SmallQueue
+     *
+     */
+    typedef queue_detail::RingIterator<T> Iterator;
+
+    /**
+     * @brief Const Iterator class for SmallQueue
+     *
+     */
+    typedef queue_detail::RingIterator<const T> ConstIterator;
+
+    /**
+     * @brief Returns an Iterator pointing to the front of the SmallQueue
+     */
+    Iterator begin()
+    {
+        return this->template iteratorAt<T>(0);
+    }
+
+    /**
+     * @brief Returns an Iterator pointing to the end of the SmallQueue
+     */
+    Iterator end()
+    {
+        return this->template iteratorAt<T>(m_size);
+    }
+
+    /**
+     * @brief Returns a Const Iterator pointing to the front of the SmallQueue
+     */
+    ConstIterator begin() const
+    {
+        return this->template iteratorAt<const T>(0);
+    }
+
+    /**
+     * @brief Returns a Const Iterator pointing to the end of the SmallQueue
+     */
+    ConstIterator end() const
+    {
+        return this->template iteratorAt<const T>(m_size);
+    }
+
+    /**
+     * @brief Exception Class to deal with invalid operations done on an empty SmallQueue
+     *
+     *  Invalid operators on an empty SmallQueue:
+     *      front, popFront
+     */
+    class EmptyQueue {};
+};
+
+template<typename T, std::size_t N, typename Alloc>
+SmallQueue<T, N, Alloc>::SmallQueue() :
+    Ring(Alloc())
+{ }
+
+template<typename T, std::size_t N, typename Alloc>
+SmallQueue<T, N, Alloc>::SmallQueue(const Alloc& alloc) :
+    Ring(alloc)
+{ }
+
+template<typename T, std::size_t N, typename Alloc>
+SmallQueue<T, N, Alloc>::SmallQueue(const SmallQueue& other) :
+    SmallQueue(other, AllocTraits::select_on_container_copy_construction(other.m_alloc))
+{ }
+
+template<typename T, std::size_t N, typename Alloc>
+SmallQueue<T, N, Alloc>::SmallQueue(const SmallQueue& other, const Alloc& alloc) :
+    SmallQueue(alloc)
+{
+    this->copyFrom(other);
+}
+
+template<typename T, std::size_t N, typename Alloc>
+SmallQueue<T, N, Alloc>::SmallQueue(SmallQueue&& other) noexcept(std::is_nothrow_move_constructible<T>::value) :
+    SmallQueue(other.m_alloc)
+{
+    this->takeBuffer(other);
+}
+
+template<typename T, std::size_t N, typename Alloc>
+SmallQueue<T, N, Alloc>::~SmallQueue()
+{
+    this->destroyBuffer();
+}
+
+template<typename T, std::size_t N, typename Alloc>
+SmallQueue<T, N, Alloc>& SmallQueue<T, N, Alloc>::operator=(const SmallQueue& other)
+{
+    if(this == &other){
+        return *this;
+    }
+
+    constexpr bool propagate = AllocTraits::propagate_on_container_copy_assignment::value;
+    if constexpr(BITWISE_COPY){
+        if(other.m_size <= m_capacity && (!propagate || m_alloc == other.m_alloc)){ //the buffer is reused in place
+            this->overwriteWith(other);
+            return *this;
+        }
+    }
+    /*  the copy is made first, if it fails this is left untouched
+     *  temp shares the allocator this ends up with, so a spilled copy is stolen in O(1)
+     *  inline elements are moved over one by one, when that may throw the copy is spilled before this is cleared,
+     *  so that nothing can fail once this lost its elements
+     */
+    SmallQueue temp(other, propagate ? other.m_alloc : m_alloc);
+    if constexpr(!std::is_nothrow_move_constructible<T>::value){
+        temp.reserveSlots(INLINE_CAPACITY + 1);
+    }
+    this->destroyBuffer();
+    if(propagate){
+        m_alloc = other.m_alloc;
+    }
+    this->takeBuffer(temp);
+    return *this;
+}
+
+template<typename T, std::size_t N, typename Alloc>
+SmallQueue<T, N, Alloc>& SmallQueue<T, N, Alloc>::operator=(SmallQueue&& other)
+    noexcept(std::is_nothrow_move_constructible<T>::value &&
+             (AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value))
+{
+    if(this == &other){
+        return *this;
+    }
+
+    this->destroyBuffer();
+    if(AllocTraits::propagate_on_container_move_assignment::value){
+        m_alloc = other.m_alloc;
+    }
+    if(other.isInline() || m_alloc == other.m_alloc){
+        this->takeBuffer(other);
+    }
+    else{ //this's allocator can't free other's buffer, moving element by element
+        for(T& data : other){
+            this->pushBack(std::move(data));
+        }
+        other.destroyBuffer();
+    }
+    return *this;
+}
+
+template<typename T, std::size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::pushBack(const T& val)
+{
+    this->emplaceRear(val);
+}
+
+template<typename T, std::size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::pushBack(T&& val)
+{
+    this->emplaceRear(std::move(val));
+}
+
+template<typename T, std::size_t N, typename Alloc>
+template<typename... Args>
+T& SmallQueue<T, N, Alloc>::emplaceBack(Args&&... args)
+{
+    return this->emplaceRear(std::forward<Args>(args)...);
+}
+
+template<typename T, std::size_t N, typename Alloc>
+template<typename InputIt, typename>
+void SmallQueue<T, N, Alloc>::pushBack(InputIt first, InputIt last)
+{
+    this->pushRange(first, last);
+}
+
+template<typename T, std::size_t N, typename Alloc>
+T& SmallQueue<T, N, Alloc>::front()
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    else{ //normal reference to the data
+        return m_data[m_head];
+    }
+}
+
+template<typename T, std::size_t N, typename Alloc>
+const T& SmallQueue<T, N, Alloc>::front() const
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    else{ //const reference to the data
+        return m_data[m_head];
+    }
+}
+
+template<typename T, std::size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::popFront()
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    else{
+        this->removeFront();
+    }
+}
+
+template<typename T, std::size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::popFront(std::size_t n)
+{
+    if(n > m_size){ //checked once for the whole batch
+        throw EmptyQueue();
+    }
+    for(std::size_t i = 0; i < n; i++){
+        this->removeFront();
+    }
+}
+
+template<typename T, std::size_t N, typename Alloc>
+template<typename OutputIt>
+std::size_t SmallQueue<T, N, Alloc>::drainTo(OutputIt out, std::size_t n)
+{
+    std::size_t count = n < m_size ? n : m_size;
+    for(std::size_t i = 0; i < count; i++){
+        *out = std::move(m_data[m_head]);
+        ++out;
+        this->removeFront();
+    }
+    return count;
+}
+
+template<typename T, std::size_t N, typename Alloc>
+bool SmallQueue<T, N, Alloc>::empty() const
+{
+    return m_size == 0;
+}
+
+template<typename T, std::size_t N, typename Alloc>
+T* SmallQueue<T, N, Alloc>::tryFront()
+{
+    return m_size == 0 ? nullptr : &m_data[m_head];
+}
+
+template<typename T, std::size_t N, typename Alloc>
+const T* SmallQueue<T, N, Alloc>::tryFront() const
+{
+    return m_size == 0 ? nullptr : &m_data[m_head];
+}
+
+template<typename T, std::size_t N, typename Alloc>
+std::optional<T> SmallQueue<T, N, Alloc>::tryPop()
+{
+    if(m_size == 0){ //the common case for a polling consumer, no exception involved
+        return std::nullopt;
+    }
+    std::optional<T> result(std::move(m_data[m_head]));
+    this->removeFront();
+    return result;
+}
+
+template<typename T, std::size_t N, typename Alloc>
+std::size_t SmallQueue<T, N, Alloc>::size() const
+{
+    return m_size;
+}
+
+template<typename T, std::size_t N, typename Alloc>
+std::size_t SmallQueue<T, N, Alloc>::capacity() const
+{
+    return m_capacity;
+}
+
+template<typename T, std::size_t N, typename Alloc>
+bool SmallQueue<T, N, Alloc>::isInline() const
+{
+    return !this->onHeap();
+}
+
+template<typename T, std::size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::reserve(std::size_t count)
+{
+    this->reserveSlots(count);
+}
+
+template<typename T, std::size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::clear() noexcept
+{
+    this->truncate(0);
+    m_head = 0;
+}
+
+
+template<typename T, std::size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::shrinkToFit()
+{
+    this->shrinkBuffer();
+}
+
+template<typename T, std::size_t N, typename Alloc>
+Alloc SmallQueue<T, N, Alloc>::getAllocator() const
+{
+    return m_alloc;
+}
+
+template<typename T, std::size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::takeBuffer(SmallQueue& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+    if(!other.isInline()){ //stealing the heap buffer
+        m_data = other.m_data;
+        m_capacity = other.m_capacity;
+        m_head = other.m_head;
+        m_size = other.m_size;
+        other.m_data = other.inlineData();
+        other.m_capacity = INLINE_CAPACITY;
+        other.m_head = 0;
+        other.m_size = 0;
+        return;
+    }
+    if constexpr(BITWISE_COPY){ //at most INLINE_CAPACITY elements, they fit in this's inline array
+        other.forEachRun([this](const T* data, std::size_t count){
+            this->copyBack(data, count);
+        });
+    }
+    else{
+        for(T& data : other){ //at most INLINE_CAPACITY elements, they fit in this's inline array
+            AllocTraits::construct(m_alloc, m_data + m_size, std::move(data));
+            m_size++;
+        }
+    }
+    other.destroyBuffer();
+}
+
+#endif
@@ -0,0 +1,438 @@
+#ifndef SPILL_QUEUE_H
+#define SPILL_QUEUE_H
+
+#include <cstddef>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "Queue.h"
+
+/* SpillQueue:
+ *      Unbounded queue of trivially copyable elements that keeps only a bounded amount of them in memory
+ *      elements are stored in segments of segmentSize elements, like the chunks of ChunkedQueue
+ *      the head segment (being popped) and the tail segment (being pushed) are always in memory,
+ *      the full segments between them are kept in memory up to residentSegments of them,
+ *      every further segment is written to its own file and its memory reused for the next tail
+ *      the resident segments always come before the spilled ones, so pops use them up first
+ *      as soon as a spilled segment is next in line, a std::async task reads it back,
+ *      while the consumer works through the current head segment, so popFront doesn't wait for the disk
+ *
+ *  files are named pathPrefix + number + ".seg" and removed once read back or when the queue is destroyed,
+ *  the prefix has to be unique per queue; the files are scratch space, not a persistent queue (see MappedQueue)
+ *  copying and moving are disabled, the queue owns its files
+ */
+template <class T>
+class SpillQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "SpillQueue writes its elements as raw bytes");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "segments are allocated with new[]");
+private:
+
+    //private segment struct, elements are stored as raw bytes
+    struct Segment {
+        std::unique_ptr<unsigned char[]> storage; //raw storage of the elements, nullptr while spilled
+        std::size_t count; //amount of elements in the segment
+        std::string path; //file holding the elements while spilled, empty while resident
+
+        //C'tor of a segment, takes the storage over only once the segment is built
+        Segment(std::unique_ptr<unsigned char[]> data, std::size_t size, std::string file) :
+            storage(std::move(data)),
+            count(size),
+            path(std::move(file))
+        { }
+
+        //returns the slot of the element at the given index
+        T* slot(std::size_t index) const noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(storage.get()) + index);
+        }
+    };
+
+    std::string m_prefix; //beginning of the name of every spill file
+    std::size_t m_segmentSize; //amount of elements in a full segment
+    std::size_t m_residentLimit; //amount of full segments kept in memory between the head and the tail
+    Segment m_head; //segment being popped
+    std::size_t m_headIndex; //index of the front element in m_head
+    Segment m_tail; //segment being pushed, m_tail.count is where the next element goes
+    Queue<Segment> m_middle; //full segments between head and tail, resident ones first
+    std::size_t m_resident; //amount of resident segments in m_middle
+    std::unique_ptr<unsigned char[]> m_spare; //storage of a spilled or used up segment kept for the next tail
+    std::future<std::unique_ptr<unsigned char[]>> m_prefetch; //read of the front of m_middle, if it is spilled
+    std::size_t m_nextFile; //number of the next spill file
+    std::size_t m_size; //size of the queue
+
+    //storage of a segment, the spare one if there is one
+    std::unique_ptr<unsigned char[]> acquireStorage();
+
+    //moves the full tail segment behind the others, writing it to a file if the resident ones are used up
+    void retireTail();
+
+    //writes the elements of a segment to a new file and returns its path, the segment is untouched
+    std::string spill(const Segment& segment);
+
+    //makes the next segment the head, the current head is used up and the queue isn't empty
+    void advanceHead();
+
+    //starts reading the front of m_middle back if it is spilled and no read is on its way
+    void startPrefetch() noexcept;
+
+    //reads the elements of a spill file into new storage and removes the file, throws FileError
+    static std::unique_ptr<unsigned char[]> load(const std::string& path, std::size_t bytes);
+
+public:
+
+    /**
+     * @brief Construct a new empty SpillQueue
+     *
+     * @param pathPrefix - beginning of the path of the spill files, e.g. "/var/tmp/jobs-"
+     * @param segmentSize - amount of elements read or written at once, at least 1
+     * @param residentSegments - amount of full segments kept in memory before spilling to disk
+     */
+    explicit SpillQueue(const std::string& pathPrefix, std::size_t segmentSize = 64 * 1024,
+                        std::size_t residentSegments = 4);
+
+    /**
+     * @brief Destroys the SpillQueue, removing every spill file left
+     *
+     */
+    ~SpillQueue();
+
+    SpillQueue(const SpillQueue&) = delete;
+    SpillQueue& operator=(const SpillQueue&) = delete;
+
+    /**
+     * @brief Inserts in the back of the SpillQueue
+     *      once every segmentSize pushes the filled segment is retired, which may write it to disk
+     *
+     * @param val - value to be inserted
+     */
+    void pushBack(const T& val);
+
+    /**
+     * @brief Constructs a new element in the back of the SpillQueue
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     */
+    template<typename... Args>
+    void emplaceBack(Args&&... args);
+
+    /**
+     * @brief Returns a reference to the front of the queue
+     *
+     * @return - reference to the data stored in the front
+     */
+    T& front();
+
+    /**
+     * @brief Returns a const reference to the front of the queue
+     *
+     * @return - const reference to the data stored in the front
+     */
+    const T& front() const;
+
+    /**
+     * @brief Pops the element in the front of the queue
+     *      once every segmentSize pops the next segment becomes the head, waiting for its read if it isn't done
+     *
+     */
+    void popFront();
+
+    /**
+     * @brief Returns a pointer to the front of the queue without throwing
+     *
+     * @return - pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    T* tryFront();
+
+    /**
+     * @brief Copies the front element out of the queue and pops it, without throwing on an empty queue
+     *
+     * @return - the front element, or an empty optional if the queue is empty
+     */
+    std::optional<T> tryPop();
+
+    /**
+     * @brief Checks if the queue is empty
+     *
+     * @return true if the queue holds no elements
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns the size of the queue
+     *
+     * @return - size of the queue
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Returns the amount of segments that are currently on disk
+     *
+     * @return - amount of spill files
+     */
+    std::size_t spilledSegments() const;
+
+    /**
+     * @brief Exception Class to deal with invalid operations done on an empty SpillQueue
+     *
+     *  Invalid operators on an empty SpillQueue:
+     *      front, popFront
+     */
+    class EmptyQueue {};
+
+    /**
+     * @brief Exception Class to deal with a spill file that can't be written or read back
+     *
+     *  thrown by pushBack and emplaceBack when writing a segment fails,
+     *  and by popFront when reading one back fails
+     */
+    class FileError {};
+};
+
+template<typename T>
+SpillQueue<T>::SpillQueue(const std::string& pathPrefix, std::size_t segmentSize, std::size_t residentSegments) :
+    m_prefix(pathPrefix),
+    m_segmentSize(segmentSize == 0 ? 1 : segmentSize),
+    m_residentLimit(residentSegments),
+    m_head(nullptr, 0, std::string()),
+    m_headIndex(0),
+    m_tail(nullptr, 0, std::string()),
+    m_middle(),
+    m_resident(0),
+    m_spare(),
+    m_prefetch(),
+    m_nextFile(0),
+    m_size(0)
+{ }
+
+template<typename T>
+SpillQueue<T>::~SpillQueue()
+{
+    if(m_prefetch.valid()){ //the read still uses its file
+        m_prefetch.wait();
+    }
+    for(Segment& segment : m_middle){
+        if(!segment.path.empty()){
+            std::remove(segment.path.c_str());
+        }
+    }
+}
+
+template<typename T>
+void SpillQueue<T>::pushBack(const T& val)
+{
+    if(m_tail.storage == nullptr){
+        m_tail.storage = this->acquireStorage();
+    }
+    ::new (static_cast<void*>(m_tail.slot(m_tail.count))) T(val);
+    m_tail.count++;
+    m_size++;
+    if(m_size == 1){ //queue was empty, the new element becomes the front
+        this->advanceHead();
+    }
+    else if(m_tail.count == m_segmentSize){
+        try{
+            this->retireTail();
+        } catch(...){ //the segment couldn't be retired, undoing the push leaves the queue unchanged
+            m_tail.count--;
+            m_size--;
+            throw;
+        }
+    }
+}
+
+template<typename T>
+template<typename... Args>
+void SpillQueue<T>::emplaceBack(Args&&... args)
+{
+    this->pushBack(T(std::forward<Args>(args)...));
+}
+
+template<typename T>
+T& SpillQueue<T>::front()
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    return *m_head.slot(m_headIndex);
+}
+
+template<typename T>
+const T& SpillQueue<T>::front() const
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    return *m_head.slot(m_headIndex);
+}
+
+template<typename T>
+void SpillQueue<T>::popFront()
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    m_headIndex++; //trivially copyable, nothing to destroy
+    m_size--;
+    if(m_headIndex == m_head.count && m_size != 0){ //head is used up, the front is in the next segment
+        try{
+            this->advanceHead();
+        } catch(...){ //the next segment couldn't be read, the front element stays in the queue
+            m_headIndex--;
+            m_size++;
+            throw;
+        }
+    }
+}
+
+template<typename T>
+T* SpillQueue<T>::tryFront()
+{
+    return m_size == 0 ? nullptr : m_head.slot(m_headIndex);
+}
+
+template<typename T>
+std::optional<T> SpillQueue<T>::tryPop()
+{
+    if(m_size == 0){
+        return std::nullopt;
+    }
+    std::optional<T> result(*m_head.slot(m_headIndex));
+    this->popFront();
+    return result;
+}
+
+template<typename T>
+bool SpillQueue<T>::empty() const
+{
+    return m_size == 0;
+}
+
+template<typename T>
+std::size_t SpillQueue<T>::size() const
+{
+    return m_size;
+}
+
+template<typename T>
+std::size_t SpillQueue<T>::spilledSegments() const
+{
+    return m_middle.size() - m_resident;
+}
+
+template<typename T>
+std::unique_ptr<unsigned char[]> SpillQueue<T>::acquireStorage()
+{
+    if(m_spare != nullptr){
+        return std::move(m_spare);
+    }
+    return std::unique_ptr<unsigned char[]>(new unsigned char[m_segmentSize * sizeof(T)]);
+}
+
+template<typename T>
+void SpillQueue<T>::retireTail()
+{
+    if(m_resident == m_middle.size() && m_resident < m_residentLimit){ //nothing spilled and there is room
+        m_middle.emplaceBack(std::move(m_tail.storage), m_tail.count, std::string());
+        m_resident++;
+    }
+    else{ //a spilled segment is never followed by a resident one
+        std::string path = this->spill(m_tail);
+        try{
+            m_middle.emplaceBack(nullptr, m_tail.count, path);
+        } catch(...){
+            std::remove(path.c_str());
+            throw;
+        }
+        m_spare = std::move(m_tail.storage); //the next tail reuses the memory
+    }
+    m_tail.count = 0;
+    this->startPrefetch();
+}
+
+template<typename T>
+std::string SpillQueue<T>::spill(const Segment& segment)
+{
+    std::string path = m_prefix + std::to_string(m_nextFile++) + ".seg";
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if(file == nullptr){
+        throw FileError();
+    }
+    std::size_t written = std::fwrite(segment.storage.get(), sizeof(T), segment.count, file);
+    if(std::fclose(file) != 0 || written != segment.count){
+        std::remove(path.c_str());
+        throw FileError();
+    }
+    return path;
+}
+
+template<typename T>
+void SpillQueue<T>::advanceHead()
+{
+    std::unique_ptr<unsigned char[]> storage;
+    std::size_t count;
+    if(m_middle.empty()){ //every element is in the tail, it becomes the head
+        storage = std::move(m_tail.storage);
+        count = m_tail.count;
+        m_tail.count = 0;
+    }
+    else{
+        Segment& next = m_middle.front();
+        count = next.count;
+        if(next.path.empty()){
+            storage = std::move(next.storage);
+            m_resident--;
+        }
+        else if(m_prefetch.valid()){ //usually done by now, the consumer just went through a whole segment
+            storage = m_prefetch.get();
+        }
+        else{ //the prefetch failed or couldn't be started
+            storage = load(next.path, count * sizeof(T));
+        }
+        m_middle.popFront();
+    }
+
+    if(m_spare == nullptr){ //the used up head is the next tail
+        m_spare = std::move(m_head.storage);
+    }
+    m_head.storage = std::move(storage);
+    m_head.count = count;
+    m_headIndex = 0;
+    this->startPrefetch();
+}
+
+template<typename T>
+void SpillQueue<T>::startPrefetch() noexcept
+{
+    if(m_prefetch.valid() || m_middle.empty() || m_middle.front().path.empty()){
+        return;
+    }
+    const Segment& next = m_middle.front();
+    try{
+        m_prefetch = std::async(std::launch::async, &SpillQueue::load, next.path, next.count * sizeof(T));
+    } catch(...){ //no thread to read with, advanceHead reads the segment itself
+    }
+}
+
+template<typename T>
+std::unique_ptr<unsigned char[]> SpillQueue<T>::load(const std::string& path, std::size_t bytes)
+{
+    std::unique_ptr<unsigned char[]> storage(new unsigned char[bytes]);
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if(file == nullptr){
+        throw FileError();
+    }
+    std::size_t read = std::fread(storage.get(), 1, bytes, file);
+    std::fclose(file);
+    if(read != bytes){
+        throw FileError();
+    }
+    std::remove(path.c_str());
+    return storage;
+}
+
+#endif
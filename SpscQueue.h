@@ -0,0 +1,272 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include "Backoff.h"
+#include "CacheLine.h"
+
+/* SpscQueue:
+ *      Lock-free bounded queue for exactly one producer thread and one consumer thread
+ *      elements live in a power of 2 ring buffer allocated once by the c'tor
+ *      the producer only writes m_tail and the consumer only writes m_head, there is no shared size counter
+ *      each index is published with release and read with acquire, so an element is fully constructed
+ *      before the consumer can see it and fully destroyed before the producer can reuse its slot
+ *      each side keeps a cached copy of the other side's index and only reloads it when the cache says
+ *      the queue looks full (producer) or empty (consumer), so most operations touch no shared cache line
+ *
+ *  push and pop are the blocking versions, they back off (see Backoff.h) until there is room or an element
+ *
+ *  calling the producer functions (tryPush, tryEmplace, push) from more than one thread,
+ *  or the consumer functions (tryPop, pop) from more than one thread, is undefined
+ */
+template <class T>
+class alignas(CACHE_LINE_SIZE) SpscQueue { //aligned so the producer line doesn't share a line with a neighbour
+public:
+
+    /**
+     * @brief Construct a new SpscQueue, allocates all the storage the queue will ever use
+     *
+     * @param capacity - minimal amount of elements the queue can hold, rounded up to a power of 2
+     */
+    explicit SpscQueue(std::size_t capacity);
+
+    /**
+     * @brief Destroys the SpscQueue and every element left in it
+     *      must not run concurrently with any other function
+     *
+     */
+    ~SpscQueue();
+
+    /**
+     * A queue shared between threads has a fixed address, copying and moving are disabled
+     *
+     */
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Inserts in the back of the queue if there is room, producer only
+     *
+     * @param val - value to be inserted
+     * @return true if the value was inserted
+     * @return false if the queue is full
+     */
+    bool tryPush(const T& val);
+
+    /**
+     * @brief Moves a value into the back of the queue if there is room, producer only
+     *
+     * @param val - value to be moved into the queue, untouched if the queue is full
+     * @return true if the value was inserted
+     * @return false if the queue is full
+     */
+    bool tryPush(T&& val);
+
+    /**
+     * @brief Constructs a new element in place in the back of the queue if there is room, producer only
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     * @return true if the element was constructed
+     * @return false if the queue is full
+     */
+    template<typename... Args>
+    bool tryEmplace(Args&&... args);
+
+    /**
+     * @brief Moves the front element into out and pops it, consumer only
+     *
+     * @param out - receives the front element, untouched if the queue is empty
+     * @return true if an element was popped
+     * @return false if the queue is empty
+     */
+    bool tryPop(T& out);
+
+    /**
+     * @brief Inserts in the back of the queue, waits for room while the queue is full, producer only
+     *
+     * @param val - value to be inserted
+     */
+    void push(const T& val);
+
+    /**
+     * @brief Moves a value into the back of the queue, waits for room while the queue is full, producer only
+     *
+     * @param val - value to be moved into the queue
+     */
+    void push(T&& val);
+
+    /**
+     * @brief Moves the front element into out and pops it, waits while the queue is empty, consumer only
+     *
+     * @param out - receives the front element
+     */
+    void pop(T& out);
+
+    /**
+     * @brief Returns the amount of elements in the queue
+     *      exact when called by the producer or the consumer while the other side is idle,
+     *      otherwise a snapshot that may already be stale
+     *
+     * @return - amount of elements in the queue
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Checks if the queue is empty, same staleness as size()
+     *
+     * @return true if the queue is empty
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns the maximal amount of elements the queue can hold
+     *
+     * @return - capacity of the queue
+     */
+    std::size_t capacity() const;
+
+private:
+    //read-only after construction, shared by both sides
+    T* m_data; //ring buffer of m_mask + 1 slots
+    std::size_t m_mask; //capacity - 1
+
+    //consumer side: index of the front, unwrapped
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head;
+    std::size_t m_cachedTail; //last value of m_tail seen by the consumer
+
+    //producer side: index beyond the rear, unwrapped
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail;
+    std::size_t m_cachedHead; //last value of m_head seen by the producer
+
+    //rounds capacity up to a power of 2, at least 1
+    static std::size_t roundCapacity(std::size_t capacity);
+};
+
+template<typename T>
+SpscQueue<T>::SpscQueue(std::size_t capacity) :
+    m_data(std::allocator<T>().allocate(roundCapacity(capacity))),
+    m_mask(roundCapacity(capacity) - 1),
+    m_head(0),
+    m_cachedTail(0),
+    m_tail(0),
+    m_cachedHead(0)
+{ }
+
+template<typename T>
+SpscQueue<T>::~SpscQueue()
+{
+    std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    for(std::size_t i = m_head.load(std::memory_order_relaxed); i != tail; i++){
+        m_data[i & m_mask].~T();
+    }
+    std::allocator<T>().deallocate(m_data, m_mask + 1);
+}
+
+template<typename T>
+bool SpscQueue<T>::tryPush(const T& val)
+{
+    return this->tryEmplace(val);
+}
+
+template<typename T>
+bool SpscQueue<T>::tryPush(T&& val)
+{
+    return this->tryEmplace(std::move(val));
+}
+
+template<typename T>
+template<typename... Args>
+bool SpscQueue<T>::tryEmplace(Args&&... args)
+{
+    std::size_t tail = m_tail.load(std::memory_order_relaxed); //only the producer writes m_tail
+    if(tail - m_cachedHead > m_mask){ //looks full, refreshing the consumer's index
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        if(tail - m_cachedHead > m_mask){
+            return false;
+        }
+    }
+    ::new (static_cast<void*>(m_data + (tail & m_mask))) T(std::forward<Args>(args)...);
+    m_tail.store(tail + 1, std::memory_order_release); //publishes the constructed element
+    return true;
+}
+
+template<typename T>
+bool SpscQueue<T>::tryPop(T& out)
+{
+    std::size_t head = m_head.load(std::memory_order_relaxed); //only the consumer writes m_head
+    if(head == m_cachedTail){ //looks empty, refreshing the producer's index
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        if(head == m_cachedTail){
+            return false;
+        }
+    }
+    T* slot = m_data + (head & m_mask);
+    out = std::move(*slot);
+    slot->~T();
+    m_head.store(head + 1, std::memory_order_release); //hands the slot back to the producer
+    return true;
+}
+
+template<typename T>
+void SpscQueue<T>::push(const T& val)
+{
+    Backoff backoff;
+    while(!this->tryEmplace(val)){
+        backoff.pause();
+    }
+}
+
+template<typename T>
+void SpscQueue<T>::push(T&& val)
+{
+    Backoff backoff;
+    while(!this->tryEmplace(std::move(val))){ //val is only moved from by the attempt that succeeds
+        backoff.pause();
+    }
+}
+
+template<typename T>
+void SpscQueue<T>::pop(T& out)
+{
+    Backoff backoff;
+    while(!this->tryPop(out)){
+        backoff.pause();
+    }
+}
+
+template<typename T>
+std::size_t SpscQueue<T>::size() const
+{
+    std::size_t head = m_head.load(std::memory_order_acquire);
+    std::size_t tail = m_tail.load(std::memory_order_acquire);
+    std::size_t used = tail - head; //head loaded first, so tail is never behind it
+    return used > m_mask + 1 ? m_mask + 1 : used; //the producer may have refilled popped slots in between
+}
+
+template<typename T>
+bool SpscQueue<T>::empty() const
+{
+    return this->size() == 0;
+}
+
+template<typename T>
+std::size_t SpscQueue<T>::capacity() const
+{
+    return m_mask + 1;
+}
+
+template<typename T>
+std::size_t SpscQueue<T>::roundCapacity(std::size_t capacity)
+{
+    std::size_t rounded = 1;
+    while(rounded < capacity){
+        rounded *= 2;
+    }
+    return rounded;
+}
+
+#endif
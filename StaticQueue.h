@@ -0,0 +1,693 @@
+#ifndef STATIC_QUEUE_H
+#define STATIC_QUEUE_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "QueueAlgorithms.h"
+#include "QueueConfig.h"
+
+/* StaticQueue:
+ *      Queue with the same interface as Queue<T> and a capacity of N fixed at compile time
+ *      the elements live in a std::array inside the object, nothing is ever allocated
+ *      every operation is constexpr, so a StaticQueue can be filled, filtered and transformed
+ *      while building a compile-time table (T has to be a literal type there)
+ *      for a power of 2 N wrapping an index is a mask, otherwise a compare and subtract, never a modulo
+ *
+ *  the N slots always hold objects, so T has to be default constructible and move assignable
+ *  pushing assigns to a vacant slot, popping moves the element out and assigns T() back,
+ *  for a trivially destructible T the popped slot is simply left as it is
+ *  copying a StaticQueue copies all N slots
+ *
+ * @tparam T - type of the elements
+ * @tparam N - maximal amount of elements
+ */
+template <class T, std::size_t N>
+class StaticQueue {
+    static_assert(N > 0, "N must be positive");
+    static_assert(std::is_default_constructible<T>::value, "the slots of a StaticQueue are default constructed");
+private:
+    std::array<T, N> m_data; //circular buffer of N slots
+    std::size_t m_head; //index of the front of the queue in m_data
+    std::size_t m_size; //size of the queue, dynamically increasing and decreasing as the queue changes
+
+    //true when an index is wrapped with a mask
+    static constexpr bool POWER_OF_2 = (N & (N - 1)) == 0;
+
+    //true when releasing a slot can't throw
+    static constexpr bool NOTHROW_RELEASE = std::is_trivially_destructible<T>::value ||
+                                            (std::is_nothrow_default_constructible<T>::value &&
+                                             std::is_nothrow_move_assignable<T>::value);
+
+    /* RawIterator:
+     *      Iterator class that supports both const iteration and normal iteration
+     *      requires a template that decides which type of iteration to do
+     *      for normal iteration: use Iterator
+     *      for const iteration: use ConstIterator
+     */
+    template<typename Modified_Type>
+    class RawIterator;
+
+    //wraps an index below 2 * N into the buffer
+    static constexpr std::size_t wrap(std::size_t index) noexcept;
+
+    //index in m_data of the element at the given distance from the front
+    constexpr std::size_t slot(std::size_t index) const noexcept;
+
+    //gives up the resources of a vacant slot, a no-op for a trivially destructible T
+    static constexpr void release(T& slot) noexcept(NOTHROW_RELEASE);
+
+    //pops the front element, the queue must not be empty
+    constexpr void removeFront() noexcept(NOTHROW_RELEASE);
+
+    //pops the elements beyond the first size elements
+    constexpr void truncate(std::size_t size) noexcept(NOTHROW_RELEASE);
+
+public:
+
+    /**
+     * @brief Construct a new empty StaticQueue
+     *
+     */
+    constexpr StaticQueue();
+
+    /**
+     * Explicitly stating that we use default copy and move, every slot is copied or moved
+     *
+     */
+    StaticQueue(const StaticQueue&) = default;
+    StaticQueue(StaticQueue&&) = default;
+    StaticQueue& operator=(const StaticQueue&) = default;
+    StaticQueue& operator=(StaticQueue&&) = default;
+
+    /**
+     * @brief Inserts in the back of the StaticQueue if there is room
+     *
+     * @param val - value to be inserted
+     * @return true if the value was inserted
+     * @return false if the queue is full
+     */
+    constexpr bool tryPush(const T& val);
+
+    /**
+     * @brief Moves a value into the back of the StaticQueue if there is room
+     *
+     * @param val - value to be moved into the queue, untouched if the queue is full
+     * @return true if the value was inserted
+     * @return false if the queue is full
+     */
+    constexpr bool tryPush(T&& val);
+
+    /**
+     * @brief Constructs a new element in the back of the StaticQueue if there is room
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     * @return true if the element was constructed
+     * @return false if the queue is full
+     */
+    template<typename... Args>
+    constexpr bool tryEmplace(Args&&... args);
+
+    /**
+     * @brief Inserts in the back of the StaticQueue
+     *
+     * @param val - value to be inserted
+     */
+    constexpr void pushBack(const T& val);
+
+    /**
+     * @brief Inserts in the back of the StaticQueue by moving the given value
+     *
+     * @param val - value to be moved into the queue
+     */
+    constexpr void pushBack(T&& val);
+
+    /**
+     * @brief Constructs a new element in the back of the StaticQueue, then moves it into its slot
+     *
+     * @param args - arguments forwarded to the c'tor of T
+     * @return - reference to the new element
+     */
+    template<typename... Args>
+    constexpr T& emplaceBack(Args&&... args);
+
+    /**
+     * @brief Inserts the elements of [first, last) in the back of the queue, in order
+     *
+     *      a forward range that doesn't fit throws FullQueue before anything is inserted
+     *      strong guarantee: if an element can't be inserted, the queue is left unchanged
+     *      not constexpr, undoing a failed insertion needs a try block
+     *
+     * @param first - beginning of the range to insert
+     * @param last - end of the range to insert
+     */
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void pushBack(InputIt first, InputIt last);
+
+    /**
+     * @brief Returns a reference to the front of the queue
+     *
+     * @return - reference to the data stored in the front
+     */
+    constexpr T& front();
+
+    /**
+     * @brief Returns a const reference to the front of the queue
+     *
+     * @return - const reference to the data stored in the front
+     */
+    constexpr const T& front() const;
+
+    /**
+     * @brief Pops the element in the front of the queue
+     *
+     */
+    constexpr void popFront();
+
+    /**
+     * @brief Pops the n elements in the front of the queue
+     *
+     * @param n - amount of elements to pop, if the queue holds fewer EmptyQueue is thrown and nothing is popped
+     */
+    constexpr void popFront(std::size_t n);
+
+    /**
+     * @brief Returns a pointer to the front of the queue without throwing
+     *
+     * @return - pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    constexpr T* tryFront();
+
+    /**
+     * @brief Returns a const pointer to the front of the queue without throwing
+     *
+     * @return - const pointer to the data stored in the front, nullptr if the queue is empty
+     */
+    constexpr const T* tryFront() const;
+
+    /**
+     * @brief Moves the front element out of the queue and pops it, without throwing on an empty queue
+     *
+     * @return - the front element, or an empty optional if the queue is empty
+     */
+    constexpr std::optional<T> tryPop();
+
+    /**
+     * @brief Checks if the queue is empty
+     *
+     * @return true if the queue holds no elements
+     */
+    constexpr bool empty() const;
+
+    /**
+     * @brief Checks if the queue is full
+     *
+     * @return true if the queue holds N elements
+     */
+    constexpr bool full() const;
+
+    /**
+     * @brief Returns the size of the queue
+     *
+     * @return - size of the queue
+     */
+    constexpr std::size_t size() const;
+
+    /**
+     * @brief Returns the maximal amount of elements the queue can hold
+     *
+     * @return - N
+     */
+    static constexpr std::size_t capacity();
+
+    /**
+     * @brief Pops every element
+     *
+     */
+    constexpr void clear() noexcept(NOTHROW_RELEASE);
+
+    /**
+     * @brief Calls visit(data, count) for every contiguous run of elements, front to back
+     *      a buffer that doesn't wrap around is a single run, a wrapping one two runs
+     *
+     * @param visit - callable taking a const T* to the first element of a run and the length of the run
+     */
+    template<typename Visitor>
+    constexpr void forEachRun(Visitor visit) const;
+
+    /**
+     * @brief Iterator class for StaticQueue
+     *
+     */
+    typedef RawIterator<T> Iterator;
+
+    /**
+     * @brief Const Iterator class for StaticQueue
+     *
+     */
+    typedef RawIterator<const T> ConstIterator;
+
+    /**
+     * @brief Returns an Iterator pointing to the front of the StaticQueue
+     */
+    constexpr Iterator begin()
+    {
+        return Iterator(m_data.data(), m_head, m_head + m_size);
+    }
+
+    /**
+     * @brief Returns an Iterator pointing to the end of the StaticQueue
+     */
+    constexpr Iterator end()
+    {
+        return Iterator(m_data.data(), m_head + m_size, m_head + m_size);
+    }
+
+    /**
+     * @brief Returns a Const Iterator pointing to the front of the StaticQueue
+     */
+    constexpr ConstIterator begin() const
+    {
+        return ConstIterator(m_data.data(), m_head, m_head + m_size);
+    }
+
+    /**
+     * @brief Returns a Const Iterator pointing to the end of the StaticQueue
+     */
+    constexpr ConstIterator end() const
+    {
+        return ConstIterator(m_data.data(), m_head + m_size, m_head + m_size);
+    }
+
+    /**
+     * @brief Exception Class to deal with invalid operations done on an empty StaticQueue
+     *
+     *  Invalid operators on an empty StaticQueue:
+     *      front, popFront
+     */
+    class EmptyQueue {};
+
+    /**
+     * @brief Exception Class to deal with pushing into a full StaticQueue
+     *
+     *  Invalid operators on a full StaticQueue:
+     *      pushBack, emplaceBack
+     */
+    class FullQueue {};
+};
+
+template<typename T, std::size_t N>
+constexpr StaticQueue<T, N>::StaticQueue() :
+    m_data(),
+    m_head(0),
+    m_size(0)
+{ }
+
+template<typename T, std::size_t N>
+constexpr bool StaticQueue<T, N>::tryPush(const T& val)
+{
+    return this->tryEmplace(val);
+}
+
+template<typename T, std::size_t N>
+constexpr bool StaticQueue<T, N>::tryPush(T&& val)
+{
+    return this->tryEmplace(std::move(val));
+}
+
+template<typename T, std::size_t N>
+template<typename... Args>
+constexpr bool StaticQueue<T, N>::tryEmplace(Args&&... args)
+{
+    if(m_size == N){ //the full queue is reported, not thrown
+        return false;
+    }
+    m_data[this->slot(m_size)] = T(std::forward<Args>(args)...);
+    m_size++;
+    return true;
+}
+
+template<typename T, std::size_t N>
+constexpr void StaticQueue<T, N>::pushBack(const T& val)
+{
+    this->emplaceBack(val);
+}
+
+template<typename T, std::size_t N>
+constexpr void StaticQueue<T, N>::pushBack(T&& val)
+{
+    this->emplaceBack(std::move(val));
+}
+
+template<typename T, std::size_t N>
+template<typename... Args>
+constexpr T& StaticQueue<T, N>::emplaceBack(Args&&... args)
+{
+    if(m_size == N){ //operation is invalid on a full queue
+        throw FullQueue();
+    }
+    T& target = m_data[this->slot(m_size)];
+    target = T(std::forward<Args>(args)...);
+    m_size++;
+    return target;
+}
+
+template<typename T, std::size_t N>
+template<typename InputIt, typename>
+void StaticQueue<T, N>::pushBack(InputIt first, InputIt last)
+{
+    typedef typename std::iterator_traits<InputIt>::iterator_category Category;
+    if constexpr(std::is_base_of<std::forward_iterator_tag, Category>::value){
+        if(static_cast<std::size_t>(std::distance(first, last)) > N - m_size){ //checked once for the whole range
+            throw FullQueue();
+        }
+    }
+
+    std::size_t oldSize = m_size;
+    try{
+        for(; first != last; ++first){
+            this->emplaceBack(*first);
+        }
+    } catch(...){ //removing what was already inserted
+        this->truncate(oldSize);
+        throw;
+    }
+}
+
+template<typename T, std::size_t N>
+constexpr T& StaticQueue<T, N>::front()
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    else{ //normal reference to the data
+        return m_data[m_head];
+    }
+}
+
+template<typename T, std::size_t N>
+constexpr const T& StaticQueue<T, N>::front() const
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    else{ //const reference to the data
+        return m_data[m_head];
+    }
+}
+
+template<typename T, std::size_t N>
+constexpr void StaticQueue<T, N>::popFront()
+{
+    if(m_size == 0){ //operation is invalid on an empty queue
+        throw EmptyQueue();
+    }
+    else{
+        this->removeFront();
+    }
+}
+
+template<typename T, std::size_t N>
+constexpr void StaticQueue<T, N>::popFront(std::size_t n)
+{
+    if(n > m_size){ //checked once for the whole batch
+        throw EmptyQueue();
+    }
+    for(std::size_t i = 0; i < n; i++){
+        this->removeFront();
+    }
+}
+
+template<typename T, std::size_t N>
+constexpr T* StaticQueue<T, N>::tryFront()
+{
+    return m_size == 0 ? nullptr : &m_data[m_head];
+}
+
+template<typename T, std::size_t N>
+constexpr const T* StaticQueue<T, N>::tryFront() const
+{
+    return m_size == 0 ? nullptr : &m_data[m_head];
+}
+
+template<typename T, std::size_t N>
+constexpr std::optional<T> StaticQueue<T, N>::tryPop()
+{
+    if(m_size == 0){ //the common case for a polling consumer, no exception involved
+        return std::nullopt;
+    }
+    std::optional<T> result(std::move(m_data[m_head]));
+    this->removeFront();
+    return result;
+}
+
+template<typename T, std::size_t N>
+constexpr bool StaticQueue<T, N>::empty() const
+{
+    return m_size == 0;
+}
+
+template<typename T, std::size_t N>
+constexpr bool StaticQueue<T, N>::full() const
+{
+    return m_size == N;
+}
+
+template<typename T, std::size_t N>
+constexpr std::size_t StaticQueue<T, N>::size() const
+{
+    return m_size;
+}
+
+template<typename T, std::size_t N>
+constexpr std::size_t StaticQueue<T, N>::capacity()
+{
+    return N;
+}
+
+template<typename T, std::size_t N>
+constexpr void StaticQueue<T, N>::clear() noexcept(NOTHROW_RELEASE)
+{
+    this->truncate(0);
+    m_head = 0;
+}
+
+template<typename T, std::size_t N>
+template<typename Visitor>
+constexpr void StaticQueue<T, N>::forEachRun(Visitor visit) const
+{
+    if(m_size == 0){
+        return;
+    }
+    std::size_t first = N - m_head < m_size ? N - m_head : m_size; //elements before the wrap
+    visit(m_data.data() + m_head, first);
+    if(first < m_size){
+        visit(m_data.data(), m_size - first);
+    }
+}
+
+template<typename T, std::size_t N>
+constexpr std::size_t StaticQueue<T, N>::wrap(std::size_t index) noexcept
+{
+    if constexpr(POWER_OF_2){
+        return index & (N - 1);
+    }
+    else{
+        return index < N ? index : index - N;
+    }
+}
+
+template<typename T, std::size_t N>
+constexpr std::size_t StaticQueue<T, N>::slot(std::size_t index) const noexcept
+{
+    return wrap(m_head + index);
+}
+
+template<typename T, std::size_t N>
+constexpr void StaticQueue<T, N>::release(T& slot) noexcept(NOTHROW_RELEASE)
+{
+    if constexpr(!std::is_trivially_destructible<T>::value){
+        slot = T();
+    }
+    else{
+        (void)slot;
+    }
+}
+
+template<typename T, std::size_t N>
+constexpr void StaticQueue<T, N>::removeFront() noexcept(NOTHROW_RELEASE)
+{
+    release(m_data[m_head]);
+    m_head = wrap(m_head + 1);
+    m_size--;
+}
+
+template<typename T, std::size_t N>
+constexpr void StaticQueue<T, N>::truncate(std::size_t size) noexcept(NOTHROW_RELEASE)
+{
+    while(m_size > size){
+        m_size--;
+        release(m_data[this->slot(m_size)]);
+    }
+}
+
+template<typename T, std::size_t N>
+template<typename Modified_Type>
+class StaticQueue<T, N>::RawIterator {
+public:
+    //allowing the use of ConstIterator with a non-const StaticQueue by conversion
+    constexpr operator typename StaticQueue<T, N>::template RawIterator<const Modified_Type>() const
+    {
+        return typename StaticQueue<T, N>::template RawIterator<const Modified_Type>(m_data, m_position, m_end);
+    }
+private:
+    Modified_Type* m_data; //buffer of the queue to be iterated
+    std::size_t m_position; //unwrapped position the iterator points to
+    std::size_t m_end; //unwrapped position beyond the last element
+
+    /**
+     * @brief Constructor for an Iterator
+     *
+     * @param data - buffer of the queue to iterate
+     * @param position - initial unwrapped position to point to
+     * @param end - unwrapped position beyond the last element
+     */
+    constexpr RawIterator(Modified_Type* data, std::size_t position, std::size_t end) :
+        m_data(data),
+        m_position(position),
+        m_end(end)
+    { }
+
+    //throws InvalidOperation if the iterator points to the end, only asserts with QUEUE_UNCHECKED_ITERATORS
+    constexpr void checkNotEnd() const
+    {
+#if QUEUE_UNCHECKED_ITERATORS
+        assert(m_position != m_end);
+#else
+        if(m_position == m_end){
+            throw InvalidOperation();
+        }
+#endif
+    }
+
+    //allows StaticQueue to access private c'tor
+    friend class StaticQueue<T, N>;
+public:
+
+    /**
+     * Standard iterator traits, RawIterator is a forward iterator
+     *
+     */
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::remove_const<Modified_Type>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Modified_Type* pointer;
+    typedef Modified_Type& reference;
+
+    /**
+     * @brief Constructs a singular iterator, that may only be assigned to or compared
+     *
+     */
+    constexpr RawIterator() :
+        m_data(nullptr),
+        m_position(0),
+        m_end(0)
+    { }
+
+    /**
+     * Explicitly stating that we use default c'tor, d'tor and assignment operator
+     *
+     */
+    RawIterator(const RawIterator&) = default;
+    ~RawIterator() = default;
+    RawIterator& operator=(const RawIterator&) = default;
+
+    /**
+     * @brief class for invalid operations done on iterator, thrown in following functions:
+     *
+     *  operator* when trying to dereference an element that's past the end
+     *  operator++(prefix and postfix) when trying to increment an iterator that's past the end
+     *  with QUEUE_UNCHECKED_ITERATORS these are assertions instead
+     */
+    class InvalidOperation {};
+
+    /**
+     * @brief Returns a reference to the data the iterator currently points to
+     *
+     * @return
+     *      reference if Iterator
+     *      const reference if ConstIterator
+     */
+    constexpr Modified_Type& operator*() const
+    {
+        this->checkNotEnd();
+        return m_data[StaticQueue<T, N>::wrap(m_position)];
+    }
+
+    /**
+     * @brief Returns a pointer to the data the iterator currently points to
+     *
+     * @return
+     *      pointer if Iterator
+     *      const pointer if ConstIterator
+     */
+    constexpr Modified_Type* operator->() const
+    {
+        return &**this;
+    }
+
+    /**
+     * @brief Prefix incrementing the Iterator, making it point to the next object
+     *
+     * @return - Iterator after the increment
+     */
+    constexpr RawIterator& operator++()
+    {
+        this->checkNotEnd();
+        m_position++;
+        return *this;
+    }
+
+    /**
+     * @brief Postfix incrementing the Iterator, making it point to the next object
+     *
+     * @return - Iterator before the increment
+     */
+    constexpr RawIterator operator++(int)
+    {
+        this->checkNotEnd();
+        RawIterator result = *this;
+        m_position++;
+        return result;
+    }
+
+    /**
+     * @brief Checks if 2 Iterators point to the same element
+     *
+     * @param other - Iterator to compare to
+     * @return true if Iterators point to the same element
+     * @return false if Iterators point to a different element
+     */
+    constexpr bool operator==(const RawIterator& other) const
+    {
+        return m_position == other.m_position;
+    }
+
+    /**
+     * @brief Checks if 2 Iterators point to different elements
+     *
+     * @param other - Iterator to compare to
+     * @return true if Iterators point to a different element
+     * @return false if Iterators point to the same element
+     */
+    constexpr bool operator!=(const RawIterator& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+#endif
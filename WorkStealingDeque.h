@@ -0,0 +1,227 @@
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "CacheLine.h"
+
+/* WorkStealingDeque:
+ *      Lock-free deque for a task scheduler (Chase & Lev, with the memory orders of Le et al.)
+ *      a single owner thread pushes and pops at the bottom, any amount of thieves steal from the top
+ *      the owner only races a thief over the last element, every other push and pop is free of atomic RMWs
+ *      elements live in a power of 2 circular array, the owner doubles it when it is full
+ *      a thief may still read an old array after it was replaced, so old arrays are kept until destruction
+ *
+ *  T is copied in and out of atomic slots and must be trivially copyable (task pointers, indices, handles)
+ *  calling push or pop from anything but the owner thread is undefined
+ *  copying and moving are disabled, the deque is meant to be shared by address
+ */
+template <class T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque requires a trivially copyable T");
+
+private:
+
+    //private circular array of the deque, indexed by the unwrapped top and bottom indices
+    struct Array {
+        std::int64_t mask; //capacity - 1
+        std::unique_ptr<std::atomic<T>[]> slots; //capacity slots
+
+        explicit Array(std::int64_t capacity) :
+            mask(capacity - 1),
+            slots(new std::atomic<T>[capacity])
+        { }
+
+        std::int64_t capacity() const
+        {
+            return mask + 1;
+        }
+
+        T get(std::int64_t index) const
+        {
+            return slots[index & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t index, T val)
+        {
+            slots[index & mask].store(val, std::memory_order_relaxed);
+        }
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> m_top; //next element to steal, written by thieves
+    alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> m_bottom; //beyond the last element, written by the owner
+    std::atomic<Array*> m_array; //current array, replaced by the owner only
+    std::vector<std::unique_ptr<Array>> m_arrays; //every array ever used, owner only
+
+    //doubles the array holding [top, bottom), owner only
+    Array* grow(Array* array, std::int64_t top, std::int64_t bottom);
+
+public:
+
+    /**
+     * @brief Construct a new empty WorkStealingDeque
+     *
+     * @param capacity - initial amount of elements the deque can hold before growing, rounded up to a power of 2
+     */
+    explicit WorkStealingDeque(std::size_t capacity = 64);
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * @brief Inserts at the bottom of the deque, owner only
+     *
+     * @param val - value to be inserted
+     */
+    void push(T val);
+
+    /**
+     * @brief Takes the element at the bottom of the deque (the last pushed), owner only
+     *
+     * @param out - receives the element, untouched on failure
+     * @return true if an element was taken
+     * @return false if the deque is empty or a thief took the last element
+     */
+    bool pop(T& out);
+
+    /**
+     * @brief Takes the element at the top of the deque (the first pushed), any thread
+     *
+     * @param out - receives the element, untouched on failure
+     * @return true if an element was stolen
+     * @return false if the deque is empty or another thread took the element first
+     */
+    bool steal(T& out);
+
+    /**
+     * @brief Returns the amount of elements in the deque, only a snapshot while other threads use it
+     *
+     * @return - approximate amount of elements in the deque
+     */
+    std::size_t approximateSize() const;
+
+    /**
+     * @brief Checks if the deque is empty, same staleness as approximateSize()
+     *
+     * @return true if the deque looks empty
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns the amount of elements the deque can hold before growing, owner only
+     *
+     * @return - capacity of the current array
+     */
+    std::size_t capacity() const;
+};
+
+template<typename T>
+WorkStealingDeque<T>::WorkStealingDeque(std::size_t capacity) :
+    m_top(0),
+    m_bottom(0),
+    m_array(nullptr)
+{
+    std::int64_t rounded = 1;
+    while(static_cast<std::size_t>(rounded) < capacity){
+        rounded *= 2;
+    }
+    m_arrays.emplace_back(new Array(rounded));
+    m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+}
+
+template<typename T>
+typename WorkStealingDeque<T>::Array* WorkStealingDeque<T>::grow(Array* array, std::int64_t top,
+                                                                 std::int64_t bottom)
+{
+    m_arrays.emplace_back(new Array(array->capacity() * 2));
+    Array* bigger = m_arrays.back().get();
+    for(std::int64_t i = top; i < bottom; i++){ //same indices, only the wrap-around changes
+        bigger->put(i, array->get(i));
+    }
+    m_array.store(bigger, std::memory_order_release);
+    return bigger;
+}
+
+template<typename T>
+void WorkStealingDeque<T>::push(T val)
+{
+    std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    std::int64_t top = m_top.load(std::memory_order_acquire);
+    Array* array = m_array.load(std::memory_order_relaxed);
+    if(bottom - top > array->mask){ //full
+        array = this->grow(array, top, bottom);
+    }
+    array->put(bottom, val);
+    std::atomic_thread_fence(std::memory_order_release); //the element is visible before the new bottom
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template<typename T>
+bool WorkStealingDeque<T>::pop(T& out)
+{
+    std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    Array* array = m_array.load(std::memory_order_relaxed);
+    m_bottom.store(bottom, std::memory_order_relaxed); //claims the bottom element before looking at top
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = m_top.load(std::memory_order_relaxed);
+
+    if(top > bottom){ //was empty
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    T val = array->get(bottom);
+    if(top == bottom){ //last element, a thief may be taking it as well
+        bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                 std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        if(!won){
+            return false;
+        }
+    }
+    out = val;
+    return true;
+}
+
+template<typename T>
+bool WorkStealingDeque<T>::steal(T& out)
+{
+    std::int64_t top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+    if(top >= bottom){ //empty
+        return false;
+    }
+    Array* array = m_array.load(std::memory_order_acquire);
+    T val = array->get(top);
+    if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)){
+        return false; //another thief or the owner took it
+    }
+    out = val;
+    return true;
+}
+
+template<typename T>
+std::size_t WorkStealingDeque<T>::approximateSize() const
+{
+    std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    std::int64_t top = m_top.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+}
+
+template<typename T>
+bool WorkStealingDeque<T>::empty() const
+{
+    return this->approximateSize() == 0;
+}
+
+template<typename T>
+std::size_t WorkStealingDeque<T>::capacity() const
+{
+    return static_cast<std::size_t>(m_array.load(std::memory_order_relaxed)->capacity());
+}
+
+#endif
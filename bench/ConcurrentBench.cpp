@@ -0,0 +1,380 @@
+/* ConcurrentBench:
+ *      Throughput and latency of the queues shared between threads
+ *      producers push timestamped items, consumers pop them and record the enqueue to dequeue latency
+ *      in a log-linear histogram (HDR style, ~3% resolution), reported as p50 / p99 / p99.9 / max
+ *      threads are pinned to cores round robin (Linux only), producers first
+ *      a std::mutex around a plain Queue is the baseline every other variant is compared to
+ *
+ *  standalone, no benchmark library needed:
+ *      g++ -std=c++17 -O2 -DNDEBUG -pthread -I.. ConcurrentBench.cpp -o ConcurrentBench
+ *      ./ConcurrentBench [producers = 1] [consumers = 1] [itemsPerProducer = 1000000] [filter]
+ *  filter only runs the backends whose name contains it
+ *  SpscQueue only runs with a single producer and a single consumer
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "Backoff.h"
+#include "BlockingQueue.h"
+#include "BoundedConcurrentQueue.h"
+#include "ConcurrentQueue.h"
+#include "Queue.h"
+#include "ShardedQueue.h"
+#include "SpscQueue.h"
+
+namespace {
+
+//capacity of the bounded queues
+constexpr std::size_t BOUNDED_CAPACITY = 1 << 16;
+
+typedef std::chrono::steady_clock Clock;
+
+//element passed through the queues
+struct Item {
+    std::int64_t sent; //Clock time of the push, in ns
+    std::uint64_t sequence; //position of the item in its producer's stream
+};
+
+std::int64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+/* Histogram:
+ *      Log-linear latency histogram, every power of 2 is split into SUB_BUCKETS linear buckets
+ *      values below SUB_BUCKETS are exact, bigger values are kept with a relative error below 1 / SUB_BUCKETS
+ */
+class Histogram {
+public:
+    static constexpr unsigned SUB_BITS = 6;
+    static constexpr std::uint64_t SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr std::uint64_t HALF_BUCKETS = SUB_BUCKETS / 2;
+
+    Histogram() :
+        m_counts((64 - SUB_BITS + 2) * HALF_BUCKETS, 0),
+        m_total(0),
+        m_max(0)
+    { }
+
+    void record(std::uint64_t value)
+    {
+        m_counts[indexOf(value)]++;
+        m_total++;
+        m_max = std::max(m_max, value);
+    }
+
+    void merge(const Histogram& other)
+    {
+        for(std::size_t i = 0; i < m_counts.size(); i++){
+            m_counts[i] += other.m_counts[i];
+        }
+        m_total += other.m_total;
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    //returns the value at least fraction of the recorded values don't exceed, rounded down to its bucket
+    std::uint64_t percentile(double fraction) const
+    {
+        if(m_total == 0){
+            return 0;
+        }
+        std::uint64_t rank = static_cast<std::uint64_t>(fraction * static_cast<double>(m_total - 1)) + 1;
+        std::uint64_t seen = 0;
+        for(std::size_t i = 0; i < m_counts.size(); i++){
+            seen += m_counts[i];
+            if(seen >= rank){
+                return valueOf(i);
+            }
+        }
+        return m_max;
+    }
+
+    std::uint64_t max() const
+    {
+        return m_max;
+    }
+
+private:
+    //bucket of value: shift drops all but the SUB_BITS highest bits, the mantissa left is in [HALF_BUCKETS, SUB_BUCKETS)
+    static std::size_t indexOf(std::uint64_t value)
+    {
+        if(value < SUB_BUCKETS){
+            return static_cast<std::size_t>(value);
+        }
+        unsigned shift = 63 - static_cast<unsigned>(__builtin_clzll(value)) - (SUB_BITS - 1);
+        return static_cast<std::size_t>(shift * HALF_BUCKETS + (value >> shift));
+    }
+
+    //smallest value of the bucket index
+    static std::uint64_t valueOf(std::size_t index)
+    {
+        if(index < SUB_BUCKETS){
+            return index;
+        }
+        std::uint64_t shift = (index - HALF_BUCKETS) / HALF_BUCKETS;
+        return (index - shift * HALF_BUCKETS) << shift;
+    }
+
+    std::vector<std::uint64_t> m_counts; //amount of values per bucket
+    std::uint64_t m_total; //amount of values recorded
+    std::uint64_t m_max; //biggest value recorded
+};
+
+//pins the calling thread to a core, does nothing where that isn't supported
+void pinThread(unsigned index)
+{
+#ifdef __linux__
+    unsigned cores = std::thread::hardware_concurrency();
+    if(cores == 0){
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(index % cores, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)index;
+#endif
+}
+
+/* Adapters:
+ *      give every queue the same push (waits for room) and tryPop (gives up after a short wait) interface
+ */
+struct MutexQueue {
+    std::mutex mutex;
+    Queue<Item> queue;
+
+    void push(const Item& item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.pushBack(item);
+    }
+
+    bool tryPop(Item& item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(queue.empty()){
+            return false;
+        }
+        item = queue.front();
+        queue.popFront();
+        return true;
+    }
+};
+
+struct LockFreeQueue {
+    ConcurrentQueue<Item> queue;
+
+    void push(const Item& item)
+    {
+        queue.tryPush(item);
+    }
+
+    bool tryPop(Item& item)
+    {
+        return queue.tryPop(item);
+    }
+};
+
+struct BoundedQueueAdapter {
+    BoundedConcurrentQueue<Item> queue;
+
+    BoundedQueueAdapter() :
+        queue(BOUNDED_CAPACITY)
+    { }
+
+    void push(const Item& item)
+    {
+        queue.push(item);
+    }
+
+    bool tryPop(Item& item)
+    {
+        return queue.tryPop(item);
+    }
+};
+
+struct SpscAdapter {
+    SpscQueue<Item> queue;
+
+    SpscAdapter() :
+        queue(BOUNDED_CAPACITY)
+    { }
+
+    void push(const Item& item)
+    {
+        queue.push(item);
+    }
+
+    bool tryPop(Item& item)
+    {
+        return queue.tryPop(item);
+    }
+};
+
+struct ShardedAdapter {
+    ShardedQueue<Item> queue;
+
+    void push(const Item& item)
+    {
+        queue.pushBack(item);
+    }
+
+    bool tryPop(Item& item)
+    {
+        std::optional<Item> popped = queue.tryPop();
+        if(!popped){
+            return false;
+        }
+        item = *popped;
+        return true;
+    }
+};
+
+struct BlockingAdapter {
+    BlockingQueue<Item> queue;
+
+    void push(const Item& item)
+    {
+        queue.pushBack(item);
+    }
+
+    bool tryPop(Item& item)
+    {
+        std::optional<Item> popped = queue.waitPopFor(std::chrono::milliseconds(1)); //sleeps instead of spinning
+        if(!popped){
+            return false;
+        }
+        item = *popped;
+        return true;
+    }
+};
+
+struct Options {
+    unsigned producers;
+    unsigned consumers;
+    std::size_t itemsPerProducer;
+    const char* filter;
+};
+
+/**
+ * @brief Runs producers and consumers over a single queue and prints throughput and latency percentiles
+ *
+ * @tparam Adapter - one of the adapters above
+ */
+template<typename Adapter>
+void run(const char* name, const Options& options)
+{
+    if(options.filter != nullptr && std::strstr(name, options.filter) == nullptr){
+        return;
+    }
+
+    Adapter adapter;
+    std::uint64_t total = static_cast<std::uint64_t>(options.producers) * options.itemsPerProducer;
+    std::atomic<std::uint64_t> consumed(0);
+    std::atomic<unsigned> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<Histogram> histograms(options.consumers);
+    std::vector<std::thread> threads;
+
+    for(unsigned p = 0; p < options.producers; p++){
+        threads.emplace_back([&, p](){
+            pinThread(p);
+            ready++;
+            while(!go.load(std::memory_order_acquire)){ }
+            for(std::size_t i = 0; i < options.itemsPerProducer; i++){
+                adapter.push(Item{now(), i});
+            }
+        });
+    }
+    for(unsigned c = 0; c < options.consumers; c++){
+        threads.emplace_back([&, c](){
+            pinThread(options.producers + c);
+            Histogram& histogram = histograms[c];
+            ready++;
+            while(!go.load(std::memory_order_acquire)){ }
+            Item item;
+            Backoff backoff;
+            while(consumed.load(std::memory_order_relaxed) < total){
+                if(adapter.tryPop(item)){
+                    histogram.record(static_cast<std::uint64_t>(now() - item.sent));
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                    backoff = Backoff();
+                }
+                else{
+                    backoff.pause();
+                }
+            }
+        });
+    }
+
+    while(ready.load() != options.producers + options.consumers){
+        std::this_thread::yield();
+    }
+    Clock::time_point start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for(std::thread& thread : threads){
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    Histogram merged;
+    for(const Histogram& histogram : histograms){
+        merged.merge(histogram);
+    }
+    std::printf("%-22s %3u %3u %10.2f %10llu %10llu %10llu %12llu\n", name, options.producers, options.consumers,
+                static_cast<double>(total) / seconds / 1e6,
+                static_cast<unsigned long long>(merged.percentile(0.5)),
+                static_cast<unsigned long long>(merged.percentile(0.99)),
+                static_cast<unsigned long long>(merged.percentile(0.999)),
+                static_cast<unsigned long long>(merged.max()));
+}
+
+} //namespace
+
+int main(int argc, char** argv)
+{
+    Options options = {1, 1, 1000000, nullptr};
+    if(argc > 1){
+        options.producers = static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10));
+    }
+    if(argc > 2){
+        options.consumers = static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10));
+    }
+    if(argc > 3){
+        options.itemsPerProducer = std::strtoull(argv[3], nullptr, 10);
+    }
+    if(argc > 4){
+        options.filter = argv[4];
+    }
+    if(options.producers == 0 || options.consumers == 0){
+        std::fprintf(stderr, "needs at least one producer and one consumer\n");
+        return 1;
+    }
+
+    std::printf("%-22s %3s %3s %10s %10s %10s %10s %12s\n", "backend", "P", "C", "Mitems/s",
+                "p50 ns", "p99 ns", "p99.9 ns", "max ns");
+    run<MutexQueue>("mutex+Queue", options);
+    if(options.producers == 1 && options.consumers == 1){
+        run<SpscAdapter>("SpscQueue", options);
+    }
+    run<LockFreeQueue>("ConcurrentQueue", options);
+    run<BoundedQueueAdapter>("BoundedConcurrentQueue", options);
+    run<ShardedAdapter>("ShardedQueue", options);
+    run<BlockingAdapter>("BlockingQueue", options);
+    return 0;
+}
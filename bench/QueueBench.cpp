@@ -0,0 +1,361 @@
+/* QueueBench:
+ *      Single threaded microbenchmarks of every queue backend
+ *      each operation is repeated until it ran for at least MIN_RUN_TIME and reported in ns per element
+ *      covered: pushBack/popFront throughput, steady push-pop churn, iteration through ConstIterator,
+ *      filter, transform (in place and copying), copy construction and copy assignment
+ *      for int, a 64 byte POD and std::string, with queue lengths from 10 up to maxLength
+ *      the backends that can't be iterated or copied (BoundedQueue, SpillQueue, MappedQueue, DelayQueue)
+ *      only run pushBack/tryPop throughput and churn, SpillQueue and MappedQueue only for the trivially copyable types
+ *      StaticQueue only runs the lengths below STATIC_CAPACITY
+ *
+ *  standalone, no benchmark library needed:
+ *      g++ -std=c++17 -O2 -DNDEBUG -I.. QueueBench.cpp -o QueueBench
+ *      ./QueueBench [maxLength = 10000000] [filter]
+ *  or through CMake, where the run_queue_bench target runs every length from 10 to 10000000
+ *  filter only runs the lines containing it, e.g. "RingQueue" or "string"
+ *  SpillQueue and MappedQueue write their files to the temporary directory
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "BoundedQueue.h"
+#include "ChunkedQueue.h"
+#include "DelayQueue.h"
+#include "MappedQueue.h"
+#include "PriorityQueue.h"
+#include "Queue.h"
+#include "RingQueue.h"
+#include "SmallQueue.h"
+#include "SpillQueue.h"
+#include "StaticQueue.h"
+
+namespace {
+
+//each measurement runs for at least this long
+constexpr std::chrono::milliseconds MIN_RUN_TIME(50);
+
+//amount of push-pop pairs of a churn measurement, independent of the queue length
+constexpr std::size_t CHURN_OPERATIONS = 1000000;
+
+//capacity of the measured StaticQueue, above the churned length so churn never finds it full
+constexpr std::size_t STATIC_CAPACITY = 1024;
+
+//64 byte trivially copyable element
+struct Pod64 {
+    std::uint64_t fields[8];
+
+    bool operator<(const Pod64& other) const
+    {
+        return fields[0] < other.fields[0];
+    }
+};
+
+//makes the compiler assume value is read, so the work producing it can't be optimized away
+template<typename T>
+void keep(const T& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+template<typename T>
+T makeValue(std::size_t i);
+
+template<>
+int makeValue<int>(std::size_t i)
+{
+    return static_cast<int>(i);
+}
+
+template<>
+Pod64 makeValue<Pod64>(std::size_t i)
+{
+    Pod64 pod;
+    for(std::uint64_t& field : pod.fields){
+        field = i;
+    }
+    return pod;
+}
+
+template<>
+std::string makeValue<std::string>(std::size_t i)
+{
+    return "benchmark value " + std::to_string(i); //longer than the small string buffer
+}
+
+//key used by filter, half of the elements pass
+std::size_t keyOf(int value)
+{
+    return static_cast<std::size_t>(value);
+}
+
+std::size_t keyOf(const Pod64& value)
+{
+    return value.fields[0];
+}
+
+std::size_t keyOf(const std::string& value)
+{
+    return value.size() + static_cast<unsigned char>(value.back());
+}
+
+//cheap in-place modification used by transform
+void touch(int& value) noexcept
+{
+    value++;
+}
+
+void touch(Pod64& value) noexcept
+{
+    value.fields[0]++;
+}
+
+void touch(std::string& value) noexcept
+{
+    value[0] = value[0] == 'b' ? 'B' : 'b';
+}
+
+//DelayQueue behind pushBack and tryPop: every element is due one tick after the previous one
+//and tryPop asks at the ready time of the last push, so every element is due and goes through the wheel
+template<typename T>
+class SteppedDelayQueue {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point m_last; //ready time of the last push
+    DelayQueue<T, Clock> m_queue; //measured queue, one tick per microsecond
+
+public:
+    SteppedDelayQueue() :
+        m_last(),
+        m_queue(std::chrono::microseconds(1), m_last)
+    { }
+
+    void pushBack(const T& val)
+    {
+        m_last += std::chrono::microseconds(1);
+        m_queue.pushBack(val, m_last);
+    }
+
+    std::optional<T> tryPop()
+    {
+        return m_queue.tryPop(m_last);
+    }
+};
+
+//path of a scratch file in the temporary directory
+std::string scratchPath(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+const char* g_filter = nullptr; //only lines containing it are run, nullptr runs everything
+
+/**
+ * @brief Runs body until MIN_RUN_TIME passed and prints the time per element
+ *
+ * @param backend - name of the queue
+ * @param type - name of the element type
+ * @param length - length of the queue
+ * @param operation - name of the measured operation
+ * @param elements - amount of elements a single run of body handles
+ * @param body - measured work
+ */
+template<typename Body>
+void measure(const char* backend, const char* type, std::size_t length, const char* operation,
+             std::size_t elements, Body body)
+{
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-14s %-8s %9zu %-18s", backend, type, length, operation);
+    if(g_filter != nullptr && std::strstr(line, g_filter) == nullptr){
+        return;
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    std::size_t runs = 0;
+    Clock::time_point start = Clock::now();
+    Clock::duration elapsed;
+    do{
+        body();
+        runs++;
+        elapsed = Clock::now() - start;
+    } while(elapsed < MIN_RUN_TIME);
+
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    std::printf("%s %10.2f ns/element\n", line, ns / static_cast<double>(runs * elements));
+}
+
+/**
+ * @brief Runs every benchmark for one backend, element type and length
+ *
+ * @tparam QueueType - queue to measure
+ * @tparam T - element type of QueueType
+ */
+template<typename QueueType, typename T>
+void runSuite(const char* backend, const char* type, std::size_t length)
+{
+    std::vector<T> values;
+    values.reserve(length);
+    for(std::size_t i = 0; i < length; i++){
+        values.push_back(makeValue<T>(i));
+    }
+
+    measure(backend, type, length, "pushBack+popFront", 2 * length, [&](){
+        QueueType queue;
+        for(const T& value : values){
+            queue.pushBack(value);
+        }
+        while(!queue.empty()){
+            keep(queue.front());
+            queue.popFront();
+        }
+    });
+
+    QueueType full;
+    for(const T& value : values){
+        full.pushBack(value);
+    }
+
+    measure(backend, type, length, "churn", CHURN_OPERATIONS, [&](){
+        for(std::size_t i = 0; i < CHURN_OPERATIONS; i++){ //the queue keeps its length
+            full.pushBack(values[i % length]);
+            full.popFront();
+        }
+    });
+
+    measure(backend, type, length, "iterate", length, [&](){
+        const QueueType& constFull = full;
+        std::size_t sum = 0;
+        for(typename QueueType::ConstIterator iter = constFull.begin(); iter != constFull.end(); ++iter){
+            sum += keyOf(*iter);
+        }
+        keep(sum);
+    });
+
+    measure(backend, type, length, "filter", length, [&](){
+        QueueType filtered = filter(full, [](const T& value){ return keyOf(value) % 2 == 0; });
+        keep(filtered);
+    });
+
+    measure(backend, type, length, "transform", length, [&](){
+        transform(full, [](T& value) noexcept { touch(value); });
+    });
+
+    measure(backend, type, length, "transform(copy)", length, [&](){
+        transform(full, [](T& value){ touch(value); }); //may throw as far as transform knows
+    });
+
+    measure(backend, type, length, "copy c'tor", length, [&](){
+        QueueType copy(full);
+        keep(copy);
+    });
+
+    QueueType target(full);
+    measure(backend, type, length, "operator=", length, [&](){
+        target = full;
+        keep(target);
+    });
+}
+
+/**
+ * @brief Runs the push and pop benchmarks for one backend that can't be iterated or copied
+ *
+ * @tparam QueueType - queue to measure, with pushBack(const T&) and tryPop()
+ * @tparam T - element type of QueueType
+ * @param make - returns a std::unique_ptr to a new empty queue with room for length + 1 elements
+ */
+template<typename QueueType, typename T, typename Make>
+void runPushPopSuite(const char* backend, const char* type, std::size_t length, Make make)
+{
+    std::vector<T> values;
+    values.reserve(length);
+    for(std::size_t i = 0; i < length; i++){
+        values.push_back(makeValue<T>(i));
+    }
+
+    measure(backend, type, length, "pushBack+tryPop", 2 * length, [&](){
+        std::unique_ptr<QueueType> queue = make();
+        for(const T& value : values){
+            queue->pushBack(value);
+        }
+        while(std::optional<T> value = queue->tryPop()){
+            keep(*value);
+        }
+    });
+
+    std::unique_ptr<QueueType> full = make();
+    for(const T& value : values){
+        full->pushBack(value);
+    }
+
+    measure(backend, type, length, "churn", CHURN_OPERATIONS, [&](){
+        for(std::size_t i = 0; i < CHURN_OPERATIONS; i++){ //the queue keeps its length
+            full->pushBack(values[i % length]);
+            keep(full->tryPop());
+        }
+    });
+}
+
+template<typename T>
+void runBackends(const char* type, std::size_t length)
+{
+    runSuite<Queue<T>, T>("Queue", type, length);
+    runSuite<PooledQueue<T>, T>("PooledQueue", type, length);
+    runSuite<RingQueue<T>, T>("RingQueue", type, length);
+    runSuite<ChunkedQueue<T>, T>("ChunkedQueue", type, length);
+    runSuite<SmallQueue<T>, T>("SmallQueue", type, length);
+    runSuite<PriorityQueue<T>, T>("PriorityQueue", type, length);
+    if(length < STATIC_CAPACITY){
+        runSuite<StaticQueue<T, STATIC_CAPACITY>, T>("StaticQueue", type, length);
+    }
+
+    runPushPopSuite<BoundedQueue<T>, T>("BoundedQueue", type, length, [&](){
+        return std::make_unique<BoundedQueue<T>>(length + 1);
+    });
+    runPushPopSuite<SteppedDelayQueue<T>, T>("DelayQueue", type, length, [](){
+        return std::make_unique<SteppedDelayQueue<T>>();
+    });
+    if constexpr(std::is_trivially_copyable<T>::value){
+        std::string spill = scratchPath("QueueBench-spill-");
+        runPushPopSuite<SpillQueue<T>, T>("SpillQueue", type, length, [&](){
+            return std::make_unique<SpillQueue<T>>(spill);
+        });
+
+        std::string mapped = scratchPath("QueueBench-mapped");
+        runPushPopSuite<MappedQueue<T>, T>("MappedQueue", type, length, [&](){
+            std::remove(mapped.c_str()); //a file left behind would keep its elements and capacity
+            return std::make_unique<MappedQueue<T>>(mapped, length + 1);
+        });
+        std::remove(mapped.c_str());
+    }
+}
+
+} //namespace
+
+int main(int argc, char** argv)
+{
+    std::size_t maxLength = 10000000;
+    if(argc > 1){
+        maxLength = std::strtoull(argv[1], nullptr, 10);
+    }
+    if(argc > 2){
+        g_filter = argv[2];
+    }
+
+    std::printf("%-14s %-8s %9s %-18s %10s\n", "backend", "type", "length", "operation", "time");
+    for(std::size_t length = 10; length <= maxLength; length *= 100){ //10, 1000, 100000, 10000000
+        runBackends<int>("int", length);
+        runBackends<Pod64>("pod64", length);
+        runBackends<std::string>("string", length);
+    }
+    return 0;
+}
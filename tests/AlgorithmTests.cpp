@@ -0,0 +1,103 @@
+/* AlgorithmTests:
+ *      filter, transformInPlace and transform of every iterable backend, against the std::deque model
+ *      a noexcept transform has to run in place, without a single allocation
+ *      a filtered copy allocates through the allocator its queue's copy would get
+ */
+
+#include <deque>
+#include "ChunkedQueue.h"
+#include "PoolAllocator.h"
+#include "Queue.h"
+#include "QueueAlgorithms.h"
+#include "QueueModel.h"
+#include "RingQueue.h"
+#include "SmallQueue.h"
+#include "StaticQueue.h"
+#include "TestElements.h"
+#include "TestHarness.h"
+
+namespace {
+
+//filters and transforms 100 elements of queue and of the model
+template<typename QueueType>
+void matchAlgorithms(QueueType queue)
+{
+    std::deque<int> model;
+    for(int i = 0; i < 100; i++){
+        queue.pushBack(i);
+        model.push_back(i);
+    }
+
+    QueueType even = filter(queue, [](int value){ return value % 2 == 0; });
+    std::deque<int> evenModel;
+    for(int value : model){
+        if(value % 2 == 0){
+            evenModel.push_back(value);
+        }
+    }
+    CHECK(sameElements(even, evenModel));
+    CHECK(sameElements(queue, model));
+
+    transformInPlace(queue, [](int& value){ value *= 3; });
+    transform(queue, [](int& value){ value += 1; }); //not noexcept, goes through a copy
+    transform(queue, [](int& value) noexcept { value -= 2; });
+    for(int& value : model){
+        value = value * 3 - 1;
+    }
+    CHECK(sameElements(queue, model));
+}
+
+//a noexcept transform and transformInPlace of a filled queue allocate nothing
+template<typename QueueType>
+void transformWithoutAllocating(QueueType queue)
+{
+    for(int i = 0; i < 100; i++){
+        queue.pushBack(i);
+    }
+    std::size_t allocations = allocationCount;
+    transform(queue, [](int& value) noexcept { value *= 2; });
+    transformInPlace(queue, [](int& value){ value += 1; });
+    CHECK(allocationCount == allocations);
+    int expected = 1;
+    bool matches = true;
+    for(int value : queue){
+        matches = matches && value == expected;
+        expected += 2;
+    }
+    CHECK(matches && expected == 201);
+}
+
+} //namespace
+
+TEST(AlgorithmsMatchDeque)
+{
+    matchAlgorithms(Queue<int>());
+    matchAlgorithms(PooledQueue<int>());
+    matchAlgorithms(RingQueue<int>());
+    matchAlgorithms(ChunkedQueue<int, 16>());
+    matchAlgorithms(SmallQueue<int, 8>());
+    matchAlgorithms(StaticQueue<int, 128>());
+}
+
+TEST(FilterKeepsTheAllocator)
+{
+    PooledQueue<int> queue;
+    for(int i = 0; i < 10; i++){
+        queue.pushBack(i);
+    }
+    PooledQueue<int> small = filter(queue, [](int value){ return value < 3; });
+    small.pushBack(42); //allocates through the select_on_container_copy_construction copy
+    CHECK(small.size() == 4 && small.front() == 0);
+}
+
+TEST(NoexceptTransformDoesNotAllocate)
+{
+    transformWithoutAllocating(Queue<int, CountingAllocator<int>>());
+    transformWithoutAllocating(RingQueue<int, CountingAllocator<int>>());
+    transformWithoutAllocating(ChunkedQueue<int, 16, CountingAllocator<int>>());
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
@@ -0,0 +1,57 @@
+/* BlockingDelayQueueTests:
+ *      consumers sleeping on a BlockingDelayQueue, built with ThreadSanitizer when the compiler has it
+ *      a push that moves the earliest due time forward has to wake a consumer that can take the new element,
+ *      not just one that times out anyway
+ */
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "BlockingDelayQueue.h"
+#include "TestHarness.h"
+
+TEST(BlockingDelayQueueWakesWaiterForEarlierElement)
+{
+    typedef BlockingDelayQueue<int> DelayQueueType;
+    DelayQueueType queue;
+    queue.pushAfter(1, std::chrono::seconds(30)); //every consumer goes to sleep until this one
+
+    //the impatient consumers wait first, so a single notification goes to one of them
+    std::atomic<int> timedOut(0);
+    std::vector<std::thread> impatient;
+    for(int i = 0; i < 3; i++){
+        impatient.emplace_back([&](){ //time out after the push below, before its element is due
+            if(!queue.waitPopFor(std::chrono::milliseconds(300))){
+                timedOut++;
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::atomic<int> received(0);
+    std::thread patient([&](){
+        std::optional<int> item = queue.waitPop();
+        received.store(item ? *item : -1);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    queue.pushAfter(2, std::chrono::milliseconds(200));
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(received.load() == 0 && std::chrono::steady_clock::now() < deadline){
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    CHECK(received.load() == 2);
+    queue.close(); //releases the patient consumer if it never woke up
+    for(std::thread& consumer : impatient){
+        consumer.join();
+    }
+    patient.join();
+    CHECK(timedOut.load() == 3);
+    CHECK(queue.size() == 1);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
@@ -0,0 +1,115 @@
+/* BlockingQueueTests:
+ *      the mutex and condition variable BlockingQueue, built with ThreadSanitizer when the compiler has it
+ *      sleeping consumers have to wake for every element and for close(), and drain the queue before they stop
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "BlockingQueue.h"
+#include "PoolAllocator.h"
+#include "StressTest.h"
+#include "TestHarness.h"
+
+TEST(BlockingQueueWaitPopForTimesOut)
+{
+    BlockingQueue<int> queue;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    CHECK(!queue.waitPopFor(std::chrono::milliseconds(20)).has_value());
+    CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+    queue.close();
+    CHECK(!queue.waitPop().has_value());
+    CHECK_THROWS(queue.pushBack(1), BlockingQueue<int>::ClosedQueue);
+}
+
+TEST(BlockingQueueDrainsBeforeClosing)
+{
+    BlockingQueue<int> queue;
+    queue.pushBack(1);
+    queue.emplaceBack(2);
+    queue.close();
+    CHECK(queue.closed() && queue.size() == 2);
+    CHECK(queue.waitPop() == std::optional<int>(1)); //elements pushed before close() are still handed out
+    CHECK(queue.waitPopFor(std::chrono::seconds(5)) == std::optional<int>(2));
+    CHECK(!queue.tryPop().has_value() && !queue.waitPop().has_value());
+}
+
+TEST(BlockingQueueWakesEverySleeper)
+{
+    BlockingQueue<int> queue;
+    constexpr int SLEEPERS = 4;
+    std::vector<std::optional<int>> popped(SLEEPERS);
+    std::vector<std::thread> sleepers;
+    for(int i = 0; i < SLEEPERS; i++){
+        sleepers.emplace_back([&queue, &popped, i](){ popped[i] = queue.waitPop(); });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); //lets them go to sleep first
+    std::vector<int> burst = {10, 11, 12};
+    queue.pushBack(burst.begin(), burst.end()); //one wakeup per element
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(!queue.empty() && std::chrono::steady_clock::now() < deadline){
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    CHECK(queue.empty());
+    queue.close(); //the last sleeper gets an empty optional
+    for(std::thread& sleeper : sleepers){
+        sleeper.join();
+    }
+    int sum = 0;
+    int empty = 0;
+    for(const std::optional<int>& item : popped){
+        sum += item ? *item : 0;
+        empty += item ? 0 : 1;
+    }
+    CHECK(sum == 33 && empty == 1);
+}
+
+TEST(BlockingQueueBulkPushWithPoolAllocator)
+{
+    //the batch of a bulk push is built outside the lock, it must not share the pool of the queue
+    BlockingQueue<std::uint64_t, PoolAllocator<std::uint64_t>> queue;
+    constexpr std::size_t BATCH = 16;
+    std::vector<std::thread> producers;
+    for(std::size_t producer = 0; producer < PRODUCERS; producer++){
+        producers.emplace_back([producer, &queue](){
+            std::vector<std::uint64_t> batch;
+            for(std::size_t sequence = 0; sequence < ITEMS; sequence++){
+                batch.push_back(makeItem(producer, sequence));
+                if(batch.size() == BATCH || sequence + 1 == ITEMS){
+                    queue.pushBack(batch.begin(), batch.end());
+                    batch.clear();
+                }
+            }
+        });
+    }
+    Tally tally(PRODUCERS);
+    std::vector<std::thread> consumers;
+    for(std::size_t consumer = 0; consumer < CONSUMERS; consumer++){
+        consumers.emplace_back([&queue, &tally](){
+            std::vector<std::int64_t> last(PRODUCERS, -1);
+            while(std::optional<std::uint64_t> item = queue.waitPop()){ //empty once closed and drained
+                tally.record(*item, last);
+            }
+        });
+    }
+    for(std::thread& producer : producers){
+        producer.join();
+    }
+    while(tally.popped.load() < PRODUCERS * ITEMS){
+        std::this_thread::yield();
+    }
+    queue.close(); //wakes the consumers still waiting
+    for(std::thread& consumer : consumers){
+        consumer.join();
+    }
+    CHECK(tally.exactlyOnce());
+    CHECK(tally.outOfOrder.load() == 0);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
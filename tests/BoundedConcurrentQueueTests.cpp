@@ -0,0 +1,43 @@
+/* BoundedConcurrentQueueTests:
+ *      the bounded MPMC BoundedConcurrentQueue, built with ThreadSanitizer when the compiler has it
+ *      a small ring, so producers keep running into a full queue and consumers into an empty one
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include "BoundedConcurrentQueue.h"
+#include "StressTest.h"
+#include "TestHarness.h"
+
+TEST(BoundedConcurrentQueueRejectsPushesWhenFull)
+{
+    BoundedConcurrentQueue<int> queue(4);
+    int pushed = 0;
+    while(queue.tryPush(pushed)){
+        pushed++;
+    }
+    CHECK(pushed >= 4 && queue.approximateSize() == static_cast<std::size_t>(pushed));
+    int out;
+    for(int i = 0; i < pushed; i++){
+        CHECK(queue.tryPop(out) && out == i);
+    }
+    CHECK(!queue.tryPop(out));
+}
+
+TEST(BoundedConcurrentQueueDeliversEveryItemOnce)
+{
+    BoundedConcurrentQueue<std::uint64_t> queue(64);
+    stress([&queue](std::size_t, std::uint64_t item){
+               while(!queue.tryPush(item)){
+                   std::this_thread::yield();
+               }
+           },
+           [&queue](std::uint64_t& item){ return queue.tryPop(item); }, true);
+    CHECK(queue.approximateSize() == 0);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
@@ -0,0 +1,92 @@
+/* BoundedQueueTests:
+ *      the fixed capacity BoundedQueue, against the std::deque model and under throwing copies
+ *      a full queue rejects pushes, and no push ever allocates, also after a move across unequal allocators
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "BoundedQueue.h"
+#include "QueueModel.h"
+#include "TestElements.h"
+#include "TestHarness.h"
+
+TEST(BoundedQueueMatchesDeque)
+{
+    matchDeque<BoundedQueue<int>, int>(BoundedQueue<int>(64), 64);
+    matchDeque<BoundedQueue<std::string>, std::string>(BoundedQueue<std::string>(48), 48);
+}
+
+TEST(BoundedQueueRejectsPushesWhenFull)
+{
+    BoundedQueue<int> queue(3);
+    for(int i = 0; i < 3; i++){
+        CHECK(queue.tryPush(i));
+    }
+    CHECK(queue.full() && queue.capacity() == 3);
+    CHECK(!queue.tryPush(3) && !queue.tryEmplace(3));
+    CHECK_THROWS(queue.pushBack(3), BoundedQueue<int>::FullQueue);
+    CHECK_THROWS(queue.emplaceBack(3), BoundedQueue<int>::FullQueue);
+    CHECK(queue.size() == 3 && queue.front() == 0);
+    queue.popFront();
+    CHECK(!queue.full() && queue.tryPush(3));
+}
+
+TEST(BoundedQueueMoveLeavesSourceEmpty)
+{
+    int baseline = Thrower::live;
+    {
+        BoundedQueue<Thrower> source(8);
+        BoundedQueue<Thrower> target(4);
+        for(int i = 0; i < 5; i++){
+            source.pushBack(Thrower(i));
+        }
+        for(int i = 0; i < 3; i++){
+            target.pushBack(Thrower(50 + i));
+        }
+
+        target = std::move(source);
+        CHECK(Thrower::live == baseline + 5); //target's old elements are gone already
+        CHECK(source.empty() && source.size() == 0 && source.capacity() == 0);
+        CHECK(!source.tryPush(Thrower(10)) && source.full()); //bounded at 0, not by the buffer it got
+        CHECK_THROWS(source.pushBack(Thrower(10)), BoundedQueue<Thrower>::FullQueue);
+        CHECK(target.capacity() == 8 && valuesOf(target) == std::vector<int>({0, 1, 2, 3, 4}));
+
+        BoundedQueue<Thrower> moved(std::move(target));
+        CHECK(target.empty() && target.capacity() == 0 && !target.tryPush(Thrower(20)));
+        CHECK(moved.capacity() == 8 && valuesOf(moved) == std::vector<int>({0, 1, 2, 3, 4}));
+
+        source = BoundedQueue<Thrower>(2); //a moved-from queue takes a new capacity by assignment
+        CHECK(source.tryPush(Thrower(30)) && source.tryPush(Thrower(31)) && !source.tryPush(Thrower(32)));
+    }
+    CHECK(Thrower::live == baseline);
+}
+
+TEST(BoundedQueueMovesAcrossAllocatorsWithoutLosingItsBuffer)
+{
+    BoundedQueue<int, CountingAllocator<int>> source(64, CountingAllocator<int>(1));
+    BoundedQueue<int, CountingAllocator<int>> target(2, CountingAllocator<int>(2));
+    for(int i = 0; i < 3; i++){
+        source.pushBack(i);
+    }
+    target = std::move(source); //unequal and not propagated, the elements are moved one by one
+    CHECK(target.capacity() == 64 && target.size() == 3);
+    CHECK(source.empty() && source.capacity() == 0 && !source.tryPush(3));
+
+    std::size_t allocations = allocationCount;
+    for(int i = 3; i < 64; i++){
+        CHECK(target.tryPush(i));
+    }
+    CHECK(allocationCount == allocations && target.full()); //the whole capacity was reserved by the move
+    CHECK(!target.tryPush(64) && target.front() == 0);
+}
+
+TEST(BoundedQueueSurvivesThrowingCopies)
+{
+    failEveryCopy<BoundedQueue<Thrower>>([](){ return BoundedQueue<Thrower>(32); }, true);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
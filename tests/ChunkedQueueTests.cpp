@@ -0,0 +1,43 @@
+/* ChunkedQueueTests:
+ *      the unrolled linked list ChunkedQueue, against the std::deque model and under throwing copies
+ *      small chunks, so every run crosses many chunk boundaries
+ */
+
+#include <string>
+#include "ChunkedQueue.h"
+#include "QueueModel.h"
+#include "TestElements.h"
+#include "TestHarness.h"
+
+TEST(ChunkedQueueMatchesDeque)
+{
+    matchDeque<ChunkedQueue<int, 8>, int>(ChunkedQueue<int, 8>(), UNBOUNDED);
+    matchDeque<ChunkedQueue<int, 1>, int>(ChunkedQueue<int, 1>(), UNBOUNDED);
+    matchDeque<ChunkedQueue<std::string, 8>, std::string>(ChunkedQueue<std::string, 8>(), UNBOUNDED);
+}
+
+TEST(ChunkedQueueKeepsReferencesStable)
+{
+    ChunkedQueue<int, 4> queue;
+    queue.pushBack(0);
+    const int* first = &queue.front();
+    for(int i = 1; i < 100; i++){ //elements are never moved
+        queue.pushBack(i);
+    }
+    CHECK(first == &queue.front() && *first == 0);
+}
+
+TEST(ChunkedQueueMoveLeavesSourceEmpty)
+{
+    moveLeavesSourceEmpty<ChunkedQueue<Thrower, 4>>([](){ return ChunkedQueue<Thrower, 4>(); });
+}
+
+TEST(ChunkedQueueSurvivesThrowingCopies)
+{
+    failEveryCopy<ChunkedQueue<Thrower, 4>>([](){ return ChunkedQueue<Thrower, 4>(); }, true);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
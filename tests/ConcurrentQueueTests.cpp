@@ -0,0 +1,118 @@
+/* ConcurrentQueueTests:
+ *      the lock-free MPMC ConcurrentQueue, built with ThreadSanitizer when the compiler has it
+ *      several producers and consumers share one queue, every item has to arrive exactly once and in producer order
+ *      elements owning memory check that HazardPointers frees every popped node exactly once,
+ *      also when the threads that retired nodes exit while other threads may still protect them
+ *      AtomicQueueStats counts every push and pop made by the threads
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConcurrentQueue.h"
+#include "StressTest.h"
+#include "TestHarness.h"
+
+namespace {
+
+//element counting its live instances, so a node freed twice or never shows up in the count
+struct Counted {
+    static inline std::atomic<long> live{0}; //instances alive
+    std::string text; //owns heap memory, a use after free is caught by the sanitizer
+
+    Counted() :
+        text("counted element with a heap allocated payload")
+    {
+        live++;
+    }
+
+    explicit Counted(std::size_t id) :
+        text("counted element number " + std::to_string(id) + " with a heap allocated payload")
+    {
+        live++;
+    }
+
+    Counted(const Counted& other) :
+        text(other.text)
+    {
+        live++;
+    }
+
+    Counted& operator=(const Counted&) = default;
+
+    ~Counted()
+    {
+        live--;
+    }
+};
+
+} //namespace
+
+TEST(ConcurrentQueueDeliversEveryItemOnce)
+{
+    ConcurrentQueue<std::uint64_t> queue;
+    stress([&queue](std::size_t, std::uint64_t item){ queue.tryPush(item); },
+           [&queue](std::uint64_t& item){ return queue.tryPop(item); }, true);
+    std::uint64_t item;
+    CHECK(!queue.tryPop(item));
+    CHECK(queue.approximateSize() == 0);
+}
+
+TEST(ConcurrentQueueCountsWithAtomicStats)
+{
+    ConcurrentQueue<std::uint64_t, AtomicQueueStats> queue;
+    stress([&queue](std::size_t, std::uint64_t item){ queue.tryPush(item); },
+           [&queue](std::uint64_t& item){ return queue.tryPop(item); }, true);
+    QueueStatsSnapshot stats = queue.stats();
+    CHECK(stats.pushes == PRODUCERS * ITEMS && stats.pops == PRODUCERS * ITEMS);
+    CHECK(stats.highWater <= PRODUCERS * ITEMS);
+}
+
+TEST(ConcurrentQueueReclaimsEveryNode)
+{
+    constexpr std::size_t ROUNDS = 20;
+    constexpr std::size_t PER_THREAD = 500;
+    {
+        ConcurrentQueue<Counted> queue;
+        std::atomic<std::size_t> popped(0);
+        for(std::size_t round = 0; round < ROUNDS; round++){ //short lived threads hand their retired nodes over
+            std::vector<std::thread> threads;
+            for(std::size_t i = 0; i < 2; i++){
+                threads.emplace_back([&queue, i](){
+                    for(std::size_t id = 0; id < PER_THREAD; id++){
+                        queue.tryEmplace(i * PER_THREAD + id);
+                    }
+                });
+                threads.emplace_back([&queue, &popped](){
+                    Counted out;
+                    for(std::size_t tries = 0; tries < 2 * PER_THREAD; tries++){
+                        if(queue.tryPop(out)){
+                            popped++;
+                        }
+                    }
+                });
+            }
+            for(std::thread& thread : threads){
+                thread.join();
+            }
+        }
+        std::size_t left = 0;
+        Counted out;
+        while(queue.tryPop(out)){
+            left++;
+        }
+        CHECK(popped.load() + left == ROUNDS * 2 * PER_THREAD);
+        for(std::size_t id = 0; id < 100; id++){ //left to the d'tor
+            queue.tryEmplace(id);
+        }
+    }
+    CHECK(Counted::live.load() == 0);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
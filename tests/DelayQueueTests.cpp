@@ -0,0 +1,231 @@
+/* DelayQueueTests:
+ *      the timing wheel of DelayQueue, with explicit times so nothing depends on the machine's speed
+ *      a seeded random mix of pushes at delays reaching every level and of jumps in time runs against a model,
+ *      every pop must be due, everything due must come out, in the order of the due ticks
+ *      the fixed cases cover rounding to a tick, FIFO order within a tick, cascades across levels,
+ *      elements parked beyond SLOTS^LEVELS ticks and nextWakeup
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include "DelayQueue.h"
+#include "TestHarness.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+typedef DelayQueue<std::size_t, Clock> TimedQueue;
+
+//time of tick 0 of every queue of the tests
+const Clock::time_point START = Clock::time_point() + std::chrono::hours(1);
+
+//ticks covered by the four levels of the wheel
+constexpr std::uint64_t WHEEL_TICKS = std::uint64_t(1) << 32;
+
+//time of a tick at the default resolution of 1ms, plus micros
+Clock::time_point at(std::uint64_t tick, std::int64_t micros = 0)
+{
+    return START + std::chrono::milliseconds(tick) + std::chrono::microseconds(micros);
+}
+
+//a random delay in microseconds, mostly short, sometimes several levels or the whole wheel away
+std::uint64_t randomDelay(std::mt19937_64& random)
+{
+    switch(random() % 8){
+    case 0:
+        return 0;
+    case 1:
+    case 2:
+        return random() % 3000; //within a few ticks
+    case 3:
+    case 4:
+        return random() % 300000; //level 1
+    case 5:
+        return random() % 70000000; //level 2
+    case 6:
+        return random() % 20000000000; //level 3
+    default:
+        return random() % (5 * WHEEL_TICKS * 1000); //parked beyond the wheel
+    }
+}
+
+} //namespace
+
+TEST(DelayQueueMatchesModel)
+{
+    std::mt19937_64 random(7);
+    TimedQueue queue(std::chrono::milliseconds(1), START);
+    std::multimap<std::uint64_t, std::size_t> pending; //model, due tick to element
+    std::uint64_t now = 0; //microseconds since START
+    std::size_t next = 0;
+
+    for(std::size_t step = 0; step < 4000; step++){
+        for(std::uint64_t pushes = random() % 6; pushes > 0; pushes--){
+            std::uint64_t readyAt = now + randomDelay(random);
+            queue.pushBack(next, START + std::chrono::microseconds(readyAt));
+            pending.emplace((readyAt + 999) / 1000, next++);
+        }
+
+        //sometimes straight to the next element, so the far ones come out as well
+        if(random() % 4 == 0 && !pending.empty()){
+            now = pending.begin()->first * 1000 + random() % 1000;
+        }
+        else{
+            now += randomDelay(random) / (random() % 2 == 0 ? 1 : 100);
+        }
+
+        std::optional<Clock::time_point> wakeup = queue.nextWakeup();
+        CHECK(wakeup.has_value() == !pending.empty());
+        if(wakeup && !pending.empty()){
+            CHECK(*wakeup <= at(pending.begin()->first));
+        }
+
+        std::uint64_t tick = now / 1000;
+        std::uint64_t lastTick = 0;
+        while(std::optional<std::size_t> popped = queue.tryPop(START + std::chrono::microseconds(now))){
+            auto found = pending.end();
+            for(auto it = pending.begin(); it != pending.end() && it->first <= tick; ++it){
+                if(it->second == *popped){
+                    found = it;
+                    break;
+                }
+            }
+            CHECK(found != pending.end()); //popped elements were pushed and are due
+            if(found == pending.end()){
+                return;
+            }
+            CHECK(found->first >= lastTick);
+            lastTick = found->first;
+            pending.erase(found);
+        }
+        CHECK(pending.empty() || pending.begin()->first > tick); //everything due came out
+        CHECK(queue.size() == pending.size());
+        CHECK(queue.empty() == pending.empty());
+    }
+}
+
+TEST(DelayQueueNeverHandsOutEarly)
+{
+    TimedQueue queue(std::chrono::milliseconds(1), START);
+    queue.pushBack(1, at(1, 500)); //rounded up to tick 2
+    queue.pushBack(2, at(2));
+    queue.pushBack(3, START - std::chrono::seconds(1)); //before tick 0, due at once
+    CHECK(queue.tryPop(START) == std::optional<std::size_t>(3));
+    CHECK(!queue.tryPop(at(1, 999)));
+    CHECK(queue.tryPop(at(2)) == std::optional<std::size_t>(1));
+    CHECK(queue.tryPop(at(0)) == std::optional<std::size_t>(2)); //time never goes back
+    CHECK(!queue.tryPop(at(100)));
+    CHECK(queue.empty() && !queue.nextWakeup());
+}
+
+TEST(DelayQueueKeepsFifoWithinATick)
+{
+    TimedQueue queue(std::chrono::milliseconds(1), START);
+    for(std::size_t i = 0; i < 100; i++){
+        queue.pushBack(i, at(70000, static_cast<std::int64_t>(i % 10 + 1) * 10)); //all round up to tick 70001
+    }
+    queue.pushBack(100, at(300)); //due earlier although pushed later
+    CHECK(!queue.tryPop(at(299)));
+    CHECK(queue.tryPop(at(300)) == std::optional<std::size_t>(100));
+    CHECK(!queue.tryPop(at(70000)));
+    for(std::size_t i = 0; i < 100; i++){
+        CHECK(queue.tryPop(at(70001)) == std::optional<std::size_t>(i));
+    }
+    CHECK(queue.empty());
+}
+
+TEST(DelayQueueCascadesAcrossLevels)
+{
+    const std::uint64_t ticks[] = {1, 255, 256, 257, 511, 65535, 65536, 65537, 16777215, 16777216,
+                                   16777217, WHEEL_TICKS - 1};
+    TimedQueue queue(std::chrono::milliseconds(1), START);
+    for(std::size_t i = 0; i < sizeof(ticks) / sizeof(ticks[0]); i++){
+        queue.pushBack(i, at(ticks[i]));
+    }
+    for(std::size_t i = 0; i < sizeof(ticks) / sizeof(ticks[0]); i++){
+        CHECK(!queue.tryPop(at(ticks[i] - 1)));
+        CHECK(queue.tryPop(at(ticks[i])) == std::optional<std::size_t>(i));
+    }
+    CHECK(queue.empty());
+
+    //the same ticks reached by many small steps instead of jumps
+    TimedQueue stepped(std::chrono::milliseconds(1), START);
+    for(std::size_t i = 0; i < 8; i++){
+        stepped.pushBack(i, at(ticks[i]));
+    }
+    std::size_t expected = 0;
+    for(std::uint64_t tick = 0; tick <= 70000; tick++){
+        while(std::optional<std::size_t> popped = stepped.tryPop(at(tick))){
+            CHECK(*popped == expected && ticks[expected] == tick);
+            expected++;
+        }
+    }
+    CHECK(expected == 8 && stepped.empty());
+}
+
+TEST(DelayQueueParksBeyondTheWheel)
+{
+    TimedQueue queue(std::chrono::milliseconds(1), START);
+    queue.pushBack(0, at(3 * WHEEL_TICKS + 5));
+    queue.pushBack(1, at(WHEEL_TICKS + 1));
+    queue.pushBack(2, at(10));
+    CHECK(queue.size() == 3);
+
+    CHECK(queue.tryPop(at(10)) == std::optional<std::size_t>(2));
+    CHECK(!queue.tryPop(at(WHEEL_TICKS)));
+    CHECK(queue.tryPop(at(WHEEL_TICKS + 1)) == std::optional<std::size_t>(1));
+    CHECK(!queue.tryPop(at(2 * WHEEL_TICKS)));
+    CHECK(!queue.tryPop(at(3 * WHEEL_TICKS + 4)));
+    CHECK(queue.size() == 1);
+    CHECK(queue.tryPop(at(3 * WHEEL_TICKS + 5)) == std::optional<std::size_t>(0));
+    CHECK(queue.empty());
+}
+
+TEST(DelayQueueWakeupLeadsToTheElement)
+{
+    const std::uint64_t ticks[] = {3, 700, 200000, 90000000, 2 * WHEEL_TICKS};
+    for(std::uint64_t tick : ticks){
+        TimedQueue queue(std::chrono::milliseconds(1), START);
+        queue.pushBack(0, at(tick));
+        std::size_t wakeups = 0;
+        std::optional<std::size_t> popped;
+        while(!popped && wakeups < 64){ //following nextWakeup must get there in a few steps
+            std::optional<Clock::time_point> wakeup = queue.nextWakeup();
+            CHECK(wakeup && *wakeup <= at(tick));
+            if(!wakeup){
+                break;
+            }
+            popped = queue.tryPop(*wakeup);
+            wakeups++;
+        }
+        CHECK(popped == std::optional<std::size_t>(0));
+        CHECK(wakeups <= 8);
+    }
+
+    TimedQueue queue(std::chrono::milliseconds(1), START);
+    queue.pushBack(0, at(5));
+    CHECK(queue.tryPop(at(5)) == std::optional<std::size_t>(0));
+    queue.pushBack(1, at(5));
+    CHECK(queue.nextWakeup() && *queue.nextWakeup() <= at(5)); //already due, the wakeup is in the past
+}
+
+TEST(DelayQueueDestroysPendingElements)
+{
+    DelayQueue<std::string, Clock> queue(std::chrono::milliseconds(1), START);
+    for(std::uint64_t i = 0; i < 1000; i++){
+        queue.emplaceBack(at(i * i * 977), "pending element " + std::to_string(i) + " left in the wheel");
+    }
+    CHECK(queue.tryPop(at(0)) == std::optional<std::string>("pending element 0 left in the wheel"));
+    CHECK(queue.size() == 999); //the rest is freed by the d'tor, which the sanitizers check
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
@@ -0,0 +1,386 @@
+/* FastPathTests:
+ *      the memcpy paths of the contiguous backends against their element by element paths
+ *      the same copies, assignments and pointer range pushes run with std::allocator (memcpy),
+ *      with an allocator without construct (memcpy as well) and with one that constructs (one by one),
+ *      starting from every head position, so runs wrap around the end of the buffer and split across chunks
+ *      the constructing allocator counts its calls, so the slow path is known to be taken and the fast one isn't
+ *      a Queue assigned over its own nodes rolls back when an allocation fails and counts only the new nodes
+ */
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "ChunkedQueue.h"
+#include "Queue.h"
+#include "QueueStats.h"
+#include "QueueTraits.h"
+#include "RingQueue.h"
+#include "SmallQueue.h"
+#include "TestHarness.h"
+
+namespace {
+
+//trivially copyable element, both halves have to survive a copy
+struct Pair {
+    int first; //id of the element
+    int second; //-first
+};
+
+Pair makePair(int id)
+{
+    return Pair{id, -id};
+}
+
+//counters shared by every rebound allocator of the tests
+struct AllocatorCalls {
+    static inline std::size_t allocations = 0; //calls of allocate
+    static inline std::size_t constructs = 0; //calls of construct
+};
+
+//allocator without construct or destroy, elements go through placement new like with std::allocator
+template<typename T>
+struct PlainAllocator : AllocatorCalls {
+    typedef T value_type;
+
+    PlainAllocator() = default;
+
+    template<typename U>
+    PlainAllocator(const PlainAllocator<U>&)
+    { }
+
+    T* allocate(std::size_t n)
+    {
+        allocations++;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    bool operator==(const PlainAllocator&) const
+    {
+        return true;
+    }
+
+    bool operator!=(const PlainAllocator&) const
+    {
+        return false;
+    }
+};
+
+//allocator with its own construct, elements can't be copied as raw memory
+template<typename T>
+struct ConstructingAllocator : PlainAllocator<T> {
+    ConstructingAllocator() = default;
+
+    template<typename U>
+    ConstructingAllocator(const ConstructingAllocator<U>&)
+    { }
+
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+        AllocatorCalls::constructs++;
+        ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+//counters shared by every rebound LimitedAllocator
+struct AllocationBudget {
+    static inline int budget = -1; //allocations left
+    static inline int outstanding = 0; //allocations not deallocated yet
+};
+
+//allocator failing with std::bad_alloc once AllocationBudget::budget allocations were made, -1 never fails
+template<typename T>
+struct LimitedAllocator : AllocationBudget {
+    typedef T value_type;
+
+    LimitedAllocator() = default;
+
+    template<typename U>
+    LimitedAllocator(const LimitedAllocator<U>&)
+    { }
+
+    T* allocate(std::size_t n)
+    {
+        if(budget == 0){
+            throw std::bad_alloc();
+        }
+        if(budget > 0){
+            budget--;
+        }
+        outstanding++;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        outstanding--;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    bool operator==(const LimitedAllocator&) const
+    {
+        return true;
+    }
+
+    bool operator!=(const LimitedAllocator&) const
+    {
+        return false;
+    }
+};
+
+static_assert(queue_detail::IsBitwiseCopyable<Pair, std::allocator<Pair>>::value, "std::allocator is plain");
+static_assert(queue_detail::IsBitwiseCopyable<Pair, PlainAllocator<Pair>>::value, "no construct, plain");
+static_assert(!queue_detail::IsBitwiseCopyable<Pair, ConstructingAllocator<Pair>>::value,
+              "an allocator's construct has to be called");
+
+//true if queue holds the elements of model, in the same order
+template<typename QueueType>
+bool sameElements(const QueueType& queue, const std::deque<int>& model)
+{
+    if(queue.size() != model.size()){
+        return false;
+    }
+    std::size_t index = 0;
+    for(const Pair& pair : queue){
+        if(pair.first != model[index] || pair.second != -model[index]){
+            return false;
+        }
+        index++;
+    }
+    return true;
+}
+
+//a queue whose head was moved to offset, holding the elements of model
+template<typename QueueType>
+QueueType shiftedQueue(std::size_t offset, const std::deque<int>& model)
+{
+    QueueType queue;
+    for(std::size_t i = 0; i < offset; i++){
+        queue.pushBack(makePair(-1));
+    }
+    for(std::size_t i = 0; i < offset; i++){
+        queue.popFront();
+    }
+    for(std::size_t i = 0; i < model.size(); i++){
+        queue.pushBack(makePair(model[i]));
+    }
+    return queue;
+}
+
+/**
+ * @brief Copies, assigns and bulk pushes from every head position and checks the elements
+ *
+ * @tparam QueueType - queue of Pair to check
+ */
+template<typename QueueType>
+void copyFromEveryOffset()
+{
+    std::vector<Pair> range;
+    for(int i = 0; i < 40; i++){
+        range.push_back(makePair(1000 + i));
+    }
+
+    for(std::size_t offset = 0; offset < 40; offset++){
+        for(std::size_t length : {1, 5, 13, 31}){
+            std::deque<int> model;
+            for(std::size_t i = 0; i < length; i++){
+                model.push_back(static_cast<int>(i));
+            }
+            QueueType queue = shiftedQueue<QueueType>(offset, model);
+            CHECK(sameElements(queue, model));
+
+            //pointer range pushes, wrapping around the end of the buffer or crossing chunks
+            queue.pushBack(range.data(), range.data() + length);
+            for(std::size_t i = 0; i < length; i++){
+                model.push_back(1000 + static_cast<int>(i));
+            }
+            CHECK(sameElements(queue, model));
+
+            QueueType copy(queue); //copy c'tor of a wrapped queue
+            CHECK(sameElements(copy, model));
+
+            QueueType big; //assignment into a buffer that is large enough
+            for(std::size_t i = 0; i < 2 * model.size() + offset; i++){
+                big.pushBack(makePair(-2));
+            }
+            while(big.size() > 1){
+                big.popFront();
+            }
+            big = queue;
+            CHECK(sameElements(big, model));
+
+            QueueType small; //assignment that has to grow
+            small.pushBack(makePair(-3));
+            small = queue;
+            CHECK(sameElements(small, model));
+
+            //the assigned queues keep working: their head and size are consistent
+            std::deque<int> grown = model;
+            for(int i = 0; i < 50; i++){
+                big.pushBack(makePair(2000 + i));
+                small.pushBack(makePair(2000 + i));
+                grown.push_back(2000 + i);
+            }
+            CHECK(sameElements(big, grown));
+            CHECK(sameElements(small, grown));
+            while(!grown.empty()){
+                CHECK(big.front().first == grown.front() && small.front().first == grown.front());
+                big.popFront();
+                small.popFront();
+                grown.pop_front();
+            }
+            CHECK(big.empty() && small.empty());
+            CHECK(sameElements(queue, model)); //the source is unchanged
+        }
+    }
+}
+
+/**
+ * @brief Checks the element by element path is taken with a constructing allocator
+ *
+ * @tparam QueueType - queue of Pair with ConstructingAllocator
+ * @tparam PlainType - the same queue with PlainAllocator
+ */
+template<typename QueueType, typename PlainType>
+void constructIsCalled()
+{
+    QueueType queue;
+    PlainType plain;
+    for(int i = 0; i < 20; i++){
+        queue.pushBack(makePair(i));
+        plain.pushBack(makePair(i));
+    }
+
+    std::size_t constructs = AllocatorCalls::constructs;
+    QueueType copy(queue);
+    CHECK(AllocatorCalls::constructs - constructs == 20);
+    QueueType target; //empty, a Queue assigns over the nodes it already has
+    constructs = AllocatorCalls::constructs;
+    target = queue;
+    CHECK(AllocatorCalls::constructs - constructs == 20);
+    Pair pairs[3] = {makePair(20), makePair(21), makePair(22)};
+    constructs = AllocatorCalls::constructs;
+    target.pushBack(pairs, pairs + 3);
+    CHECK(AllocatorCalls::constructs - constructs == 3);
+    CHECK(target.size() == 23 && copy.size() == 20);
+
+    constructs = AllocatorCalls::constructs;
+    PlainType plainCopy(plain);
+    plainCopy.pushBack(pairs, pairs + 3);
+    CHECK(AllocatorCalls::constructs == constructs); //nothing goes through a construct
+    CHECK(plainCopy.size() == 23);
+}
+
+} //namespace
+
+TEST(RingQueueCopiesFromEveryOffset)
+{
+    copyFromEveryOffset<RingQueue<Pair>>();
+    copyFromEveryOffset<RingQueue<Pair, PlainAllocator<Pair>>>();
+    copyFromEveryOffset<RingQueue<Pair, ConstructingAllocator<Pair>>>();
+}
+
+TEST(SmallQueueCopiesFromEveryOffset)
+{
+    copyFromEveryOffset<SmallQueue<Pair, 4>>();
+    copyFromEveryOffset<SmallQueue<Pair, 64>>(); //short queues stay inline
+    copyFromEveryOffset<SmallQueue<Pair, 4, PlainAllocator<Pair>>>();
+    copyFromEveryOffset<SmallQueue<Pair, 4, ConstructingAllocator<Pair>>>();
+}
+
+TEST(ChunkedQueueCopiesFromEveryOffset)
+{
+    copyFromEveryOffset<ChunkedQueue<Pair, 8>>();
+    copyFromEveryOffset<ChunkedQueue<Pair, 1>>();
+    copyFromEveryOffset<ChunkedQueue<Pair, 8, PlainAllocator<Pair>>>();
+    copyFromEveryOffset<ChunkedQueue<Pair, 8, ConstructingAllocator<Pair>>>();
+}
+
+TEST(QueueCopiesOverItsNodes)
+{
+    copyFromEveryOffset<Queue<Pair>>();
+    copyFromEveryOffset<Queue<Pair, ConstructingAllocator<Pair>>>();
+}
+
+TEST(ConstructingAllocatorTakesTheSlowPath)
+{
+    constructIsCalled<RingQueue<Pair, ConstructingAllocator<Pair>>, RingQueue<Pair, PlainAllocator<Pair>>>();
+    constructIsCalled<SmallQueue<Pair, 4, ConstructingAllocator<Pair>>, SmallQueue<Pair, 4, PlainAllocator<Pair>>>();
+    //ChunkedQueue isn't here: its allocator only makes chunks, the elements are always placement new'd
+    constructIsCalled<Queue<Pair, ConstructingAllocator<Pair>>, Queue<Pair, PlainAllocator<Pair>>>();
+}
+
+TEST(AssignmentReusesALargeEnoughBuffer)
+{
+    RingQueue<Pair, PlainAllocator<Pair>> ring;
+    SmallQueue<Pair, 4, PlainAllocator<Pair>> small;
+    RingQueue<Pair, PlainAllocator<Pair>> ringTarget;
+    SmallQueue<Pair, 4, PlainAllocator<Pair>> smallTarget;
+    for(int i = 0; i < 30; i++){
+        ring.pushBack(makePair(i));
+        small.pushBack(makePair(i));
+    }
+    for(int i = 0; i < 64; i++){
+        ringTarget.pushBack(makePair(-1));
+        smallTarget.pushBack(makePair(-1));
+    }
+
+    std::size_t allocations = AllocatorCalls::allocations;
+    ringTarget = ring;
+    smallTarget = small;
+    CHECK(AllocatorCalls::allocations == allocations);
+    CHECK(ringTarget.size() == 30 && ringTarget.front().first == 0);
+    CHECK(smallTarget.size() == 30 && smallTarget.front().first == 0);
+}
+
+TEST(QueueNodeReuseRollsBackAndCounts)
+{
+    typedef Queue<int, LimitedAllocator<int>, QueueStats> LimitedQueue;
+    {
+        LimitedQueue source;
+        LimitedQueue target;
+        for(int i = 0; i < 8; i++){
+            source.pushBack(i);
+        }
+        target.pushBack(-1);
+        target.pushBack(-2);
+
+        for(int budget = 0; budget < 6; budget++){ //target reuses its 2 nodes and needs 6 more
+            AllocationBudget::budget = budget;
+            int outstanding = AllocationBudget::outstanding;
+            CHECK_THROWS(target = source, std::bad_alloc);
+            AllocationBudget::budget = -1;
+            CHECK(AllocationBudget::outstanding == outstanding);
+            CHECK(target.size() == 2 && target.front() == -1);
+        }
+
+        QueueStatsSnapshot before = target.stats();
+        target = source;
+        QueueStatsSnapshot after = target.stats();
+        CHECK(target.size() == 8 && target.front() == 0);
+        CHECK(after.allocations - before.allocations == 6); //only the nodes target didn't have
+        CHECK(after.pushes - before.pushes == 8);
+        CHECK(after.highWater == 8);
+
+        LimitedQueue shorter;
+        shorter.pushBack(7);
+        target = shorter; //frees the surplus nodes
+        CHECK(target.size() == 1 && target.front() == 7);
+        target.pushBack(8);
+        CHECK(target.size() == 2);
+    }
+    CHECK(AllocationBudget::outstanding == 0);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
@@ -0,0 +1,92 @@
+/* IteratorTests:
+ *      the iterators of the linked list, ring and chunked backends, used by the standard algorithms
+ *      as forward iterators, and checked at the end of the queue unless QUEUE_UNCHECKED_ITERATORS is set
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "ChunkedQueue.h"
+#include "Queue.h"
+#include "RingQueue.h"
+#include "SmallQueue.h"
+#include "TestHarness.h"
+
+namespace {
+
+//walks queue of pairs with the standard algorithms and checks the end of iteration
+template<typename QueueType>
+void iterateForward()
+{
+    using Iterator = typename QueueType::Iterator;
+    using ConstIterator = typename QueueType::ConstIterator;
+    static_assert(std::is_same<typename std::iterator_traits<Iterator>::iterator_category,
+                               std::forward_iterator_tag>::value);
+    static_assert(std::is_same<typename std::iterator_traits<ConstIterator>::reference,
+                               const std::pair<int, std::string>&>::value);
+
+    QueueType queue;
+    for(int i = 0; i < 20; i++){ //more than a chunk, the ring wraps after the pops below
+        queue.pushBack(std::make_pair(i, std::to_string(i)));
+    }
+    for(int i = 0; i < 5; i++){
+        queue.popFront();
+        queue.pushBack(std::make_pair(20 + i, std::to_string(20 + i)));
+    }
+    CHECK(std::distance(queue.begin(), queue.end()) == 20);
+
+    Iterator found = std::find_if(queue.begin(), queue.end(),
+                                  [](const std::pair<int, std::string>& data){ return data.first == 12; });
+    CHECK(found != queue.end() && found->second == "12");
+    found->second = "twelve"; //writes through to the element
+    ConstIterator constFound = found;
+    CHECK(constFound == found && constFound->second == "twelve");
+    Iterator next = found;
+    CHECK(next++ == found && next != found && next->first == 13);
+
+    int expected = 5;
+    bool ordered = true;
+    for(ConstIterator it = static_cast<const QueueType&>(queue).begin(); it != queue.end(); ++it){
+        ordered = ordered && (*it).first == expected++;
+    }
+    CHECK(ordered && expected == 25);
+
+    Iterator singular;
+    CHECK(singular == Iterator());
+#if !QUEUE_UNCHECKED_ITERATORS
+    Iterator end = queue.end();
+    CHECK_THROWS(*end, typename Iterator::InvalidOperation);
+    CHECK_THROWS(++end, typename Iterator::InvalidOperation);
+    CHECK_THROWS(end++, typename Iterator::InvalidOperation);
+#endif
+}
+
+} //namespace
+
+TEST(QueueIteratorIsForward)
+{
+    iterateForward<Queue<std::pair<int, std::string>>>();
+}
+
+TEST(RingQueueIteratorIsForward)
+{
+    iterateForward<RingQueue<std::pair<int, std::string>>>();
+}
+
+TEST(ChunkedQueueIteratorIsForward)
+{
+    iterateForward<ChunkedQueue<std::pair<int, std::string>, 8>>();
+}
+
+TEST(SmallQueueIteratorIsForward)
+{
+    iterateForward<SmallQueue<std::pair<int, std::string>, 4>>();
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
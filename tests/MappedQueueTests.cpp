@@ -0,0 +1,125 @@
+/* MappedQueueTests:
+ *      the file backed MappedQueue across reopening, its on disk header and the files it must refuse
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <unistd.h>
+#include "MappedQueue.h"
+#include "ScratchFiles.h"
+#include "TestHarness.h"
+
+TEST(MappedQueueSurvivesReopening)
+{
+    std::string path = scratchPath("mapped.mq");
+    std::filesystem::remove(path);
+    {
+        MappedQueue<Record> queue(path, 6); //rounded up to 8
+        CHECK(queue.capacity() == 8);
+        for(std::uint64_t i = 0; i < 30; i++){ //wraps around several times
+            queue.pushBack(makeRecord(i));
+            if(i >= 5){
+                queue.popFront();
+            }
+        }
+        CHECK(queue.size() == 5);
+        CHECK(!std::filesystem::exists(path + ".tmp")); //created under the temporary name, then renamed
+    }
+    {
+        MappedQueue<Record> queue(path, 1024, 1); //an existing file keeps its capacity
+        CHECK(queue.capacity() == 8 && queue.size() == 5);
+        CHECK(queue.front() == makeRecord(25));
+        for(std::uint64_t i = 30; i < 33; i++){
+            CHECK(queue.tryPush(makeRecord(i)));
+        }
+        CHECK(queue.full() && !queue.tryPush(makeRecord(99)));
+        CHECK_THROWS(queue.pushBack(makeRecord(99)), MappedQueue<Record>::FullQueue);
+        queue.sync();
+    }
+    {
+        MappedQueue<Record> queue(path, 8);
+        for(std::uint64_t i = 25; i < 33; i++){
+            std::optional<Record> popped = queue.tryPop();
+            CHECK(popped && *popped == makeRecord(i));
+        }
+        CHECK(queue.empty() && !queue.tryPop());
+        CHECK_THROWS(queue.popFront(), MappedQueue<Record>::EmptyQueue);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(MappedQueueRecordsItsHeaderSize)
+{
+    std::string path = scratchPath("header.mq");
+    std::filesystem::remove(path);
+    {
+        MappedQueue<Record> queue(path, 16);
+        queue.pushBack(makeRecord(1));
+    }
+    std::ifstream in(path, std::ios::binary);
+    std::uint64_t fields[3] = {};
+    in.seekg(8);
+    in.read(reinterpret_cast<char*>(fields), sizeof(fields)); //elementSize, headerSize, capacity
+    CHECK(in.good());
+    std::uint64_t headerSize = fields[1];
+    CHECK(fields[0] == sizeof(Record) && fields[2] == 16);
+    CHECK(headerSize >= 4096 && (headerSize & (headerSize - 1)) == 0);
+    CHECK(headerSize % static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE)) == 0);
+    std::uintmax_t fileSize = std::filesystem::file_size(path); //the slots are padded to whole pages as well
+    CHECK(fileSize >= headerSize + 16 * sizeof(Record) && fileSize % headerSize == 0);
+
+    Record first;
+    in.seekg(static_cast<std::streamoff>(headerSize)); //the slots start right after the recorded size
+    in.read(reinterpret_cast<char*>(&first), sizeof(first));
+    CHECK(in.good() && first == makeRecord(1));
+    std::filesystem::remove(path);
+}
+
+TEST(MappedQueueRejectsBrokenFiles)
+{
+    std::string path = scratchPath("broken.mq");
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        std::string zeros(8192, '\0'); //what a crash before the header was written used to leave behind
+        out.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+    }
+    CHECK_THROWS(MappedQueue<Record>(path, 8), MappedQueue<Record>::FileError);
+
+    std::filesystem::remove(path);
+    {
+        MappedQueue<Record> queue(path, 8);
+    }
+    std::uint64_t fields[2] = {};
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(8);
+    file.read(reinterpret_cast<char*>(fields), sizeof(fields));
+    std::uint64_t headerSize = fields[1];
+
+    fields[1] = 100; //not a power of 2 of at least 4096
+    file.seekp(8);
+    file.write(reinterpret_cast<const char*>(fields), sizeof(fields));
+    file.flush();
+    CHECK_THROWS(MappedQueue<Record>(path, 8), MappedQueue<Record>::FileError);
+
+    fields[1] = headerSize * 2; //beyond the end of the file
+    file.seekp(8);
+    file.write(reinterpret_cast<const char*>(fields), sizeof(fields));
+    file.flush();
+    CHECK_THROWS(MappedQueue<Record>(path, 8), MappedQueue<Record>::FileError);
+
+    fields[0] = sizeof(Record) + 1; //another element type
+    fields[1] = headerSize;
+    file.seekp(8);
+    file.write(reinterpret_cast<const char*>(fields), sizeof(fields));
+    file.close();
+    CHECK_THROWS(MappedQueue<Record>(path, 8), MappedQueue<Record>::FileError);
+    std::filesystem::remove(path);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
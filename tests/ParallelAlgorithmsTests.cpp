@@ -0,0 +1,140 @@
+/* ParallelAlgorithmsTests:
+ *      parallelFilter and parallelTransform of every iterable backend, built with ThreadSanitizer when it is there
+ *      the results have to match the sequential filter and transform, segments stitched back in order,
+ *      and an exception thrown by any segment reaches the caller once every thread joined
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include "ChunkedQueue.h"
+#include "ParallelAlgorithms.h"
+#include "PoolAllocator.h"
+#include "Queue.h"
+#include "RingQueue.h"
+#include "TestHarness.h"
+
+namespace {
+
+//elements of the parallel runs, several segments of 1000 for 4 threads
+constexpr int COUNT = 20000;
+
+//true if both queues hold the same elements in the same order
+template<typename QueueType>
+bool sameQueue(const QueueType& left, const QueueType& right)
+{
+    if(left.size() != right.size()){
+        return false;
+    }
+    typename QueueType::ConstIterator it = right.begin();
+    for(int value : left){
+        if(value != *it){
+            return false;
+        }
+        ++it;
+    }
+    return true;
+}
+
+//runs the parallel algorithms on COUNT elements of QueueType and compares them with the sequential ones
+template<typename QueueType>
+void matchSequential()
+{
+    QueueType queue;
+    for(int i = 0; i < COUNT; i++){
+        queue.pushBack((i * 7919) % COUNT);
+    }
+    QueueType expected = filter(queue, [](int value){ return value % 3 != 0; });
+    QueueType filtered = parallelFilter(queue, [](int value){ return value % 3 != 0; }, 4, 1000);
+    CHECK(sameQueue(filtered, expected));
+
+    transform(expected, [](int& value){ value = 2 * value + 1; });
+    parallelTransform(filtered, [](int& value){ value = 2 * value + 1; }, 4, 1000);
+    CHECK(sameQueue(filtered, expected));
+
+    QueueType none = parallelFilter(queue, [](int){ return false; }, 4, 1000);
+    CHECK(none.empty());
+    QueueType all = parallelFilter(queue, [](int){ return true; }, 4, 1000);
+    CHECK(sameQueue(all, queue));
+}
+
+} //namespace
+
+TEST(ParallelAlgorithmsMatchSequentialOnQueue)
+{
+    matchSequential<Queue<int>>();
+}
+
+TEST(ParallelAlgorithmsMatchSequentialOnRingQueue)
+{
+    matchSequential<RingQueue<int>>();
+}
+
+TEST(ParallelAlgorithmsMatchSequentialOnChunkedQueue)
+{
+    matchSequential<ChunkedQueue<int, 64>>();
+}
+
+TEST(ParallelFilterWithPoolAllocator)
+{
+    PooledQueue<int> queue;
+    for(int i = 0; i < 40000; i++){
+        queue.pushBack(i);
+    }
+    PooledQueue<int> filtered = parallelFilter(queue, [](int value){ return value % 3 == 0; }, 4, 1000);
+    CHECK(filtered.size() == 13334);
+    int expected = 0;
+    bool ordered = true;
+    for(int value : filtered){
+        ordered = ordered && value == expected;
+        expected += 3;
+    }
+    CHECK(ordered);
+    filtered.pushBack(1); //the stitched parts allocate from a pool of their own, not from queue's
+    CHECK(filtered.size() == 13335 && !(filtered.getAllocator() == queue.getAllocator()));
+
+    parallelTransform(queue, [](int& value){ value = -value; }, 4, 1000);
+    CHECK(queue.front() == 0 && queue.size() == 40000);
+    queue.popFront();
+    CHECK(queue.front() == -1);
+}
+
+TEST(ParallelAlgorithmsRunSmallQueuesInTheCaller)
+{
+    Queue<int> queue;
+    for(int i = 0; i < 100; i++){
+        queue.pushBack(i);
+    }
+    std::size_t calls = 0; //not atomic, a second thread would be a data race
+    Queue<int> filtered = parallelFilter(queue, [&calls](int value){ calls++; return value < 10; }, 4);
+    CHECK(calls == 100 && filtered.size() == 10);
+    parallelTransform(queue, [&calls](int& value){ calls++; value++; }, 4);
+    CHECK(calls == 200 && queue.front() == 1);
+}
+
+TEST(ParallelAlgorithmsRethrowOnceEveryThreadJoined)
+{
+    Queue<int> queue;
+    for(int i = 0; i < COUNT; i++){
+        queue.pushBack(i);
+    }
+    std::atomic<int> calls(0);
+    CHECK_THROWS(parallelFilter(queue, [&calls](int value){
+        calls++;
+        if(value == COUNT - 1){ //in the last segment, taken by a worker thread
+            throw std::runtime_error("predict failed");
+        }
+        return true;
+    }, 4, 1000), std::runtime_error);
+    CHECK(calls.load() == COUNT); //the other segments ran to their end
+    CHECK_THROWS(parallelTransform(queue, [](int& value){
+        if(value == 0){ //in the first segment, taken by the caller
+            throw std::runtime_error("transformer failed");
+        }
+    }, 4, 1000), std::runtime_error);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
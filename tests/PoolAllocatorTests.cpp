@@ -0,0 +1,91 @@
+/* PoolAllocatorTests:
+ *      NodePool's freelist and slabs, PoolAllocator's sharing rules and PooledQueue against the std::deque model
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PoolAllocator.h"
+#include "Queue.h"
+#include "QueueModel.h"
+#include "TestElements.h"
+#include "TestHarness.h"
+
+TEST(NodePoolReusesFreedBlocks)
+{
+    NodePool pool(24, 8, 4);
+    CHECK(pool.freeCount() == 0);
+    std::vector<void*> blocks;
+    for(int i = 0; i < 6; i++){ //two slabs of 4
+        blocks.push_back(pool.allocate());
+        CHECK(reinterpret_cast<std::uintptr_t>(blocks.back()) % pool.blockAlign() == 0);
+    }
+    CHECK(pool.freeCount() == 2 && pool.blockSize() >= 24);
+
+    void* last = blocks.back();
+    pool.deallocate(last);
+    CHECK(pool.allocate() == last); //the freelist hands the block straight back
+
+    pool.reserve(10);
+    CHECK(pool.freeCount() >= 10);
+    for(void* block : blocks){
+        pool.deallocate(block);
+    }
+    std::size_t free = pool.freeCount();
+    pool.shrink(); //every slab is free, all of them go
+    CHECK(free >= 16 && pool.freeCount() == 0);
+    void* again = pool.allocate();
+    CHECK(again != nullptr && pool.freeCount() == 3);
+    pool.deallocate(again);
+}
+
+TEST(PoolAllocatorSharesItsResource)
+{
+    PoolAllocator<int> alloc;
+    PoolAllocator<int> copy(alloc);
+    PoolAllocator<std::string> rebound(alloc);
+    CHECK(copy == alloc && rebound == alloc);
+    CHECK(alloc.select_on_container_copy_construction() != alloc); //a copied container gets its own pool
+
+    int* block = alloc.allocate(1);
+    copy.deallocate(block, 1);
+    CHECK(alloc.allocate(1) == block); //freed through a copy, reused through the original
+    alloc.deallocate(block, 1);
+
+    int* array = alloc.allocate(16); //several objects bypass the pool
+    array[15] = 1;
+    alloc.deallocate(array, 16);
+}
+
+TEST(PooledQueueMatchesDeque)
+{
+    matchDeque<PooledQueue<int>, int>(PooledQueue<int>(), UNBOUNDED);
+    matchDeque<PooledQueue<std::string>, std::string>(PooledQueue<std::string>(), UNBOUNDED);
+}
+
+TEST(PooledQueueCopiesGetTheirOwnPool)
+{
+    PooledQueue<int> queue;
+    for(int i = 0; i < 10; i++){
+        queue.pushBack(i);
+    }
+    PooledQueue<int> copy(queue);
+    CHECK(copy.getAllocator() != queue.getAllocator());
+    PooledQueue<int> moved(std::move(copy));
+    CHECK(moved.getAllocator() != queue.getAllocator() && moved.size() == 10);
+    queue = std::move(moved); //the allocator propagates with the nodes
+    CHECK(queue.size() == 10 && moved.empty());
+    moved.pushBack(1);
+    CHECK(moved.front() == 1);
+}
+
+TEST(PooledQueueMoveLeavesSourceEmpty)
+{
+    moveLeavesSourceEmpty<PooledQueue<Thrower>>([](){ return PooledQueue<Thrower>(); });
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
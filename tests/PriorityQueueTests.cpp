@@ -0,0 +1,132 @@
+/* PriorityQueueTests:
+ *      the 4-ary heap PriorityQueue, against a std::multiset model and under throwing copies
+ *      filter and transform build a new heap, and the range overloads only take iterators
+ */
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "PriorityQueue.h"
+#include "QueueModel.h"
+#include "TestElements.h"
+#include "TestHarness.h"
+
+//two integers are not a range, the range c'tor must not take them
+static_assert(!std::is_constructible<PriorityQueue<int>, int, int>::value, "the range c'tor takes iterators only");
+static_assert(std::is_constructible<PriorityQueue<int>, int*, int*>::value, "pointers are iterators");
+
+TEST(PriorityQueueMatchesMultiset)
+{
+    PriorityQueue<int> queue;
+    PriorityQueue<int, std::greater<int>> minQueue;
+    std::multiset<int> model;
+    std::mt19937 random(11);
+    for(std::size_t step = 0; step < STEPS; step++){
+        bool growing = step / PHASE % 2 == 0;
+        if(random() % 10 < (growing ? 7u : 3u)){
+            int value = static_cast<int>(random() % 1000); //with duplicates
+            queue.pushBack(value);
+            minQueue.pushBack(value);
+            model.insert(value);
+        }
+        else if(model.empty()){
+            CHECK_THROWS(queue.popFront(), PriorityQueue<int>::EmptyQueue);
+            CHECK(!minQueue.tryPop().has_value() && minQueue.tryFront() == nullptr);
+        }
+        else{
+            CHECK(queue.front() == *model.rbegin());
+            CHECK(minQueue.front() == *model.begin());
+            if(random() % 2 == 0){ //popping the max from queue, the min from minQueue, rebuilding minQueue
+                queue.popFront();
+                model.erase(std::prev(model.end()));
+                minQueue = PriorityQueue<int, std::greater<int>>(model.begin(), model.end());
+            }
+            else{
+                std::optional<int> popped = minQueue.tryPop();
+                CHECK(popped.has_value() && *popped == *model.begin());
+                model.erase(model.begin());
+                queue = PriorityQueue<int>(model.begin(), model.end());
+            }
+        }
+        CHECK(queue.size() == model.size() && minQueue.size() == model.size());
+        CHECK(queue.empty() == model.empty());
+    }
+
+    queue.pushBack(model.begin(), model.end()); //every element twice
+    std::multiset<int> twice(model);
+    twice.insert(model.begin(), model.end());
+    std::multiset<int> iterated(queue.begin(), queue.end()); //heap order, every element once
+    CHECK(iterated == twice);
+    for(std::multiset<int>::reverse_iterator iter = twice.rbegin(); iter != twice.rend(); ++iter){
+        CHECK(!queue.empty() && queue.front() == *iter);
+        queue.popFront();
+    }
+    CHECK(queue.empty());
+}
+
+TEST(PriorityQueueAlgorithmsKeepTheHeap)
+{
+    PriorityQueue<int, std::greater<int>> queue;
+    for(int i = 0; i < 50; i++){
+        queue.pushBack((i * 37) % 50);
+    }
+    PriorityQueue<int, std::greater<int>> odd = filter(queue, [](int value){ return value % 2 == 1; });
+    transform(queue, [](int& value){ value = 100 - value; }); //reverses the priorities
+    CHECK(odd.size() == 25 && queue.size() == 50);
+    for(int expected = 1; expected < 50; expected += 2){
+        CHECK(odd.front() == expected);
+        odd.popFront();
+    }
+    for(int expected = 51; expected <= 100; expected++){
+        CHECK(queue.front() == expected);
+        queue.popFront();
+    }
+}
+
+TEST(PriorityQueueMoveLeavesSourceEmpty)
+{
+    std::vector<int> values = {5, 1, 9, 3};
+    PriorityQueue<int> source(values.begin(), values.end());
+    PriorityQueue<int> target;
+    target.emplace(42);
+    target = std::move(source);
+    CHECK(source.empty() && source.size() == 0 && !source.tryPop().has_value());
+    CHECK(target.size() == 4 && target.front() == 9);
+    PriorityQueue<int> moved(std::move(target));
+    CHECK(target.empty() && moved.front() == 9);
+    source.pushBack(7); //moved-from queues are usable again
+    CHECK(source.front() == 7 && source.size() == 1);
+}
+
+TEST(PriorityQueueSurvivesThrowingCopies)
+{
+    int baseline = Thrower::live;
+    {
+        PriorityQueue<Thrower> queue;
+        for(int i = 0; i < 10; i++){
+            queue.pushBack(Thrower(i));
+        }
+        for(int failAt = 0; failAt < 10; failAt++){
+            Thrower::countdown = failAt;
+            CHECK_THROWS([&](){ PriorityQueue<Thrower> copy(queue); }(), CopyFailed);
+            Thrower::countdown = 0;
+            CHECK_THROWS(queue.pushBack(queue.front()), CopyFailed);
+            Thrower::countdown = failAt;
+            CHECK_THROWS(transform(queue, [](Thrower& value){ value.value = -value.value; }), CopyFailed);
+            Thrower::countdown = -1;
+            CHECK(queue.size() == 10 && queue.front().value == 9);
+        }
+    }
+    CHECK(Thrower::live == baseline);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
@@ -0,0 +1,148 @@
+#ifndef QUEUE_MODEL_H
+#define QUEUE_MODEL_H
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "TestHarness.h"
+
+/* QueueModel:
+ *      FIFO order and size of a single threaded backend, checked against std::deque
+ *      a seeded random mix of pushes, pops, polls, bulk pops, copies and moves runs on the queue and on the model,
+ *      in phases that mostly grow and mostly shrink the queue, so buffers wrap, grow, spill and shrink
+ */
+//operations of a model run
+inline constexpr std::size_t STEPS = 20000;
+
+//operations of a phase, a phase mostly pushes or mostly pops
+inline constexpr std::size_t PHASE = 500;
+
+//size limit for the unbounded backends
+inline constexpr std::size_t UNBOUNDED = 100000;
+
+template<typename T>
+T makeValue(std::size_t i);
+
+template<>
+inline int makeValue<int>(std::size_t i)
+{
+    return static_cast<int>(i);
+}
+
+template<>
+inline std::string makeValue<std::string>(std::size_t i)
+{
+    return "element " + std::to_string(i) + " longer than the small string buffer";
+}
+
+//true_type when QueueType can pop several elements at once
+template<typename QueueType>
+auto hasBulkPop(int) -> decltype(std::declval<QueueType&>().popFront(std::size_t(1)), std::true_type());
+template<typename QueueType>
+std::false_type hasBulkPop(long);
+
+//true if queue holds the elements of model, in the same order
+template<typename QueueType, typename T>
+bool sameElements(const QueueType& queue, const std::deque<T>& model)
+{
+    if(queue.size() != model.size()){
+        return false;
+    }
+    typename std::deque<T>::const_iterator expected = model.begin();
+    for(const T& data : queue){
+        if(expected == model.end() || !(data == *expected)){
+            return false;
+        }
+        ++expected;
+    }
+    return expected == model.end();
+}
+
+/**
+ * @brief Runs the random operation mix on queue and on a std::deque and compares them after every step
+ *
+ * @tparam QueueType - queue to check, iterable and copyable
+ * @tparam T - element type of QueueType
+ * @param queue - empty queue to run on
+ * @param limit - maximal amount of elements queue can hold
+ */
+template<typename QueueType, typename T>
+void matchDeque(QueueType queue, std::size_t limit)
+{
+    std::deque<T> model;
+    std::mt19937 random(7);
+    std::size_t next = 0;
+    for(std::size_t step = 0; step < STEPS; step++){
+        bool growing = step / PHASE % 2 == 0;
+        unsigned op = random() % 10;
+        if(op < (growing ? 7u : 3u)){
+            if(model.size() < limit){
+                T value = makeValue<T>(next++);
+                queue.pushBack(value);
+                model.push_back(value);
+            }
+        }
+        else if(op < 8){
+            if(model.empty()){
+                CHECK_THROWS(queue.popFront(), typename QueueType::EmptyQueue);
+                CHECK(!queue.tryPop().has_value());
+            }
+            else if(op % 2 == 0){
+                queue.popFront();
+                model.pop_front();
+            }
+            else{
+                std::optional<T> popped = queue.tryPop();
+                CHECK(popped.has_value() && *popped == model.front());
+                model.pop_front();
+            }
+        }
+        else if(op == 8){
+            if constexpr(decltype(hasBulkPop<QueueType>(0))::value){
+                std::size_t count = random() % 8;
+                if(count > model.size()){ //nothing is popped
+                    CHECK_THROWS(queue.popFront(count), typename QueueType::EmptyQueue);
+                }
+                else{
+                    queue.popFront(count);
+                    model.erase(model.begin(), model.begin() + static_cast<std::ptrdiff_t>(count));
+                }
+            }
+        }
+        else if(step % 16 == 9){ //copies are O(n), only every few steps
+            QueueType copy(queue);
+            CHECK(sameElements(copy, model));
+            QueueType moved(std::move(copy));
+            CHECK(sameElements(moved, model));
+            copy = moved;
+            CHECK(sameElements(copy, model));
+            queue = std::move(copy);
+        }
+
+        CHECK(queue.size() == model.size());
+        CHECK(queue.empty() == model.empty());
+        if(!model.empty()){
+            CHECK(queue.front() == model.front());
+            CHECK(queue.tryFront() == &queue.front());
+        }
+        else{
+            CHECK(queue.tryFront() == nullptr);
+        }
+        if(step % 64 == 0){
+            CHECK(sameElements(queue, model));
+        }
+    }
+
+    while(!model.empty()){
+        CHECK(queue.front() == model.front());
+        queue.popFront();
+        model.pop_front();
+    }
+    CHECK(queue.empty() && queue.size() == 0);
+}
+
+#endif
@@ -0,0 +1,184 @@
+/* QueueSerializationTests:
+ *      snapshots of every backend, written to streams and buffers and read back in every way,
+ *      including from streams that can't seek or only seek part of the way,
+ *      and the truncated and lying snapshots deserialize must reject
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "ChunkedQueue.h"
+#include "Queue.h"
+#include "QueueSerialization.h"
+#include "RingQueue.h"
+#include "SmallQueue.h"
+#include "StaticQueue.h"
+#include "TestHarness.h"
+
+namespace {
+
+//stream buffer over a string that can't seek, like a pipe or a socket
+class UnseekableBuffer : public std::streambuf {
+public:
+    explicit UnseekableBuffer(std::string bytes) :
+        m_bytes(std::move(bytes))
+    {
+        this->setg(&m_bytes[0], &m_bytes[0], &m_bytes[0] + m_bytes.size());
+    }
+
+private:
+    std::string m_bytes; //everything the stream delivers
+};
+
+//stream buffer that tells its position but fails to seek to the end, like some device streams
+class EndlessBuffer : public std::stringbuf {
+public:
+    explicit EndlessBuffer(const std::string& bytes) :
+        std::stringbuf(bytes, std::ios::in)
+    { }
+
+protected:
+    pos_type seekoff(off_type offset, std::ios::seekdir dir, std::ios::openmode which) override
+    {
+        if(dir == std::ios::end){
+            return pos_type(off_type(-1));
+        }
+        return std::stringbuf::seekoff(offset, dir, which);
+    }
+};
+
+//the snapshot of queue, as a string
+template<typename QueueType>
+std::string snapshotOf(const QueueType& queue)
+{
+    std::ostringstream out;
+    serialize(queue, out);
+    return out.str();
+}
+
+//the elements of queue, front to back, by iterating
+template<typename QueueType>
+std::vector<int> elementsOf(const QueueType& queue)
+{
+    return std::vector<int>(queue.begin(), queue.end());
+}
+
+/**
+ * @brief Writes a queue whose elements wrap around into snapshots and reads them back in every way
+ *
+ * @tparam QueueType - queue of int to check
+ */
+template<typename QueueType>
+void roundTrip()
+{
+    QueueType queue;
+    for(int i = 0; i < 40; i++){
+        queue.pushBack(i);
+    }
+    for(int i = 0; i < 25; i++){
+        queue.popFront();
+    }
+    for(int i = 40; i < 60; i++){ //wraps the ring backends around
+        queue.pushBack(i);
+    }
+    std::vector<int> expected = elementsOf(queue);
+
+    std::string bytes = snapshotOf(queue);
+    CHECK(bytes.size() == serializedSize(queue));
+    std::vector<std::uint64_t> aligned(serializedSize(queue) / sizeof(std::uint64_t) + 1);
+    unsigned char* buffer = reinterpret_cast<unsigned char*>(aligned.data());
+    CHECK(serialize(queue, buffer + 1) == bytes.size()); //no alignment needed
+    CHECK(std::string(buffer + 1, buffer + 1 + bytes.size()) == bytes);
+
+    QueueType fromStream;
+    fromStream.pushBack(-1);
+    std::istringstream in(bytes + "trailing bytes");
+    CHECK(deserialize(fromStream, in) == expected.size());
+    CHECK(fromStream.front() == -1);
+    fromStream.popFront();
+    CHECK(elementsOf(fromStream) == expected);
+    std::string rest;
+    std::getline(in, rest);
+    CHECK(rest == "trailing bytes"); //the stream is left right after the snapshot
+
+    QueueType fromPipe;
+    UnseekableBuffer pipe(bytes);
+    std::istream pipeIn(&pipe);
+    CHECK(deserialize(fromPipe, pipeIn) == expected.size());
+    CHECK(elementsOf(fromPipe) == expected);
+
+    QueueType fromDevice; //the failed seek must not leave the stream failed
+    EndlessBuffer device(bytes);
+    std::istream deviceIn(&device);
+    CHECK(deserialize(fromDevice, deviceIn) == expected.size());
+    CHECK(deviceIn.good() && elementsOf(fromDevice) == expected);
+
+    QueueType fromUnaligned;
+    CHECK(deserialize(fromUnaligned, buffer + 1, bytes.size()) == bytes.size());
+    CHECK(elementsOf(fromUnaligned) == expected);
+
+    QueueType fromAligned;
+    CHECK(serialize(queue, buffer) == bytes.size());
+    CHECK(deserialize(fromAligned, buffer, bytes.size()) == bytes.size());
+    CHECK(elementsOf(fromAligned) == expected);
+}
+
+} //namespace
+
+TEST(SnapshotsRoundTripEveryBackend)
+{
+    roundTrip<Queue<int>>();
+    roundTrip<RingQueue<int>>();
+    roundTrip<ChunkedQueue<int, 8>>();
+    roundTrip<SmallQueue<int, 4>>();
+    roundTrip<StaticQueue<int, 128>>();
+}
+
+TEST(SnapshotsRejectTruncatedAndLyingCounts)
+{
+    RingQueue<int> source;
+    for(int i = 0; i < 10; i++){
+        source.pushBack(i);
+    }
+    std::string bytes = snapshotOf(source);
+    std::string truncated = bytes.substr(0, bytes.size() - 1);
+
+    std::string lying = bytes; //claims 2^40 elements, holds 10
+    std::uint64_t count = std::uint64_t(1) << 40;
+    lying.replace(16, sizeof(count), reinterpret_cast<const char*>(&count), sizeof(count));
+
+    std::string wrongSize = bytes;
+    wrongSize[8] = static_cast<char>(sizeof(long long));
+
+    for(const std::string* snapshot : {&truncated, &lying, &wrongSize}){
+        RingQueue<int> queue;
+        queue.pushBack(-1);
+
+        std::istringstream seekable(*snapshot);
+        CHECK_THROWS(deserialize(queue, seekable), InvalidSnapshot);
+        UnseekableBuffer pipe(*snapshot); //must not allocate for the count before the elements arrive
+        std::istream unseekable(&pipe);
+        CHECK_THROWS(deserialize(queue, unseekable), InvalidSnapshot);
+        EndlessBuffer device(*snapshot);
+        std::istream deviceIn(&device);
+        CHECK_THROWS(deserialize(queue, deviceIn), InvalidSnapshot);
+        CHECK_THROWS(deserialize(queue, snapshot->data(), snapshot->size()), InvalidSnapshot);
+
+        CHECK(queue.size() == 1 && queue.front() == -1); //nothing was appended
+    }
+
+    RingQueue<int> queue;
+    CHECK_THROWS(deserialize(queue, bytes.data(), sizeof(SnapshotHeader) - 1), InvalidSnapshot);
+    std::istringstream empty("");
+    CHECK_THROWS(deserialize(queue, empty), InvalidSnapshot);
+    CHECK(queue.empty());
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
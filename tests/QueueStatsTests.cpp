@@ -0,0 +1,58 @@
+/* QueueStatsTests:
+ *      the stats policies of Queue, counting pushes, pops, empty pops, allocations and the high-water mark
+ *      NoStats has to cost nothing, a Queue counting its operations still has to match the std::deque model
+ */
+
+#include <memory>
+#include <string>
+#include "Queue.h"
+#include "QueueModel.h"
+#include "QueueStats.h"
+#include "TestHarness.h"
+
+typedef Queue<int, std::allocator<int>, QueueStats> StatsQueue;
+
+static_assert(sizeof(Queue<int, std::allocator<int>, NoStats>) < sizeof(StatsQueue), "NoStats takes no space");
+
+TEST(QueueWithStatsMatchesDeque)
+{
+    matchDeque<StatsQueue, int>(StatsQueue(), UNBOUNDED);
+    typedef Queue<std::string, std::allocator<std::string>, QueueStats> StatsStringQueue;
+    matchDeque<StatsStringQueue, std::string>(StatsStringQueue(), UNBOUNDED);
+}
+
+TEST(QueueStatsCountOperations)
+{
+    StatsQueue queue;
+    for(int i = 0; i < 10; i++){
+        queue.pushBack(i);
+    }
+    queue.popFront(3);
+    queue.tryPop();
+    queue.clear();
+    queue.tryPop();
+    CHECK_THROWS(queue.popFront(), StatsQueue::EmptyQueue);
+    QueueStatsSnapshot stats = queue.stats();
+    CHECK(stats.pushes == 10);
+    CHECK(stats.pops == 4);
+    CHECK(stats.emptyPops == 2);
+    CHECK(stats.highWater == 10);
+    CHECK(stats.allocations == 10);
+}
+
+TEST(QueueStatsCountCopiesAsPushes)
+{
+    StatsQueue queue;
+    for(int i = 0; i < 4; i++){
+        queue.pushBack(i);
+    }
+    StatsQueue copy(queue);
+    QueueStatsSnapshot stats = copy.stats();
+    CHECK(stats.pushes == 4 && stats.allocations == 4 && stats.highWater == 4);
+    CHECK(stats.pops == 0 && stats.emptyPops == 0);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
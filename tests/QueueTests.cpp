@@ -0,0 +1,327 @@
+/* QueueTests:
+ *      the linked list Queue, against the std::deque model and under throwing copies
+ *      bulk pushes walk their range once unless the allocator reserves, appending relinks the nodes of an equal
+ *      allocator and moves the elements across unequal ones
+ *      reserve and shrinkToFit reach an allocator with pool hooks
+ */
+
+#include <cstddef>
+#include <forward_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "PoolAllocator.h"
+#include "Queue.h"
+#include "QueueModel.h"
+#include "TestElements.h"
+#include "TestHarness.h"
+
+namespace {
+
+//element counting how it was made, copies and moves show up separately
+struct Tracked {
+    static inline int copies = 0; //copy c'tor calls
+    static inline int moves = 0; //move c'tor calls
+
+    std::string text; //payload
+    int number; //second c'tor argument
+
+    Tracked(std::string val, int num) :
+        text(std::move(val)),
+        number(num)
+    { }
+
+    Tracked(const Tracked& other) :
+        text(other.text),
+        number(other.number)
+    {
+        copies++;
+    }
+
+    Tracked(Tracked&& other) noexcept :
+        text(std::move(other.text)),
+        number(other.number)
+    {
+        moves++;
+    }
+
+    static void reset()
+    {
+        copies = 0;
+        moves = 0;
+    }
+};
+
+//forward iterator over a std::forward_list counting its increments, so walks of the range show up
+struct CountingIterator {
+    typedef std::forward_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const int* pointer;
+    typedef const int& reference;
+
+    static inline int steps = 0; //increments of every CountingIterator
+
+    std::forward_list<int>::const_iterator it; //position in the list
+
+    const int& operator*() const
+    {
+        return *it;
+    }
+
+    CountingIterator& operator++()
+    {
+        ++it;
+        steps++;
+        return *this;
+    }
+
+    CountingIterator operator++(int)
+    {
+        CountingIterator old = *this;
+        ++(*this);
+        return old;
+    }
+
+    bool operator==(const CountingIterator& other) const
+    {
+        return it == other.it;
+    }
+
+    bool operator!=(const CountingIterator& other) const
+    {
+        return it != other.it;
+    }
+};
+
+//std::allocator with the pool hooks, recording how Queue forwards reserve and shrinkToFit
+template<typename T>
+struct ReservingAllocator : std::allocator<T> {
+    static inline std::size_t reserved = 0; //n of the last reserve call
+    static inline int shrinks = 0; //shrinkToFit calls
+
+    template<typename U>
+    struct rebind {
+        typedef ReservingAllocator<U> other;
+    };
+
+    ReservingAllocator() = default;
+
+    template<typename U>
+    ReservingAllocator(const ReservingAllocator<U>&) noexcept
+    { }
+
+    void reserve(std::size_t n)
+    {
+        ReservingAllocator<char>::reserved = n;
+    }
+
+    void shrinkToFit()
+    {
+        ReservingAllocator<char>::shrinks++;
+    }
+};
+
+} //namespace
+
+TEST(QueueMovesAndEmplacesElements)
+{
+    Queue<Tracked> queue;
+    Tracked value("pushed by copy, long enough to be on the heap", 1);
+    Tracked::reset();
+    queue.pushBack(value);
+    CHECK(Tracked::copies == 1 && Tracked::moves == 0);
+
+    Tracked::reset();
+    queue.pushBack(Tracked("pushed by move", 2));
+    CHECK(Tracked::copies == 0 && Tracked::moves == 1);
+
+    Tracked::reset();
+    Tracked& emplaced = queue.emplaceBack("emplaced in the node", 3);
+    CHECK(Tracked::copies == 0 && Tracked::moves == 0);
+    CHECK(emplaced.number == 3 && &emplaced == &*(++(++queue.begin())));
+
+    CHECK(queue.size() == 3 && value.text == "pushed by copy, long enough to be on the heap");
+    CHECK(queue.front().number == 1);
+    queue.popFront();
+    CHECK(queue.front().text == "pushed by move");
+}
+
+TEST(QueueHoldsMoveOnlyElements)
+{
+    Queue<std::unique_ptr<int>> queue;
+    std::unique_ptr<int> owned(new int(7));
+    queue.pushBack(std::move(owned));
+    queue.emplaceBack(new int(8));
+    CHECK(owned == nullptr && queue.size() == 2);
+    CHECK(*queue.front() == 7);
+    std::unique_ptr<int> taken = std::move(queue.front());
+    queue.popFront();
+    CHECK(*taken == 7 && *queue.front() == 8);
+}
+
+TEST(QueuePollsWithoutThrowing)
+{
+    Queue<std::unique_ptr<int>> queue;
+    const Queue<std::unique_ptr<int>>& view = queue;
+    CHECK(queue.tryFront() == nullptr && view.tryFront() == nullptr);
+    CHECK(!queue.tryPop().has_value());
+    queue.emplaceBack(new int(1));
+    queue.emplaceBack(new int(2));
+    CHECK(queue.tryFront() == &queue.front() && view.tryFront() == &view.front());
+    **queue.tryFront() = 3; //the pointer reaches the element in the queue
+    std::optional<std::unique_ptr<int>> popped = queue.tryPop(); //moved out of the queue
+    CHECK(popped.has_value() && **popped == 3);
+    CHECK(queue.size() == 1 && **queue.tryFront() == 2);
+    CHECK(queue.tryPop().has_value() && queue.empty());
+    CHECK(!queue.tryPop().has_value() && queue.tryFront() == nullptr);
+}
+
+TEST(QueueBulkPushWalksTheRangeOnce)
+{
+    std::forward_list<int> list;
+    for(int i = 9; i >= 0; i--){
+        list.push_front(i);
+    }
+    CountingIterator first{list.begin()};
+    CountingIterator last{list.end()};
+
+    Queue<int> queue;
+    CountingIterator::steps = 0;
+    queue.pushBack(first, last); //std::allocator has nothing to reserve, the range isn't counted
+    CHECK(CountingIterator::steps == 10 && queue.size() == 10);
+
+    PooledQueue<int> pooled;
+    CountingIterator::steps = 0;
+    pooled.pushBack(first, last); //counted once for PoolAllocator::reserve
+    CHECK(CountingIterator::steps == 20 && pooled.size() == 10);
+
+    std::istringstream input("10 11 12");
+    queue.pushBack(std::istream_iterator<int>(input), std::istream_iterator<int>()); //single pass only
+    int expected = 0;
+    bool ordered = true;
+    for(int value : queue){
+        ordered = ordered && value == expected++;
+    }
+    CHECK(ordered && expected == 13);
+}
+
+TEST(QueuePopsAndDrainsInBulk)
+{
+    Queue<std::unique_ptr<int>> queue;
+    for(int i = 0; i < 10; i++){
+        queue.emplaceBack(new int(i));
+    }
+    queue.popFront(3);
+    CHECK(queue.size() == 7 && *queue.front() == 3);
+    CHECK_THROWS(queue.popFront(8), Queue<std::unique_ptr<int>>::EmptyQueue);
+    CHECK(queue.size() == 7); //nothing is popped
+
+    std::vector<std::unique_ptr<int>> out;
+    CHECK(queue.drainTo(std::back_inserter(out), 4) == 4);
+    CHECK(out.size() == 4 && *out.front() == 3 && *out.back() == 6 && *queue.front() == 7);
+    CHECK(queue.drainTo(std::back_inserter(out), 100) == 3); //as many as there are
+    CHECK(queue.empty() && out.size() == 7 && *out.back() == 9);
+    CHECK(queue.drainTo(std::back_inserter(out), 1) == 0);
+}
+
+TEST(QueueAppendsByRelinking)
+{
+    Queue<int, CountingAllocator<int>> queue;
+    Queue<int, CountingAllocator<int>> other;
+    for(int i = 0; i < 5; i++){
+        queue.pushBack(i);
+        other.pushBack(5 + i);
+    }
+    const int* moved = &other.front();
+    std::size_t allocations = allocationCount;
+    queue.append(other);
+    CHECK(allocationCount == allocations && other.empty() && other.size() == 0);
+    CHECK(queue.size() == 10 && &*(++(++(++(++(++queue.begin()))))) == moved); //the nodes changed owner
+    queue.append(queue); //nothing to do
+    queue.splice(Queue<int, CountingAllocator<int>>());
+    CHECK(queue.size() == 10);
+
+    other.pushBack(10); //other is usable after giving its nodes away
+    queue.splice(std::move(other));
+    int expected = 0;
+    bool ordered = true;
+    for(int value : queue){
+        ordered = ordered && value == expected++;
+    }
+    CHECK(ordered && expected == 11 && other.empty());
+}
+
+TEST(QueueAppendsAcrossAllocatorsByMoving)
+{
+    Queue<std::unique_ptr<int>, CountingAllocator<std::unique_ptr<int>>> queue(CountingAllocator<int>(1));
+    Queue<std::unique_ptr<int>, CountingAllocator<std::unique_ptr<int>>> other(CountingAllocator<int>(2));
+    queue.emplaceBack(new int(1));
+    other.emplaceBack(new int(2));
+    other.emplaceBack(new int(3));
+    std::size_t allocations = allocationCount;
+    queue.append(other); //other's nodes can't be freed by queue's allocator, the elements are moved instead
+    CHECK(allocationCount == allocations + 2 && other.empty());
+    CHECK(queue.size() == 3 && *queue.front() == 1);
+    queue.popFront();
+    CHECK(*queue.front() == 2);
+}
+
+TEST(QueueClearsReservesAndShrinks)
+{
+    static_assert(std::is_same<decltype(Queue<int>().size()), std::size_t>::value, "sizes are size_t");
+    typedef ReservingAllocator<char> Hooks;
+    Queue<int, ReservingAllocator<int>> queue;
+    for(int i = 0; i < 3; i++){
+        queue.pushBack(i);
+    }
+    queue.reserve(10); //only the nodes still missing
+    CHECK(Hooks::reserved == 7);
+    Hooks::reserved = 0;
+    queue.reserve(2);
+    CHECK(Hooks::reserved == 0);
+    queue.shrinkToFit();
+    CHECK(Hooks::shrinks == 1);
+
+    queue.clear();
+    CHECK(queue.empty() && queue.size() == 0 && queue.begin() == queue.end());
+    CHECK_THROWS(queue.front(), Queue<int, ReservingAllocator<int>>::EmptyQueue);
+    queue.pushBack(5);
+    CHECK(queue.size() == 1 && queue.front() == 5);
+
+    PooledQueue<std::string> pooled; //the pool hooks themselves
+    pooled.reserve(64);
+    for(int i = 0; i < 64; i++){
+        pooled.pushBack(std::to_string(i));
+    }
+    pooled.clear();
+    pooled.shrinkToFit();
+    pooled.pushBack("again");
+    CHECK(pooled.size() == 1 && pooled.front() == "again");
+}
+
+TEST(QueueMatchesDeque)
+{
+    matchDeque<Queue<int>, int>(Queue<int>(), UNBOUNDED);
+    matchDeque<Queue<std::string>, std::string>(Queue<std::string>(), UNBOUNDED);
+}
+
+TEST(QueueMoveLeavesSourceEmpty)
+{
+    moveLeavesSourceEmpty<Queue<Thrower>>([](){ return Queue<Thrower>(); });
+}
+
+TEST(QueueSurvivesThrowingCopies)
+{
+    failEveryCopy<Queue<Thrower>>([](){ return Queue<Thrower>(); }, true);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
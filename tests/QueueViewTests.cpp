@@ -0,0 +1,76 @@
+/* QueueViewTests:
+ *      the lazy filtered and mapped views, chained over every backend and collected into queues
+ *      a chain must do no work before it is iterated and visit every element once per pass
+ */
+
+#include <string>
+#include <vector>
+#include "ChunkedQueue.h"
+#include "Queue.h"
+#include "QueueView.h"
+#include "RingQueue.h"
+#include "TestHarness.h"
+
+namespace {
+
+//chains a filter and two maps over 0..49 of QueueType and checks the values and the calls
+template<typename QueueType>
+void chainViews()
+{
+    QueueType queue;
+    for(int i = 0; i < 50; i++){
+        queue.pushBack(i);
+    }
+    int tested = 0;
+    int squared = 0;
+    auto view = queue | filtered([&tested](int value){ tested++; return value % 3 == 0; })
+                      | mapped([&squared](int value){ squared++; return value * value; })
+                      | mapped([](int value){ return std::to_string(value); });
+    CHECK(tested == 0 && squared == 0); //nothing runs before the view is iterated
+
+    std::vector<std::string> expected;
+    for(int i = 0; i < 50; i += 3){
+        expected.push_back(std::to_string(i * i));
+    }
+    std::vector<std::string> seen;
+    for(const std::string& text : view){
+        seen.push_back(text);
+    }
+    CHECK(seen == expected);
+    CHECK(tested == 50 && squared == static_cast<int>(expected.size())); //one pass, no intermediate queue
+
+    Queue<std::string> collected = collect<Queue<std::string>>(view);
+    CHECK(collected.size() == expected.size() && collected.front() == "0");
+    queue.pushBack(51); //the view refers to the queue, it sees the new element
+    CHECK(collect<Queue<std::string>>(view).size() == expected.size() + 1);
+}
+
+} //namespace
+
+TEST(ViewsChainOverQueue)
+{
+    chainViews<Queue<int>>();
+}
+
+TEST(ViewsChainOverRingQueue)
+{
+    chainViews<RingQueue<int>>();
+}
+
+TEST(ViewsChainOverChunkedQueue)
+{
+    chainViews<ChunkedQueue<int, 8>>();
+}
+
+TEST(ViewsOfAnEmptyQueueAreEmpty)
+{
+    Queue<int> queue;
+    auto view = queue | mapped([](int value){ return value + 1; }) | filtered([](int){ return true; });
+    CHECK(view.begin() == view.end());
+    CHECK(collect<RingQueue<int>>(view).empty());
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
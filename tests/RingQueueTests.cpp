@@ -0,0 +1,52 @@
+/* RingQueueTests:
+ *      the circular buffer RingQueue, against the std::deque model and under throwing copies
+ */
+
+#include <string>
+#include "QueueModel.h"
+#include "RingQueue.h"
+#include "TestElements.h"
+#include "TestHarness.h"
+
+TEST(RingQueueMatchesDeque)
+{
+    matchDeque<RingQueue<int>, int>(RingQueue<int>(), UNBOUNDED);
+    matchDeque<RingQueue<std::string>, std::string>(RingQueue<std::string>(), UNBOUNDED);
+}
+
+TEST(RingQueueReservesClearsAndShrinks)
+{
+    RingQueue<std::string> queue;
+    CHECK(queue.capacity() == 0); //nothing allocated before the first push
+    queue.reserve(40);
+    CHECK(queue.capacity() == 64);
+    for(int i = 0; i < 40; i++){
+        queue.pushBack(std::to_string(i));
+    }
+    CHECK(queue.capacity() == 64);
+    queue.clear();
+    CHECK(queue.empty() && queue.capacity() == 64); //the buffer is kept for the next pushes
+    for(int i = 0; i < 5; i++){
+        queue.pushBack(std::to_string(i));
+    }
+    queue.shrinkToFit();
+    CHECK(queue.capacity() == 8 && queue.size() == 5 && queue.front() == "0");
+    queue.clear();
+    queue.shrinkToFit();
+    CHECK(queue.capacity() == 0);
+}
+
+TEST(RingQueueMoveLeavesSourceEmpty)
+{
+    moveLeavesSourceEmpty<RingQueue<Thrower>>([](){ return RingQueue<Thrower>(); });
+}
+
+TEST(RingQueueSurvivesThrowingCopies)
+{
+    failEveryCopy<RingQueue<Thrower>>([](){ return RingQueue<Thrower>(); }, true);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
@@ -0,0 +1,52 @@
+#ifndef SCRATCH_FILES_H
+#define SCRATCH_FILES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
+/* ScratchFiles:
+ *      scratch files and records for the tests of the backends that put elements into files
+ *      scratch files go to the temporary directory, named after the process so parallel runs don't collide
+ */
+
+//path of a scratch file in the temporary directory, unique to this process
+inline std::string scratchPath(const std::string& name)
+{
+    std::string file = "queue-tests-" + std::to_string(getpid()) + "-" + name;
+    return (std::filesystem::temp_directory_path() / file).string();
+}
+
+//amount of files in the temporary directory whose path starts with prefix
+inline std::size_t filesStartingWith(const std::string& prefix)
+{
+    std::size_t count = 0;
+    for(const std::filesystem::directory_entry& entry :
+        std::filesystem::directory_iterator(std::filesystem::temp_directory_path())){
+        if(entry.path().string().compare(0, prefix.size(), prefix) == 0){
+            count++;
+        }
+    }
+    return count;
+}
+
+//element with some bytes to check, trivially copyable
+struct Record {
+    std::uint64_t id; //position in the order of pushes
+    std::uint32_t check; //derived from id
+    std::uint32_t padding; //keeps the size at 16
+};
+
+inline Record makeRecord(std::uint64_t id)
+{
+    return Record{id, static_cast<std::uint32_t>(id * 2654435761u), 0};
+}
+
+inline bool operator==(const Record& left, const Record& right)
+{
+    return left.id == right.id && left.check == right.check;
+}
+
+#endif
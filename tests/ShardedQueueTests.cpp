@@ -0,0 +1,68 @@
+/* ShardedQueueTests:
+ *      the relaxed ShardedQueue, built with ThreadSanitizer when the compiler has it
+ *      one thread sees its own pushes in order, several producers and consumers get every item exactly once,
+ *      also when every shard allocates from a pool of its own
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include "PoolAllocator.h"
+#include "ShardedQueue.h"
+#include "StressTest.h"
+#include "TestHarness.h"
+
+TEST(ShardedQueueKeepsOrderWithinAThread)
+{
+    ShardedQueue<std::unique_ptr<int>> queue(4);
+    CHECK(queue.shardCount() == 4);
+    CHECK(!queue.tryPop());
+    for(int i = 0; i < 10; i++){
+        queue.pushBack(std::make_unique<int>(i));
+    }
+    CHECK(queue.approximateSize() == 10);
+    bool ordered = true;
+    for(int i = 0; i < 10; i++){
+        std::optional<std::unique_ptr<int>> popped = queue.tryPop();
+        ordered = ordered && popped && **popped == i;
+    }
+    CHECK(ordered && !queue.tryPop() && queue.approximateSize() == 0);
+
+    ShardedQueue<int> automatic; //one shard per hardware thread
+    CHECK(automatic.shardCount() >= 1);
+}
+
+TEST(ShardedQueueDeliversEveryItemOnce)
+{
+    ShardedQueue<std::uint64_t> queue(4);
+    stress([&queue](std::size_t, std::uint64_t item){ queue.pushBack(item); },
+           [&queue](std::uint64_t& item){
+               std::optional<std::uint64_t> popped = queue.tryPop();
+               if(popped){
+                   item = *popped;
+               }
+               return popped.has_value();
+           }, false);
+    CHECK(queue.approximateSize() == 0);
+}
+
+TEST(ShardedQueueWithPoolAllocator)
+{
+    //shards are locked independently, every one of them has its own pool
+    ShardedQueue<std::uint64_t, PoolAllocator<std::uint64_t>> queue(4);
+    stress([&queue](std::size_t, std::uint64_t item){ queue.pushBack(item); },
+           [&queue](std::uint64_t& item){
+               std::optional<std::uint64_t> popped = queue.tryPop();
+               if(popped){
+                   item = *popped;
+               }
+               return popped.has_value();
+           }, false);
+    CHECK(queue.approximateSize() == 0);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
@@ -0,0 +1,106 @@
+/* SmallQueueTests:
+ *      the inline-first SmallQueue, against the std::deque model, across spills and under throwing copies and moves
+ */
+
+#include <stdexcept>
+#include <string>
+#include "QueueModel.h"
+#include "SmallQueue.h"
+#include "TestElements.h"
+#include "TestHarness.h"
+
+//element that can be copied but throws whenever it is moved
+struct ThrowingMove {
+    std::string text; //payload, long enough to live on the heap
+
+    explicit ThrowingMove(const std::string& val) :
+        text(val)
+    { }
+
+    ThrowingMove(const ThrowingMove&) = default;
+    ThrowingMove& operator=(const ThrowingMove&) = default;
+
+    ThrowingMove(ThrowingMove&&)
+    {
+        throw std::runtime_error("ThrowingMove moved");
+    }
+};
+
+TEST(SmallQueueMatchesDeque)
+{
+    matchDeque<SmallQueue<int, 4>, int>(SmallQueue<int, 4>(), UNBOUNDED);
+    matchDeque<SmallQueue<std::string, 4>, std::string>(SmallQueue<std::string, 4>(), UNBOUNDED);
+}
+
+TEST(SmallQueueStaysInlineUpToN)
+{
+    SmallQueue<int, 8> queue;
+    for(int i = 0; i < 8; i++){
+        queue.pushBack(i);
+    }
+    CHECK(queue.isInline());
+    queue.pushBack(8);
+    CHECK(!queue.isInline());
+    queue.popFront(5);
+    queue.shrinkToFit();
+    CHECK(queue.isInline() && queue.size() == 4 && queue.front() == 5);
+}
+
+TEST(SmallQueueReservesClearsAndShrinks)
+{
+    SmallQueue<std::string, 4> queue;
+    CHECK(queue.capacity() == 4);
+    queue.reserve(20);
+    CHECK(queue.capacity() == 32 && !queue.isInline());
+    for(int i = 0; i < 12; i++){
+        queue.pushBack(std::to_string(i));
+    }
+    queue.clear();
+    CHECK(queue.empty() && queue.capacity() == 32); //a heap buffer is kept for the next pushes
+    for(int i = 0; i < 6; i++){
+        queue.pushBack(std::to_string(i));
+    }
+    queue.shrinkToFit();
+    CHECK(queue.capacity() == 8 && queue.size() == 6 && queue.front() == "0");
+    queue.popFront(3);
+    queue.shrinkToFit();
+    CHECK(queue.isInline() && queue.capacity() == 4 && queue.front() == "3");
+}
+
+TEST(SmallQueueMoveLeavesSourceEmpty)
+{
+    moveLeavesSourceEmpty<SmallQueue<Thrower, 4>>([](){ return SmallQueue<Thrower, 4>(); });
+}
+
+TEST(SmallQueueSurvivesThrowingCopies)
+{
+    failEveryCopy<SmallQueue<Thrower, 4>>([](){ return SmallQueue<Thrower, 4>(); }, true);
+    failEveryCopy<SmallQueue<Thrower, 16>>([](){ return SmallQueue<Thrower, 16>(); }, true); //copies stay inline
+}
+
+TEST(SmallQueueAssignsWithThrowingMove)
+{
+    SmallQueue<ThrowingMove, 4> inlineSource;
+    SmallQueue<ThrowingMove, 4> spilledSource;
+    for(int i = 0; i < 8; i++){
+        ThrowingMove value("value " + std::to_string(i) + " of a queue whose elements can't be moved");
+        if(i < 3){
+            inlineSource.emplaceBack(value);
+        }
+        spilledSource.emplaceBack(value);
+    }
+
+    SmallQueue<ThrowingMove, 4> target;
+    target.emplaceBack("contents replaced by the assignments");
+    target = inlineSource; //the inline copy is spilled before target lets go of its elements
+    CHECK(target.size() == 3 && target.front().text == inlineSource.front().text);
+    target = spilledSource;
+    CHECK(target.size() == 8 && target.front().text == spilledSource.front().text);
+    target = inlineSource;
+    CHECK(target.size() == 3 && target.front().text == inlineSource.front().text);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
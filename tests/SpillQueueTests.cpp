@@ -0,0 +1,81 @@
+/* SpillQueueTests:
+ *      SpillQueue against std::deque with tiny segments, so nearly every segment is spilled and prefetched back,
+ *      and the segment files it has to remove
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <random>
+#include <string>
+#include "ScratchFiles.h"
+#include "SpillQueue.h"
+#include "TestHarness.h"
+
+TEST(SpillQueueMatchesDequeAndCleansUp)
+{
+    std::string prefix = scratchPath("spill-");
+    {
+        SpillQueue<Record> queue(prefix, 4, 1);
+        std::deque<Record> model;
+        std::mt19937 random(11);
+        std::uint64_t next = 0;
+        std::size_t mostSpilled = 0;
+
+        for(std::size_t step = 0; step < 20000; step++){
+            bool growing = (step / 1000) % 2 == 0;
+            if(random() % 4 != 0 ? growing : !growing){
+                Record record = makeRecord(next++);
+                queue.pushBack(record);
+                model.push_back(record);
+            }
+            else if(!model.empty()){
+                CHECK(queue.front() == model.front());
+                if(random() % 2 == 0){
+                    queue.popFront();
+                }
+                else{
+                    std::optional<Record> popped = queue.tryPop();
+                    CHECK(popped && *popped == model.front());
+                }
+                model.pop_front();
+            }
+            else{
+                CHECK(!queue.tryPop() && queue.tryFront() == nullptr);
+            }
+            CHECK(queue.size() == model.size());
+            if(queue.spilledSegments() > mostSpilled){
+                mostSpilled = queue.spilledSegments();
+            }
+        }
+        CHECK(mostSpilled > 100); //the model really went through the disk
+        CHECK(filesStartingWith(prefix) > 0);
+
+        while(!model.empty()){ //every spilled segment is read back in order
+            CHECK(queue.front() == model.front());
+            queue.popFront();
+            model.pop_front();
+        }
+        CHECK(queue.empty() && queue.spilledSegments() == 0);
+        CHECK(filesStartingWith(prefix) == 0); //files are removed once read back
+
+        for(std::uint64_t i = 0; i < 100; i++){
+            queue.pushBack(makeRecord(i));
+        }
+        CHECK(queue.spilledSegments() > 0);
+    }
+    CHECK(filesStartingWith(prefix) == 0); //and by the d'tor
+}
+
+TEST(SpillQueueRejectsPopOnEmpty)
+{
+    SpillQueue<int> queue(scratchPath("spill-empty-"), 4, 1);
+    CHECK_THROWS(queue.popFront(), SpillQueue<int>::EmptyQueue);
+    CHECK_THROWS(queue.front(), SpillQueue<int>::EmptyQueue);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
@@ -0,0 +1,64 @@
+/* SpscQueueTests:
+ *      the lock-free single producer single consumer SpscQueue, built with ThreadSanitizer when the compiler has it
+ *      one producer and one consumer share a small ring, so both sides keep wrapping around and waiting on the other
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include "SpscQueue.h"
+#include "TestHarness.h"
+
+TEST(SpscQueueRoundsUpItsCapacity)
+{
+    SpscQueue<int> queue(5);
+    CHECK(queue.capacity() == 8);
+    std::size_t pushed = 0;
+    while(queue.tryPush(static_cast<int>(pushed))){
+        pushed++;
+    }
+    CHECK(pushed == queue.capacity() && queue.size() == pushed);
+    int out;
+    for(std::size_t i = 0; i < pushed; i++){
+        CHECK(queue.tryPop(out) && out == static_cast<int>(i));
+    }
+    CHECK(!queue.tryPop(out));
+    CHECK(queue.empty());
+}
+
+TEST(SpscQueueHoldsMoveOnlyElements)
+{
+    SpscQueue<std::unique_ptr<int>> queue(4);
+    CHECK(queue.tryPush(std::make_unique<int>(1)));
+    CHECK(queue.tryEmplace(new int(2)));
+    std::unique_ptr<int> out;
+    CHECK(queue.tryPop(out) && *out == 1);
+    CHECK(queue.tryPop(out) && *out == 2);
+    CHECK(queue.tryEmplace(new int(3))); //left for the destructor
+}
+
+TEST(SpscQueueKeepsOrder)
+{
+    SpscQueue<std::uint64_t> queue(16);
+    constexpr std::size_t COUNT = 100000;
+    std::thread producer([&queue](){
+        for(std::size_t i = 0; i < COUNT; i++){
+            queue.push(i);
+        }
+    });
+    std::size_t wrong = 0;
+    for(std::size_t i = 0; i < COUNT; i++){
+        std::uint64_t item;
+        queue.pop(item);
+        wrong += item == i ? 0 : 1;
+    }
+    producer.join();
+    CHECK(wrong == 0);
+    CHECK(queue.empty());
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
@@ -0,0 +1,64 @@
+/* StaticQueueTests:
+ *      the constexpr fixed capacity StaticQueue, against the std::deque model and under throwing copies
+ *      its algorithms have to run at compile time, and a full queue rejects pushes
+ */
+
+#include <string>
+#include "QueueAlgorithms.h"
+#include "QueueModel.h"
+#include "StaticQueue.h"
+#include "TestElements.h"
+#include "TestHarness.h"
+
+namespace {
+
+//filled, filtered and transformed at compile time
+constexpr int staticAlgorithms()
+{
+    StaticQueue<int, 8> queue;
+    for(int i = 1; i <= 6; i++){
+        queue.pushBack(i);
+    }
+    StaticQueue<int, 8> odd = filter(queue, [](int value){ return value % 2 == 1; });
+    transform(odd, [](int& value){ value *= 10; });
+    transformInPlace(odd, [](int& value) noexcept { value++; });
+    int sum = 0;
+    for(int value : odd){
+        sum += value;
+    }
+    return sum; //11 + 31 + 51
+}
+
+static_assert(staticAlgorithms() == 93, "StaticQueue algorithms run at compile time");
+
+} //namespace
+
+TEST(StaticQueueMatchesDeque)
+{
+    matchDeque<StaticQueue<int, 64>, int>(StaticQueue<int, 64>(), 64);
+    matchDeque<StaticQueue<std::string, 48>, std::string>(StaticQueue<std::string, 48>(), 48);
+}
+
+TEST(StaticQueueRejectsPushesWhenFull)
+{
+    StaticQueue<int, 3> queue;
+    for(int i = 0; i < 3; i++){
+        CHECK(queue.tryPush(i));
+    }
+    CHECK(queue.full() && queue.capacity() == 3);
+    CHECK(!queue.tryPush(3) && !queue.tryEmplace(3));
+    CHECK_THROWS(queue.pushBack(3), StaticQueue<int, 3>::FullQueue);
+    CHECK(queue.size() == 3 && queue.front() == 0);
+    queue.popFront();
+    CHECK(!queue.full() && queue.tryPush(3));
+}
+
+TEST(StaticQueueSurvivesThrowingCopies)
+{
+    failEveryCopy<StaticQueue<Thrower, 32>>([](){ return StaticQueue<Thrower, 32>(); }, false);
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}
@@ -0,0 +1,127 @@
+#ifndef STRESS_TEST_H
+#define STRESS_TEST_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "TestHarness.h"
+
+/* StressTest:
+ *      producers and consumers hammering one queue, shared by the tests of the concurrent queues
+ *      producers push tagged items (producer in the high bits, sequence number in the low bits),
+ *      consumers pop them, and every item has to arrive exactly once
+ *      FIFO queues are also checked for per producer order: a consumer never sees a producer's items go backwards
+ *      the counts are kept small, the runs have to be quick under ThreadSanitizer on a single core
+ */
+//threads on each side of a stress run
+inline constexpr std::size_t PRODUCERS = 3;
+inline constexpr std::size_t CONSUMERS = 3;
+
+//items pushed by every producer
+inline constexpr std::size_t ITEMS = 20000;
+
+//low bits of an item holding its sequence number
+inline constexpr unsigned SEQUENCE_BITS = 32;
+
+//the item a producer pushes as its sequence-th
+inline std::uint64_t makeItem(std::size_t producer, std::size_t sequence)
+{
+    return (static_cast<std::uint64_t>(producer) << SEQUENCE_BITS) | sequence;
+}
+
+inline std::size_t producerOf(std::uint64_t item)
+{
+    return static_cast<std::size_t>(item >> SEQUENCE_BITS);
+}
+
+inline std::size_t sequenceOf(std::uint64_t item)
+{
+    return static_cast<std::size_t>(item & ((std::uint64_t(1) << SEQUENCE_BITS) - 1));
+}
+
+//what the consumers saw, checked once every thread joined
+struct Tally {
+    std::vector<std::atomic<unsigned>> seen; //times every item was popped
+    std::atomic<std::size_t> outOfOrder; //items popped before an earlier item of the same producer
+    std::atomic<std::size_t> popped; //items popped in total
+
+    explicit Tally(std::size_t producers) :
+        seen(producers * ITEMS),
+        outOfOrder(0),
+        popped(0)
+    {
+        for(std::atomic<unsigned>& count : seen){
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    //records an item, last holds the latest sequence number the calling consumer saw of every producer
+    void record(std::uint64_t item, std::vector<std::int64_t>& last)
+    {
+        std::size_t producer = producerOf(item);
+        std::int64_t sequence = static_cast<std::int64_t>(sequenceOf(item));
+        seen[producer * ITEMS + static_cast<std::size_t>(sequence)].fetch_add(1, std::memory_order_relaxed);
+        if(sequence <= last[producer]){
+            outOfOrder.fetch_add(1, std::memory_order_relaxed);
+        }
+        last[producer] = sequence;
+        popped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool exactlyOnce() const
+    {
+        for(const std::atomic<unsigned>& count : seen){
+            if(count.load(std::memory_order_relaxed) != 1){
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Runs PRODUCERS producers and CONSUMERS consumers over one queue and checks the tally
+ *
+ * @param push - push(producer, item), returns once the item is in the queue
+ * @param tryPop - tryPop(item), returns false if nothing was popped
+ * @param fifo - true if the queue keeps the order of every producer
+ */
+template<typename Push, typename TryPop>
+void stress(Push push, TryPop tryPop, bool fifo)
+{
+    Tally tally(PRODUCERS);
+    std::vector<std::thread> threads;
+    for(std::size_t producer = 0; producer < PRODUCERS; producer++){
+        threads.emplace_back([producer, &push](){
+            for(std::size_t sequence = 0; sequence < ITEMS; sequence++){
+                push(producer, makeItem(producer, sequence));
+            }
+        });
+    }
+    for(std::size_t consumer = 0; consumer < CONSUMERS; consumer++){
+        threads.emplace_back([&tally, &tryPop](){
+            std::vector<std::int64_t> last(PRODUCERS, -1);
+            std::uint64_t item;
+            while(tally.popped.load(std::memory_order_relaxed) < PRODUCERS * ITEMS){
+                if(tryPop(item)){
+                    tally.record(item, last);
+                }
+                else{
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for(std::thread& thread : threads){
+        thread.join();
+    }
+    CHECK(tally.popped.load() == PRODUCERS * ITEMS);
+    CHECK(tally.exactlyOnce());
+    if(fifo){
+        CHECK(tally.outOfOrder.load() == 0);
+    }
+}
+
+#endif
@@ -0,0 +1,279 @@
+#ifndef TEST_ELEMENTS_H
+#define TEST_ELEMENTS_H
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "TestHarness.h"
+
+/* TestElements:
+ *      an element whose copies throw on demand and counts its live instances, and the checks built on it
+ *      failEveryCopy makes every copy c'tor, copy assignment, bulk push, single push and transform of a backend
+ *      fail at every element: a failed operation must leave the queue as it was (strong guarantee)
+ *      and leak or double destroy nothing, which the live instance counter catches
+ *      moveLeavesSourceEmpty checks that a moved-from queue is empty and usable,
+ *      and that the elements the target held before are destroyed right away
+ *      CountingAllocator counts the allocations of a backend, so a path promised to allocate nothing can be checked
+ */
+//thrown by the copies of Thrower
+struct CopyFailed {};
+
+//element whose copies throw once countdown copies succeeded, -1 never throws
+struct Thrower {
+    static inline int live = 0; //instances alive
+    static inline int countdown = -1; //copies left before one throws
+
+    int value; //payload
+
+    Thrower() :
+        value(0)
+    {
+        live++;
+    }
+
+    explicit Thrower(int val) :
+        value(val)
+    {
+        live++;
+    }
+
+    Thrower(const Thrower& other) :
+        value(other.value)
+    {
+        countDown();
+        live++;
+    }
+
+    Thrower(Thrower&& other) noexcept :
+        value(other.value)
+    {
+        live++;
+    }
+
+    Thrower& operator=(const Thrower& other)
+    {
+        countDown();
+        value = other.value;
+        return *this;
+    }
+
+    Thrower& operator=(Thrower&& other) noexcept
+    {
+        value = other.value;
+        return *this;
+    }
+
+    ~Thrower()
+    {
+        live--;
+    }
+
+    bool operator==(const Thrower& other) const
+    {
+        return value == other.value;
+    }
+
+    bool operator<(const Thrower& other) const
+    {
+        return value < other.value;
+    }
+
+    static void countDown()
+    {
+        if(countdown == 0){
+            throw CopyFailed();
+        }
+        if(countdown > 0){
+            countdown--;
+        }
+    }
+};
+
+//allocations made by every CountingAllocator
+inline std::size_t allocationCount = 0;
+
+//allocator counting its allocations, copies are equal when they come from the same id, never propagated on moves
+template<typename T>
+struct CountingAllocator {
+    typedef T value_type;
+    typedef std::false_type propagate_on_container_move_assignment;
+
+    int id; //allocators with the same id can free each other's memory
+
+    CountingAllocator(int ident = 0) :
+        id(ident)
+    { }
+
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>& other) :
+        id(other.id)
+    { }
+
+    T* allocate(std::size_t n)
+    {
+        allocationCount++;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, std::size_t n)
+    {
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    template<typename U>
+    bool operator==(const CountingAllocator<U>& other) const
+    {
+        return id == other.id;
+    }
+
+    template<typename U>
+    bool operator!=(const CountingAllocator<U>& other) const
+    {
+        return id != other.id;
+    }
+};
+
+//true_type when QueueType has a bulk pushBack
+template<typename QueueType>
+auto hasBulkPush(int) -> decltype(std::declval<QueueType&>().pushBack(std::declval<Thrower*>(),
+                                                                       std::declval<Thrower*>()),
+                                  std::true_type());
+template<typename QueueType>
+std::false_type hasBulkPush(long);
+
+//the values of queue, front to back, by popping a copy
+template<typename QueueType>
+std::vector<int> valuesOf(const QueueType& queue)
+{
+    int saved = Thrower::countdown;
+    Thrower::countdown = -1;
+    QueueType copy(queue);
+    Thrower::countdown = saved;
+    std::vector<int> values;
+    while(!copy.empty()){
+        values.push_back(copy.front().value);
+        copy.popFront();
+    }
+    return values;
+}
+
+/**
+ * @brief Makes every copying operation of a backend fail at every element and checks nothing changed
+ *
+ * @tparam QueueType - queue of Thrower to check
+ * @param make - returns a new empty queue with room for 32 elements
+ * @param strongAssign - true if a failed copy assignment leaves the target unchanged
+ */
+template<typename QueueType, typename Make>
+void failEveryCopy(Make make, bool strongAssign)
+{
+    int baseline = Thrower::live;
+    {
+        QueueType source = make();
+        QueueType target = make();
+        std::vector<Thrower> values;
+        for(int i = 0; i < 10; i++){
+            source.pushBack(Thrower(i));
+            values.push_back(Thrower(100 + i));
+        }
+        for(int i = 0; i < 3; i++){
+            target.pushBack(Thrower(50 + i));
+        }
+        std::vector<int> sourceValues = valuesOf(source);
+        std::vector<int> targetValues = valuesOf(target);
+
+        for(int failAt = 0; failAt < 10; failAt++){
+            int live = Thrower::live;
+            Thrower::countdown = failAt;
+            CHECK_THROWS([&](){ QueueType copy(source); }(), CopyFailed);
+            CHECK(Thrower::live == live);
+
+            Thrower::countdown = failAt;
+            CHECK_THROWS(target = source, CopyFailed);
+            Thrower::countdown = -1;
+            if(strongAssign){
+                CHECK(valuesOf(target) == targetValues);
+            }
+            else{ //basic guarantee, target is only valid
+                target = make();
+                for(int value : targetValues){
+                    target.pushBack(Thrower(value));
+                }
+            }
+            CHECK(Thrower::live == live);
+
+            if constexpr(decltype(hasBulkPush<QueueType>(0))::value){
+                Thrower::countdown = failAt;
+                CHECK_THROWS(target.pushBack(values.data(), values.data() + values.size()), CopyFailed);
+                Thrower::countdown = -1;
+                CHECK(valuesOf(target) == targetValues);
+                CHECK(Thrower::live == live);
+            }
+
+            Thrower::countdown = 0;
+            CHECK_THROWS(target.pushBack(values[0]), CopyFailed);
+            Thrower::countdown = -1;
+            CHECK(valuesOf(target) == targetValues);
+
+            int calls = 0;
+            CHECK_THROWS(transform(target, [&calls, failAt](Thrower& value){
+                if(calls++ == failAt % 3){
+                    throw CopyFailed();
+                }
+                value.value = -1;
+            }), CopyFailed);
+            CHECK(valuesOf(target) == targetValues);
+            CHECK(Thrower::live == live);
+        }
+        Thrower::countdown = -1;
+        CHECK(valuesOf(source) == sourceValues);
+    }
+    CHECK(Thrower::live == baseline);
+}
+
+/**
+ * @brief Move constructs and move assigns a backend and checks both sources are left empty
+ *
+ * @tparam QueueType - queue of Thrower to check
+ * @param make - returns a new empty queue with room for 32 elements
+ */
+template<typename QueueType, typename Make>
+void moveLeavesSourceEmpty(Make make)
+{
+    int baseline = Thrower::live;
+    {
+        QueueType source = make();
+        QueueType target = make();
+        for(int i = 0; i < 5; i++){
+            source.pushBack(Thrower(i));
+        }
+        for(int i = 0; i < 3; i++){
+            target.pushBack(Thrower(50 + i));
+        }
+
+        target = std::move(source);
+        CHECK(Thrower::live == baseline + 5); //target's old elements are gone already
+        CHECK(source.empty() && source.size() == 0 && !source.tryPop());
+        CHECK(valuesOf(target) == std::vector<int>({0, 1, 2, 3, 4}));
+
+        QueueType moved(std::move(target));
+        CHECK(target.empty() && target.size() == 0);
+        CHECK(valuesOf(moved) == std::vector<int>({0, 1, 2, 3, 4}));
+
+        for(int i = 0; i < 3; i++){ //moved-from queues are usable again
+            source.pushBack(Thrower(10 + i));
+            target.pushBack(Thrower(20 + i));
+        }
+        CHECK(valuesOf(source) == std::vector<int>({10, 11, 12}));
+        CHECK(valuesOf(target) == std::vector<int>({20, 21, 22}));
+
+        QueueType& self = source;
+        source = std::move(self); //self move assignment keeps the elements
+        CHECK(source.size() == 3);
+    }
+    CHECK(Thrower::live == baseline);
+}
+
+#endif
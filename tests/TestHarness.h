@@ -0,0 +1,109 @@
+#ifndef TEST_HARNESS_H
+#define TEST_HARNESS_H
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <vector>
+
+/* TestHarness:
+ *      minimal runner for the tests in this directory, no test library needed
+ *      TEST(name) defines a test and registers it, CHECK(condition) records a failure and carries on,
+ *      CHECK_THROWS(expression, Exception) checks that expression throws Exception, which may contain commas
+ *      checks don't go through assert, so they run in every build type
+ *      every test executable runs all of its tests in order, or only the ones whose name contains argv[1],
+ *      and exits with 1 if any check failed or a test threw
+ */
+namespace test_detail {
+
+//a registered test
+struct TestCase {
+    const char* name; //name given to TEST
+    void (*body)(); //the test itself
+};
+
+inline std::vector<TestCase>& registry()
+{
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+inline std::size_t& failures()
+{
+    static std::size_t count = 0;
+    return count;
+}
+
+//registers a test at static initialization
+struct Registrar {
+    Registrar(const char* name, void (*body)())
+    {
+        registry().push_back(TestCase{name, body});
+    }
+};
+
+inline void fail(const char* file, int line, const char* what)
+{
+    failures()++;
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, what);
+}
+
+} //namespace test_detail
+
+#define TEST(name) \
+    static void name(); \
+    static test_detail::Registrar name##Registrar(#name, &name); \
+    static void name()
+
+#define CHECK(condition) \
+    do{ \
+        if(!(condition)){ \
+            test_detail::fail(__FILE__, __LINE__, #condition); \
+        } \
+    } while(false)
+
+#define CHECK_THROWS(expression, ...) \
+    do{ \
+        bool thrown = false; \
+        try{ \
+            (void)(expression); \
+        } catch(const __VA_ARGS__&){ \
+            thrown = true; \
+        } \
+        if(!thrown){ \
+            test_detail::fail(__FILE__, __LINE__, #expression " throws " #__VA_ARGS__); \
+        } \
+    } while(false)
+
+/**
+ * @brief Runs the registered tests, called by the main of every test executable
+ *
+ * @param argc - argument count of main
+ * @param argv - arguments of main, argv[1] optionally filters the tests by name
+ * @return - exit code, 0 if every check passed
+ */
+inline int runTests(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    std::size_t ran = 0;
+    for(const test_detail::TestCase& test : test_detail::registry()){
+        if(filter != nullptr && std::strstr(test.name, filter) == nullptr){
+            continue;
+        }
+        std::size_t before = test_detail::failures();
+        try{
+            test.body();
+        } catch(const std::exception& error){
+            test_detail::fail(test.name, 0, error.what());
+        } catch(...){
+            test_detail::fail(test.name, 0, "unexpected exception");
+        }
+        std::printf("%-48s %s\n", test.name, test_detail::failures() == before ? "ok" : "FAILED");
+        ran++;
+    }
+    std::printf("%zu tests, %zu failed checks\n", ran, test_detail::failures());
+    return test_detail::failures() == 0 ? 0 : 1;
+}
+
+#endif
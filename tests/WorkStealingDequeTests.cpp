@@ -0,0 +1,88 @@
+/* WorkStealingDequeTests:
+ *      the Chase-Lev WorkStealingDeque, built with ThreadSanitizer when the compiler has it
+ *      the owner pushes and pops at the bottom while thieves steal from the top, and every task is run once
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "TestHarness.h"
+#include "WorkStealingDeque.h"
+
+TEST(WorkStealingDequeOwnerIsLifoThievesAreFifo)
+{
+    WorkStealingDeque<int> deque(2);
+    for(int i = 0; i < 10; i++){ //grows past the initial capacity
+        deque.push(i);
+    }
+    CHECK(deque.approximateSize() == 10 && deque.capacity() >= 10);
+    int task;
+    CHECK(deque.pop(task) && task == 9);
+    CHECK(deque.steal(task) && task == 0);
+    CHECK(deque.steal(task) && task == 1);
+    CHECK(deque.pop(task) && task == 8);
+    for(int expected = 7; expected >= 2; expected--){
+        CHECK(deque.pop(task) && task == expected);
+    }
+    CHECK(!deque.pop(task) && !deque.steal(task) && deque.empty());
+}
+
+TEST(WorkStealingDequeHandsOutEveryTaskOnce)
+{
+    WorkStealingDeque<std::uint64_t> deque(8); //grows while thieves read the old array
+    constexpr std::size_t TASKS = 50000;
+    constexpr std::size_t THIEVES = 2;
+    std::vector<std::atomic<unsigned>> seen(TASKS);
+    for(std::atomic<unsigned>& count : seen){
+        count.store(0, std::memory_order_relaxed);
+    }
+    std::atomic<std::size_t> taken(0);
+    std::atomic<bool> done(false);
+
+    std::vector<std::thread> thieves;
+    for(std::size_t i = 0; i < THIEVES; i++){
+        thieves.emplace_back([&](){
+            std::uint64_t task;
+            while(!done.load(std::memory_order_acquire)){
+                if(deque.steal(task)){
+                    seen[task].fetch_add(1, std::memory_order_relaxed);
+                    taken.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    std::uint64_t task;
+    for(std::size_t i = 0; i < TASKS; i++){
+        deque.push(i);
+        if(i % 3 == 0 && deque.pop(task)){ //the owner works too, from the bottom
+            seen[task].fetch_add(1, std::memory_order_relaxed);
+            taken.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    while(deque.pop(task)){
+        seen[task].fetch_add(1, std::memory_order_relaxed);
+        taken.fetch_add(1, std::memory_order_relaxed);
+    }
+    while(taken.load(std::memory_order_relaxed) < TASKS){ //a thief may still hold the last one
+        std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    for(std::thread& thief : thieves){
+        thief.join();
+    }
+
+    bool exactlyOnce = true;
+    for(const std::atomic<unsigned>& count : seen){
+        exactlyOnce = exactlyOnce && count.load() == 1;
+    }
+    CHECK(exactlyOnce);
+    CHECK(taken.load() == TASKS);
+    CHECK(deque.empty());
+}
+
+int main(int argc, char** argv)
+{
+    return runTests(argc, argv);
+}